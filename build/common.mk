@@ -147,7 +147,8 @@ MRI_DIR  = $(BUILD_DIR)/../mri
 
 # Include path which points to external library headers and to subdirectories of this project which contain headers.
 SUBDIRS = $(wildcard $(SRC)/* $(SRC)/*/* $(SRC)/*/*/* $(SRC)/*/*/*/* $(SRC)/*/*/*/*/* $(SRC)/*/*/*/*/*/*)
-PROJINCS = $(sort $(dir $(SUBDIRS)))
+# the host simulator has its own mock mbed/LPC17xx headers which must never be seen by the firmware build
+PROJINCS = $(filter-out $(SRC)/testframework/host/%,$(sort $(dir $(SUBDIRS))))
 INCDIRS += $(SRC) $(PROJINCS) $(MRI_DIR) $(MBED_DIR) $(MBED_DIR)/$(DEVICE)
 
 # DEFINEs to be used when building C/C++ code
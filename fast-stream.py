@@ -13,6 +13,10 @@ import threading
 import time
 import signal
 import sys
+import collections
+import re
+import struct
+import binascii
 
 errorflg = False
 intrflg = False
@@ -31,6 +35,11 @@ parser = argparse.ArgumentParser(description='Stream g-code file to Smoothie ove
 parser.add_argument('gcode_file', type=argparse.FileType('r'), help='g-code filename to be streamed')
 parser.add_argument('device', help='Smoothie Serial Device')
 parser.add_argument('-q', '--quiet', action='store_true', default=False, help='suppress output text')
+parser.add_argument('-c', '--char-count', action='store_true', default=False,
+                    help='only send as many characters as the receive buffer has room for (needs report_buffer_space in config)')
+parser.add_argument('--buffer-size', type=int, default=0, help='receive buffer size to use with -c or -b, default is to ask Smoothie')
+parser.add_argument('-b', '--binary', action='store_true', default=False,
+                    help='send the G0/G1 as binary motion frames after an M800, see src/modules/communication/BinaryMotion.h')
 args = parser.parse_args()
 
 f = args.gcode_file
@@ -49,12 +58,201 @@ print("Streaming " + args.gcode_file.name + " to " + args.device)
 okcnt = 0
 
 
+class BinaryEncoder(object):
+    """G0/G1 lines as move records and anything else as text records, in frames of up to 250 bytes"""
+    AXES = 'XYZE'
+    DECIMALS = (3, 3, 3, 5)
+    MAX_PAYLOAD = 250
+
+    def __init__(self):
+        self.payload = bytearray()
+        self.frames = collections.deque()
+        self.seq = 0
+        self.modal_g = 1
+        self.last = [0, 0, 0, 0]
+
+    def move(self, line):
+        """the move record for a G0/G1 with XYZ values of no more than 3 decimals and E of no more than 5, or None"""
+        g = None
+        values = [None] * 4
+        feed = spindle = None
+        i = 0
+        while i < len(line):
+            if line[i] in ' \t':
+                i += 1
+                continue
+            letter = line[i]
+            i += 1
+            start = i
+            negative = line[i:i + 1] == '-'
+            if line[i:i + 1] in ('-', '+'):
+                i += 1
+            digits = ''
+            places = -1
+            while i < len(line) and (line[i].isdigit() or line[i] == '.'):
+                if line[i] == '.':
+                    if places >= 0:
+                        return None
+                    places = 0
+                else:
+                    digits += line[i]
+                    if places >= 0:
+                        places += 1
+                i += 1
+            if not digits or len(digits) > 13:
+                return None
+            places = max(places, 0)
+            n = int(digits)
+
+            if g is None:
+                # the first word is the G0/G1, or the line carries on from the last one
+                if letter == 'G':
+                    if negative or places > 0 or n > 1:
+                        return None
+                    g = n
+                    continue
+                if self.modal_g > 1:
+                    return None
+                g = self.modal_g
+
+            a = self.AXES.find(letter)
+            if a >= 0:
+                if values[a] is not None or places > self.DECIMALS[a]:
+                    return None
+                n *= 10 ** (self.DECIMALS[a] - places)
+                values[a] = -n if negative else n
+                if not -2**31 <= values[a] < 2**31:
+                    return None
+            elif letter == 'F' and feed is None:
+                feed = float(line[start:i])
+            elif letter == 'S' and spindle is None:
+                spindle = float(line[start:i])
+            else:
+                return None
+        if g is None:
+            return None
+
+        flags = 0x80 if g == 0 else 0
+        for a, v in enumerate(values):
+            if v is not None:
+                flags |= 1 << a
+                if not -32768 <= v - self.last[a] <= 32767:
+                    flags |= 0x40
+        if feed is not None:
+            flags |= 0x10
+        if spindle is not None:
+            flags |= 0x20
+
+        r = bytearray([0x01, flags])
+        for a, v in enumerate(values):
+            if v is None:
+                continue
+            if flags & 0x40:
+                r += struct.pack('<i', v)
+            else:
+                r += struct.pack('<h', v - self.last[a])
+            self.last[a] = v
+        if feed is not None:
+            r += struct.pack('<f', feed)
+        if spindle is not None:
+            r += struct.pack('<f', spindle)
+        self.modal_g = g
+        return r
+
+    def add_line(self, line):
+        """returns False if the line is too long to send"""
+        line = line.split(';', 1)[0].strip()
+        if not line:
+            return True
+        r = None if '(' in line else self.move(line)
+        if r is None:
+            if len(line) > self.MAX_PAYLOAD - 2:
+                return False
+            # the last G0-G3 on it is what a line without a G carries on from
+            for m in re.finditer(r'G(\d+)(?![\d.])', line):
+                if int(m.group(1)) <= 3:
+                    self.modal_g = int(m.group(1))
+            r = bytearray([0x02, len(line)]) + line.encode('latin1')
+        self.add_record(r)
+        return True
+
+    def end(self):
+        self.add_record(bytearray([0x03]))
+        self.flush()
+
+    def add_record(self, r):
+        if len(self.payload) + len(r) > self.MAX_PAYLOAD:
+            self.flush()
+        self.payload += r
+
+    def flush(self):
+        if not self.payload:
+            return
+        frame = bytearray([len(self.payload), self.seq]) + self.payload
+        crc = binascii.crc_hqx(bytes(frame), 0xFFFF)
+        self.frames.append(bytes(bytearray([0xA5]) + frame + struct.pack('<H', crc)))
+        self.seq = (self.seq + 1) & 0xFF
+        self.payload = bytearray()
+
+# lengths of the lines sent but not yet acknowledged, only used when counting characters
+inflight = collections.deque()
+inflight_cv = threading.Condition()
+rx_size = 0
+
+if args.char_count or args.binary:
+    rx_size = args.buffer_size
+    if rx_size == 0:
+        # ask for the free space in the receive buffer, it is empty right now
+        s.write(b'?')
+        while True:
+            rep = s.readline().decode('latin1')
+            if rep.startswith('<'):
+                break
+        m = re.search(r'Bf:\d+,(\d+)', rep)
+        if m is None:
+            print("Smoothie did not report its buffer space, set --buffer-size")
+            sys.exit(1)
+        rx_size = int(m.group(1))
+
+    # leave room for a USB packet as Smoothie stops taking them when there is less than 64 bytes free
+    rx_size -= 64
+    print("Counting characters into a {} byte buffer".format(rx_size))
+
+# the frames sent but not yet acknowledged, as (seq, frame), only used in binary
+unacked = collections.deque()
+resend_seq = None
+
+if args.binary:
+    s.write(b'M800\n')
+    while True:
+        rep = s.readline().decode('latin1')
+        if rep.startswith('ok binary'):
+            break
+        if "error" in rep:
+            print("Smoothie cannot take binary frames here: " + rep)
+            sys.exit(1)
+
+
 def read_thread():
     """thread worker function"""
-    global okcnt, errorflg
+    global okcnt, errorflg, resend_seq
     flag = 1
     while flag:
         rep = s.readline().decode('latin1')
+        if args.binary:
+            m = re.match(r'(ack|rs) (\d+)', rep)
+            if m is not None:
+                seq = int(m.group(2))
+                with inflight_cv:
+                    if m.group(1) == 'rs':
+                        resend_seq = seq
+                    elif any(q[0] == seq for q in unacked):
+                        # everything up to it has been handled
+                        while unacked.popleft()[0] != seq:
+                            pass
+                    inflight_cv.notify()
+                continue
+
         n = rep.count("ok")
         if n == 0:
             print("Incoming: " + rep)
@@ -63,6 +261,11 @@ def read_thread():
                 break
         else:
             okcnt += n
+            if args.char_count:
+                with inflight_cv:
+                    for i in range(min(n, len(inflight))):
+                        inflight.popleft()
+                    inflight_cv.notify()
 
     print("Read thread exited")
     return
@@ -73,16 +276,63 @@ t = threading.Thread(target=read_thread)
 t.daemon = True
 t.start()
 
+
+def send_frames(encoder, wait_for_all=False):
+    """send the frames that fit in the receive buffer, and the ones asked for again"""
+    global resend_seq
+    while not errorflg:
+        out = []
+        with inflight_cv:
+            if resend_seq is not None:
+                # send them all again from the one asked for
+                resend = False
+                for q in unacked:
+                    resend = resend or q[0] == resend_seq
+                    if resend:
+                        out.append(q[1])
+                resend_seq = None
+
+            while encoder.frames:
+                frame = encoder.frames[0]
+                if unacked and sum(len(q[1]) for q in unacked) + len(frame) > rx_size:
+                    break
+                encoder.frames.popleft()
+                unacked.append((bytearray(frame)[2], frame))
+                out.append(frame)
+
+            if not out:
+                if not encoder.frames and (not wait_for_all or not unacked):
+                    return
+                inflight_cv.wait(0.5)
+                continue
+
+        for frame in out:
+            s.write(frame)
+
+
 linecnt = 0
+encoder = BinaryEncoder()
 try:
     for line in f:
         if errorflg:
             break
+        if args.binary:
+            if not encoder.add_line(line):
+                print("Line is too long to send: " + line)
+                break
+            send_frames(encoder)
+            continue
         # strip comments
         if line.startswith(';'):
             continue
         l = line.strip()
         o = "{}\n".format(l).encode('latin1')
+        if args.char_count:
+            # wait until the line fits in what is left of the receive buffer
+            with inflight_cv:
+                while inflight and sum(inflight) + len(o) > rx_size and not errorflg:
+                    inflight_cv.wait(1)
+                inflight.append(len(o))
         n = s.write(o)
         if n != len(o):
             print("Not entire line was sent: {} - {}".format(n, len(o)))
@@ -94,6 +344,11 @@ except KeyboardInterrupt:
     print("Interrupted...")
     intrflg = True
 
+if args.binary and not intrflg and not errorflg:
+    # back to text once the last frame is handled
+    encoder.end()
+    send_frames(encoder, True)
+
 if intrflg:
     # We need to consume oks otherwise smoothie will deadlock on a full tx buffer
     print("Sending Abort - this may take a while...")
@@ -103,6 +358,9 @@ if intrflg:
     linecnt = 0
 
 if errorflg:
+    if args.binary:
+        # a halt takes Smoothie out of binary mode, this makes sure of it if it stopped at a bad frame
+        s.write(b'\x18')
     print("Target halted due to errors")
 
 else:
@@ -0,0 +1,93 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "InputShaper.h"
+
+#include <math.h>
+#include <string.h>
+
+#define PI 3.14159265358979323846F // force to be float, do not use M_PI
+
+/*
+ * The impulses for each shaper type, K is the decay of the oscillation over half a period and td the damped period
+ *   ZV  - two impulses, at 0 and td/2, cancels the frequency exactly
+ *   MZV - three impulses, at 0, 3/8 td and 3/4 td, less sensitive to the frequency being a little off
+ *   EI  - three impulses, at 0, td/2 and td, tolerates the most error in the frequency but has the longest delay
+ */
+InputShaper::InputShaper(TYPE type, float frequency, float damping, float tick_frequency)
+{
+    float df = sqrtf(1.0F - damping * damping);
+    float td = 1.0F / (frequency * df);
+    float a[3], t[3];
+
+    switch(type) {
+        case ZV: {
+            float k = expf(-damping * PI / df);
+            a[0] = 1.0F; a[1] = k;
+            t[0] = 0.0F; t[1] = 0.5F * td;
+            n_impulses = 2;
+        } break;
+
+        case MZV: {
+            float k = expf(-0.75F * damping * PI / df);
+            float a1 = 1.0F - 1.0F / sqrtf(2.0F);
+            a[0] = a1; a[1] = (sqrtf(2.0F) - 1.0F) * k; a[2] = a1 * k * k;
+            t[0] = 0.0F; t[1] = 0.375F * td; t[2] = 0.75F * td;
+            n_impulses = 3;
+        } break;
+
+        case EI: {
+            const float vibration_tolerance = 0.05F;
+            float k = expf(-damping * PI / df);
+            float a1 = 0.25F * (1.0F + vibration_tolerance);
+            a[0] = a1; a[1] = 0.5F * (1.0F - vibration_tolerance) * k; a[2] = a1 * k * k;
+            t[0] = 0.0F; t[1] = 0.5F * td; t[2] = td;
+            n_impulses = 3;
+        } break;
+    }
+
+    // normalize the amplitudes, the last one takes up any rounding so they add up to exactly ONE
+    float sum = 0;
+    for (int i = 0; i < n_impulses; ++i) sum += a[i];
+    int32_t total = 0;
+    for (int i = 0; i < n_impulses; ++i) {
+        amplitude[i] = (i == n_impulses - 1) ? ONE - total : (int32_t)roundf(a[i] / sum * ONE);
+        total += amplitude[i];
+        delay[i] = roundf(t[i] * tick_frequency);
+    }
+
+    history = delay[n_impulses - 1] + 1;
+    step_bits = new uint32_t[(history + 31) / 32];
+    dir_bits = new uint32_t[(history + 31) / 32];
+    head = 0;
+    direction = false;
+    flush();
+}
+
+InputShaper::~InputShaper()
+{
+    delete [] step_bits;
+    delete [] dir_bits;
+}
+
+InputShaper *InputShaper::create(const char *type, float frequency, float damping, float tick_frequency)
+{
+    if(frequency <= 0.0F || damping < 0.0F || damping >= 1.0F) return nullptr;
+
+    if(strcmp(type, "zv") == 0) return new InputShaper(ZV, frequency, damping, tick_frequency);
+    if(strcmp(type, "mzv") == 0) return new InputShaper(MZV, frequency, damping, tick_frequency);
+    if(strcmp(type, "ei") == 0) return new InputShaper(EI, frequency, damping, tick_frequency);
+    return nullptr;
+}
+
+void InputShaper::flush()
+{
+    memset(step_bits, 0, ((history + 31) / 32) * sizeof(uint32_t));
+    memset(dir_bits, 0, ((history + 31) / 32) * sizeof(uint32_t));
+    idle_ticks = history + 1;
+    accumulator = 0;
+}
@@ -0,0 +1,94 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <array>
+
+/*
+ * Input shaper for one motor, run from the step ticker ISR once per tick.
+ *
+ * The steps the planner generates are convolved with a set of impulses, each step is split into fractions
+ * that are issued at the delays of the impulses, so the motion that excites a resonance at the shaper frequency
+ * is cancelled by the motion half a period later. The total number of steps is unchanged, they are just spread out.
+ * The last max delay ticks of steps are kept in a bit history, one bit for the step and one for the direction.
+ */
+class InputShaper {
+    public:
+        enum TYPE { ZV, MZV, EI };
+
+        InputShaper(TYPE type, float frequency, float damping, float tick_frequency);
+        ~InputShaper();
+
+        // returns nullptr if the type is not known
+        static InputShaper *create(const char *type, float frequency, float damping, float tick_frequency);
+
+        // called every tick with the step the planner generated for this tick, 1, -1 or 0
+        // returns true if the motor should step this tick, in get_direction()
+        inline bool tick(int8_t step)
+        {
+            if(step != 0) {
+                uint32_t w= head >> 5, b= 1 << (head & 31);
+                step_bits[w] |= b;
+                if(step < 0) dir_bits[w] |= b;
+                else dir_bits[w] &= ~b;
+                idle_ticks= 0;
+            } else {
+                step_bits[head >> 5] &= ~(1 << (head & 31));
+                if(idle_ticks <= history) ++idle_ticks;
+            }
+
+            if(idle_ticks <= history) {
+                for (uint8_t i = 0; i < n_impulses; ++i) {
+                    uint32_t j= (head >= delay[i]) ? head - delay[i] : head + history - delay[i];
+                    if(step_bits[j >> 5] & (1 << (j & 31))) {
+                        if(dir_bits[j >> 5] & (1 << (j & 31))) accumulator -= amplitude[i];
+                        else accumulator += amplitude[i];
+                    }
+                }
+            }
+            if(++head >= history) head= 0;
+
+            if(accumulator >= ONE || accumulator <= -ONE) {
+                bool dir= accumulator < 0;
+                if(dir != direction) {
+                    // hold the step back a tick so the direction pin has time to settle
+                    direction= dir;
+                    return false;
+                }
+                accumulator += dir ? ONE : -ONE;
+                return true;
+            }
+            return false;
+        }
+
+        // true is negative, same as StepperMotor::which_direction()
+        bool get_direction() const { return direction; }
+        // true while there are steps that have not been issued
+        bool is_busy() const { return idle_ticks <= history || accumulator != 0; }
+        // discard the steps that have not been issued yet
+        void flush();
+
+        uint8_t get_impulses() const { return n_impulses; }
+        uint32_t get_delay(int i) const { return delay[i]; }
+        float get_amplitude(int i) const { return (float)amplitude[i] / ONE; }
+
+    private:
+        static const int32_t ONE= 1 << 28; // amplitudes are fixed point, the sum of them is ONE
+
+        std::array<int32_t, 3> amplitude;
+        std::array<uint32_t, 3> delay; // in ticks
+        uint32_t *step_bits;
+        uint32_t *dir_bits;
+        uint32_t history; // ticks kept in the bit history, the longest delay + 1
+        uint32_t head;
+        uint32_t idle_ticks;
+        int32_t accumulator;
+        uint8_t n_impulses;
+        bool direction;
+};
@@ -44,10 +44,13 @@
 
 #define base_stepping_frequency_checksum            CHECKSUM("base_stepping_frequency")
 #define microseconds_per_step_pulse_checksum        CHECKSUM("microseconds_per_step_pulse")
+#define event_driven_stepping_checksum              CHECKSUM("event_driven_stepping")
+#define max_step_pulses_per_tick_checksum           CHECKSUM("max_step_pulses_per_tick")
 #define disable_leds_checksum                       CHECKSUM("leds_disable")
 #define grbl_mode_checksum                          CHECKSUM("grbl_mode")
 #define feed_hold_enable_checksum                   CHECKSUM("enable_feed_hold")
 #define ok_per_line_checksum                        CHECKSUM("ok_per_line")
+#define report_buffer_space_checksum                CHECKSUM("report_buffer_space")
 
 Kernel* Kernel::instance;
 
@@ -120,6 +123,9 @@ Kernel::Kernel()
     // we expect ok per line now not per G code, setting this to false will return to the old (incorrect) way of ok per G code
     this->ok_per_line = this->config->value( ok_per_line_checksum )->by_default(true)->as_bool();
 
+    // add the free blocks and receive buffer space to the ok, so a host can stream ahead by counting the characters it sends
+    this->report_buffer_space = this->config->value( report_buffer_space_checksum )->by_default(false)->as_bool();
+
     this->add_module( this->serial );
 
     // HAL stuff
@@ -157,10 +163,14 @@ Kernel::Kernel()
     // Configure the step ticker
     this->base_stepping_frequency = this->config->value(base_stepping_frequency_checksum)->by_default(100000)->as_number();
     float microseconds_per_step_pulse = this->config->value(microseconds_per_step_pulse_checksum)->by_default(1)->as_number();
+    // only interrupt when a step is due instead of at the base stepping frequency
+    this->step_ticker->set_event_driven(this->config->value(event_driven_stepping_checksum)->by_default(false)->as_bool());
 
     // Configure the step ticker
     this->step_ticker->set_frequency( this->base_stepping_frequency );
     this->step_ticker->set_unstep_time( microseconds_per_step_pulse );
+    // give fast motors up to 2 or 4 step pulses in a tick
+    this->step_ticker->set_multi_step(this->config->value(max_step_pulses_per_tick_checksum)->by_default(1)->as_number());
 
     // Core modules
     this->add_module( this->conveyor       = new Conveyor()      );
@@ -172,8 +182,17 @@ Kernel::Kernel()
     this->configurator = new Configurator();
 }
 
+// the grbl realtime feed override commands, 0x90 resets it to 100%, 0x91 and 0x92 are +/-10%, 0x93 and 0x94 are +/-1%
+void Kernel::feed_override_command(uint8_t c)
+{
+    static const float change[]= {10.0F, -10.0F, 1.0F, -1.0F};
+    if(c < 0x90 || c > 0x94) return;
+    robot->set_speed_override((c == 0x90) ? 100.0F : robot->get_speed_override() + change[c - 0x91]);
+}
+
 // return a GRBL-like query string for serial ?
-std::string Kernel::get_query_string()
+// the stream is the one asking, the room in its receive buffer is reported
+std::string Kernel::get_query_string(StreamOutput *stream)
 {
     std::string str;
     bool homing;
@@ -284,6 +303,15 @@ std::string Kernel::get_query_string()
         str.append(buf, n);
     }
 
+    // free blocks in the queue, and characters in the receive buffer of the stream asking, like grbl
+    {
+        char buf[32];
+        int rx= (stream != nullptr) ? stream->get_rx_free() : -1;
+        size_t n= (rx >= 0) ? snprintf(buf, sizeof(buf), "|Bf:%u,%d", conveyor->get_free_blocks(), rx) : snprintf(buf, sizeof(buf), "|Bf:%u", conveyor->get_free_blocks());
+        if(n > sizeof(buf)) n= sizeof(buf);
+        str.append(buf, n);
+    }
+
     // if not grbl mode get temperatures
     if(!is_grbl_mode()) {
         struct pad_temperature temp;
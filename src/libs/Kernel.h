@@ -24,6 +24,7 @@ class Conveyor;
 class SlowTicker;
 class SerialConsole;
 class StreamOutputPool;
+class StreamOutput;
 class GcodeDispatch;
 class Robot;
 class Planner;
@@ -50,6 +51,7 @@ class Kernel {
         bool is_halted() const { return halted; }
         bool is_grbl_mode() const { return grbl_mode; }
         bool is_ok_per_line() const { return ok_per_line; }
+        bool is_report_buffer_space() const { return report_buffer_space; }
 
         void set_feed_hold(bool f) { feed_hold= f; }
         bool get_feed_hold() const { return feed_hold; }
@@ -61,7 +63,8 @@ class Kernel {
         bool get_stop_request() const { return stop_request; }
         void set_stop_request(bool f) { stop_request= f; }
 
-        std::string get_query_string();
+        std::string get_query_string(StreamOutput *stream= nullptr);
+        void feed_override_command(uint8_t c);
 
         // These modules are available to all other modules
         SerialConsole*    serial;
@@ -92,6 +95,7 @@ class Kernel {
             bool enable_feed_hold:1;
             bool bad_mcu:1;
             bool stop_request:1;
+            bool report_buffer_space:1;
         };
 
 };
@@ -15,10 +15,13 @@
 #include "StreamOutputPool.h"
 #include "Block.h"
 #include "Conveyor.h"
+#include "InputShaper.h"
 
 #include "system_LPC17xx.h" // mbed.h lib
 #include <math.h>
+#include <string.h>
 #include <mri.h>
+#include <algorithm>
 
 #ifdef STEPTICKER_DEBUG_PIN
 // debug pins, only used if defined in src/makefile
@@ -34,6 +37,7 @@ StepTicker *StepTicker::instance;
 StepTicker::StepTicker()
 {
     instance = this; // setup the Singleton instance of the stepticker
+    this->event_driven = false;
 
     // Configure the timer
     LPC_TIM0->MR0 = 10000000;       // Initial dummy value for Match Register
@@ -49,11 +53,32 @@ StepTicker::StepTicker()
     this->set_frequency(100000);
     this->set_unstep_time(100);
 
-    this->unstep.reset();
+    this->step_bits.fill(0);
+    this->unstep_bits.fill(0);
+    this->step_slots= 0;
+    this->unstep_slots= 0;
+    for(auto& b : this->train_bits) b.fill(0);
+    this->train_slots.fill(0);
+    this->train_pulse= 0;
+    this->train_queued= false;
+    this->train_running= false;
+    this->train_step_due= false;
+    this->set_multi_step(1);
     this->num_motors = 0;
+    this->ticking_mask = 0;
+
+    this->shaper.fill(nullptr);
+    this->shaped_step.fill(0);
+    this->n_shaped = 0;
+    this->shapers_busy = false;
 
     this->running = false;
     this->current_block = nullptr;
+    this->replan_block = nullptr;
+    this->replan_from = nullptr;
+    this->park_block = nullptr;
+    this->path.active = false;
+    this->replan_state = REPLAN_NONE;
 
     #ifdef STEPTICKER_DEBUG_PIN
     // setup debug pin if defined
@@ -69,16 +94,20 @@ StepTicker::~StepTicker()
 //called when everything is setup and interrupts can start
 void StepTicker::start()
 {
+    current_tick= 0;
+    if(event_driven) schedule_event(LPC_TIM0->TC);
     NVIC_EnableIRQ(TIMER0_IRQn);     // Enable interrupt handler
     NVIC_EnableIRQ(TIMER1_IRQn);     // Enable interrupt handler
-    current_tick= 0;
 }
 
 // Set the base stepping frequency
+// in event driven mode this is the resolution of the step timing rather than the rate the interrupt runs at
 void StepTicker::set_frequency( float frequency )
 {
     this->frequency = frequency;
     this->period = floorf((SystemCoreClock / 4.0F) / frequency); // SystemCoreClock/4 = Timer increments in a second
+    // in event driven mode the timer is free running and MR0 is moved to the time of the next step
+    LPC_TIM0->MCR = event_driven ? 1 : 3;  // Match on MR0, reset on MR0 unless event driven
     LPC_TIM0->MR0 = this->period;
     LPC_TIM0->TCR = 3;  // Reset
     LPC_TIM0->TCR = 1;  // start
@@ -89,19 +118,126 @@ void StepTicker::set_unstep_time( float microseconds )
 {
     uint32_t delay = floorf((SystemCoreClock / 4.0F) * (microseconds / 1000000.0F)); // SystemCoreClock/4 = Timer increments in a second
     LPC_TIM1->MR0 = delay;
+    this->unstep_delay = delay;
 
     // TODO check that the unstep time is less than the step period, if not slow down step ticker
 }
 
-// Reset step pins on any motor that was stepped
+// A motor that would step on more than half the ticks is given 2 or 4 step pulses on a half or a quarter of them instead, from
+// the tick it gets that fast, see Block::plan_multi_step(), so it can step faster than the tick rate, or the tick rate can be
+// lowered for the same top speed.
+// The pulses are evenly spaced across the tick, each has to be unstepped before the next so they must be at least two unstep times apart
+void StepTicker::set_multi_step(uint8_t n)
+{
+    if(n > k_max_multi_step) n= k_max_multi_step;
+    multi_step= 1;
+    // a tick is period + 1 timer counts, as the timer resets on the count after the match
+    while(!event_driven && multi_step * 2 <= n && (period + 1) / (multi_step * 2) >= 2 * unstep_delay) {
+        multi_step *= 2;
+    }
+    train_gap= (period + 1) / multi_step;
+}
+
+static LPC_GPIO_TypeDef * const gpio_ports[]= {LPC_GPIO0, LPC_GPIO1, LPC_GPIO2, LPC_GPIO3, LPC_GPIO4};
+
+// Reset step pins on any motor that was stepped, one write per port
+// during a pulse train the timer keeps counting from the start of the tick, and each match sets the next pulse or unsteps it in turn
 void StepTicker::unstep_tick()
 {
-    for (int i = 0; i < num_motors; i++) {
-        if(this->unstep[i]) {
-            this->motor[i]->unstep();
+    uint32_t next;
+    do {
+        if(train_step_due) {
+            uint16_t slots= this->train_slots[train_pulse];
+            while(slots != 0) {
+                int s= __builtin_ctz(slots);
+                slots &= slots - 1;
+                uint32_t bits= train_bits[train_pulse][s];
+                if(s & 1) gpio_ports[s >> 1]->FIOCLR = bits; // inverted
+                else gpio_ports[s >> 1]->FIOSET = bits;
+                unstep_bits[s] |= bits;
+                train_bits[train_pulse][s]= 0;
+            }
+            this->unstep_slots |= this->train_slots[train_pulse];
+            this->train_slots[train_pulse]= 0;
+            train_step_due= false;
+            next= (++train_pulse) * train_gap + unstep_delay;
+
+        } else {
+            uint16_t slots= this->unstep_slots;
+            while(slots != 0) {
+                int s= __builtin_ctz(slots);
+                slots &= slots - 1;
+                if(s & 1) gpio_ports[s >> 1]->FIOSET = unstep_bits[s]; // inverted
+                else gpio_ports[s >> 1]->FIOCLR = unstep_bits[s];
+                unstep_bits[s]= 0;
+            }
+            this->unstep_slots= 0;
+
+            if(!train_running) return;
+
+            // a motor given fewer pulses than the most skips some of the train, see queue_train()
+            while(train_pulse < k_max_multi_step - 1 && this->train_slots[train_pulse] == 0) ++train_pulse;
+            if(train_pulse == k_max_multi_step - 1) {
+                // the train is done, back to a single unstep
+                train_running= false;
+                LPC_TIM1->TCR = 0;
+                LPC_TIM1->MCR = 5;
+                LPC_TIM1->MR0 = unstep_delay;
+                return;
+            }
+            train_step_due= true;
+            next= (train_pulse + 1) * train_gap;
         }
+
+        LPC_TIM1->MR0 = next;
+        // if the interrupt was late and the timer is already past it, do it now rather than wait for the timer to wrap
+    } while(LPC_TIM1->TC >= next);
+}
+
+// Set the step pins queued in this tick, one write per port, and remember them for the unstep
+void StepTicker::write_steps()
+{
+    uint16_t slots= this->step_slots;
+    while(slots != 0) {
+        int s= __builtin_ctz(slots);
+        slots &= slots - 1;
+        if(s & 1) gpio_ports[s >> 1]->FIOCLR = step_bits[s]; // inverted
+        else gpio_ports[s >> 1]->FIOSET = step_bits[s];
+        unstep_bits[s] |= step_bits[s];
+        step_bits[s]= 0;
     }
-    this->unstep.reset();
+    this->unstep_slots |= this->step_slots;
+    this->step_slots= 0;
+}
+
+// the pulses after the first of a tick that gives the motor more than one, TIMER1 sets them, see unstep_tick()
+// the train has a pulse for each of the most a motor is given, one given fewer has every second or fourth so they are evenly spaced too
+void StepTicker::queue_train(uint8_t m, uint8_t pulses)
+{
+    uint8_t spacing= multi_step / pulses;
+    if(spacing == 0) spacing= 1;
+    for (int i = 1; i < pulses; ++i) {
+        int j= i * spacing - 1;
+        train_bits[j][step_slot[m]] |= step_mask[m];
+        train_slots[j] |= (1 << step_slot[m]);
+    }
+    train_queued= true;
+}
+
+// the steps written out in this tick are unstepped by TIMER1, which keeps going to set the rest of a pulse train if there is one
+void StepTicker::start_unstep_timer()
+{
+    if(train_queued) {
+        // interrupt on each match but do not stop, so the pulses are spaced from the start of the tick
+        train_queued= false;
+        train_pulse= 0;
+        train_step_due= false;
+        train_running= true;
+        LPC_TIM1->MCR = 1;
+        LPC_TIM1->MR0 = unstep_delay;
+    }
+    LPC_TIM1->TCR = 3;
+    LPC_TIM1->TCR = 1;
 }
 
 extern "C" void TIMER1_IRQHandler (void)
@@ -115,7 +251,11 @@ extern "C" void TIMER0_IRQHandler (void)
 {
     // Reset interrupt register
     LPC_TIM0->IR |= 1 << 0;
-    StepTicker::getInstance()->step_tick();
+    if(StepTicker::getInstance()->is_event_driven()) {
+        StepTicker::getInstance()->step_event();
+    } else {
+        StepTicker::getInstance()->step_tick();
+    }
 }
 
 extern "C" void PendSV_Handler(void)
@@ -130,6 +270,130 @@ void StepTicker::handle_finish (void)
     if(finished_fnc) finished_fnc();
 }
 
+void StepTicker::pend_finish()
+{
+    // NVIC_SetPendingIRQ() is only for the peripheral interrupts
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+// advance the motor by one tick of the block, returns true if it is time to issue a step
+// this is the per tick acceleration handling, it is shared by the fixed tick and the event driven modes
+static inline bool tick_motor(Block *block, uint8_t m, uint32_t tick)
+{
+    Block::tickinfo_t& ti= block->tick_info[m];
+    ti.acceleration_change += ti.jerk_change;
+    ti.steps_per_tick += ti.acceleration_change;
+
+    if(tick == ti.next_accel_event) {
+        if(block->s_curve) {
+            // the S-curve has more segments, the jerk changes at each one
+            block->s_curve_segment(m, tick + 1);
+
+        } else {
+            const Block::tickinfo_block_t& tb= *block->tick_info_block;
+            if(tick == tb.accelerate_until) { // We are done accelerating, deceleration becomes 0 : plateau
+                ti.acceleration_change = 0;
+                if(tb.decelerate_after < tb.total_move_ticks) {
+                    ti.next_accel_event = tb.decelerate_after;
+                    if(tick != tb.decelerate_after) { // We are plateauing
+                        // steps/sec / tick frequency to get steps per tick
+                        ti.steps_per_tick = block->cold_rate(m, block->tick_info_cold()[m].plateau_rate);
+                    }
+                }
+            }
+
+            if(tick == tb.decelerate_after) { // We start decelerating
+                ti.acceleration_change = block->cold_rate(m, block->tick_info_cold()[m].deceleration_change);
+            }
+        }
+    }
+
+    // protect against rounding errors and such
+    if(ti.steps_per_tick <= 0) {
+        ti.counter = STEPTICKER_FPSCALE; // we force completion this step by setting to 1.0
+        ti.steps_per_tick = 0;
+    }
+
+    ti.counter += ti.steps_per_tick;
+
+    if(ti.counter >= STEPTICKER_FPSCALE) { // >= 1.0 step time
+        ti.counter -= STEPTICKER_FPSCALE; // -= 1.0F;
+        return true;
+    }
+
+    return false;
+}
+
+// advance the motor by one tick, returns true if it is still moving after it, its bit in ticking_mask is cleared once it has finished
+bool StepTicker::tick_actuator(uint8_t m)
+{
+    if(path.active && m == path.axis[0]) {
+        // a step along the path, path_tick() steps the axes that follow it to the new point on it
+        if(tick_motor(current_block, m, current_tick)) {
+            Block::tickinfo_t& ti= current_block->tick_info[m];
+            ++ti.step_count;
+            if(ti.step_count == ti.steps_to_move) {
+                // the last one goes to exactly where the block ends up
+                for (int k = 0; k < path.n; ++k) {
+                    uint8_t a= path.axis[k];
+                    path.target[k]= (current_block->direction_bits >> a) & 1 ? -(int32_t)current_block->steps[a] : (int32_t)current_block->steps[a];
+                }
+                ti.steps_to_move= 0;
+                ticking_mask &= ~(1 << m);
+            } else if(current_block->arc) {
+                arc_path_step();
+            } else {
+                kin_path_step(ti.step_count);
+            }
+        }
+        return false;
+    }
+
+    if(shaper[m] != nullptr && !motor[m]->is_moving()) {
+        // stopped externally (probes, endstops etc), the steps the shaper has not issued yet are dropped
+        shaper[m]->flush();
+        shaped_step[m]= 0;
+        current_block->tick_info[m].steps_to_move = 0;
+        ticking_mask &= ~(1 << m);
+        return false;
+    }
+
+    if(tick_motor(current_block, m, current_tick)) { // >= 1.0 step time
+        ++current_block->tick_info[m].step_count;
+
+        bool ismoving;
+        if(shaper[m] != nullptr) {
+            // the shaper issues and counts the step, spread out over the following ticks
+            shaped_step[m]= (current_block->direction_bits >> m) & 1 ? -1 : 1;
+            ismoving= true;
+
+        } else if(current_block->tick_info[m].multi_step > 1) {
+            // the motor is given more than one step pulse in the tick, the last one has what is left
+            Block::tickinfo_t& ti= current_block->tick_info[m];
+            uint8_t pulses= std::min<uint32_t>(ti.multi_step, ti.steps_to_move - ti.step_count + 1);
+            ti.step_count += pulses - 1;
+            ismoving= motor[m]->count_steps(pulses);
+            queue_step(m);
+            if(pulses > 1) queue_train(m, pulses);
+
+        } else {
+            // step the motor
+            ismoving= motor[m]->count_step(); // returns false if the moving flag was set to false externally (probes, endstops etc)
+            // the pin is set along with the others on the same port once all motors have been checked
+            queue_step(m);
+        }
+
+        if(!ismoving || current_block->tick_info[m].step_count == current_block->tick_info[m].steps_to_move) {
+            // done
+            current_block->tick_info[m].steps_to_move = 0;
+            ticking_mask &= ~(1 << m);
+            motor[m]->stop_moving(); // let motor know it is no longer moving
+        }
+    }
+
+    return motor[m]->is_moving();
+}
+
 // step clock
 void StepTicker::step_tick (void)
 {
@@ -140,8 +404,24 @@ void StepTicker::step_tick (void)
         // check if anything new available
         if(THECONVEYOR->get_next_block(&current_block)) { // returns false if no new block is available
             running= start_next_block(); // returns true if there is at least one motor with steps to issue
-            if(!running) return;
-        }else{
+        }
+
+        if(!running) {
+            if(replan_state == REPLAN_PENDING) replan_state= REPLAN_MISSED;
+
+            // the input shapers carry on issuing the end of the last block
+            if(shapers_busy) {
+                if(THEKERNEL->is_halted()) {
+                    flush_shapers();
+                    return;
+                }
+                shape_tick();
+                if(step_slots != 0) {
+                    write_steps();
+                    LPC_TIM1->TCR = 3;
+                    LPC_TIM1->TCR = 1;
+                }
+            }
             return;
         }
     }
@@ -150,60 +430,27 @@ void StepTicker::step_tick (void)
         running= false;
         current_tick = 0;
         current_block= nullptr;
+        path.active= false;
+        if(replan_state == REPLAN_PENDING) replan_state= REPLAN_MISSED;
+        flush_shapers();
         return;
     }
 
-    bool still_moving= false;
-    // foreach motor, if it is active see if time to issue a step to that motor
-    for (uint8_t m = 0; m < num_motors; m++) {
-        if(current_block->tick_info[m].steps_to_move == 0) continue; // not active
-
-        current_block->tick_info[m].steps_per_tick += current_block->tick_info[m].acceleration_change;
-
-        if(current_tick == current_block->tick_info[m].next_accel_event) {
-            if(current_tick == current_block->accelerate_until) { // We are done accelerating, deceleration becomes 0 : plateau
-                current_block->tick_info[m].acceleration_change = 0;
-                if(current_block->decelerate_after < current_block->total_move_ticks) {
-                    current_block->tick_info[m].next_accel_event = current_block->decelerate_after;
-                    if(current_tick != current_block->decelerate_after) { // We are plateauing
-                        // steps/sec / tick frequency to get steps per tick
-                        current_block->tick_info[m].steps_per_tick = current_block->tick_info[m].plateau_rate;
-                    }
-                }
-            }
-
-            if(current_tick == current_block->decelerate_after) { // We start decelerating
-                current_block->tick_info[m].acceleration_change = current_block->tick_info[m].deceleration_change;
-            }
-        }
-
-        // protect against rounding errors and such
-        if(current_block->tick_info[m].steps_per_tick <= 0) {
-            current_block->tick_info[m].counter = STEPTICKER_FPSCALE; // we force completion this step by setting to 1.0
-            current_block->tick_info[m].steps_per_tick = 0;
-        }
+    if(replan_state == REPLAN_PENDING && current_tick == replan_tick) start_replanned_block();
 
-        current_block->tick_info[m].counter += current_block->tick_info[m].steps_per_tick;
+    if(current_tick == current_block->tick_info_block->multi_step_tick) current_block->multi_step_event(current_tick);
 
-        if(current_block->tick_info[m].counter >= STEPTICKER_FPSCALE) { // >= 1.0 step time
-            current_block->tick_info[m].counter -= STEPTICKER_FPSCALE; // -= 1.0F;
-            ++current_block->tick_info[m].step_count;
+    // see if it is time to issue a step to each motor that is active in this block, and if any are still moving after this tick
+    // a copy of this for each actuator count, with the loop unrolled, was tried and dropped: it was no faster on the host
+    // and more than doubled the size of this file's code, it has not been timed on the board
+    bool still_moving= false;
+    for (uint8_t a= ticking_mask; a != 0; a &= a - 1) {
+        if(tick_actuator(__builtin_ctz(a))) still_moving= true;
+    }
 
-            // step the motor
-            bool ismoving= motor[m]->step(); // returns false if the moving flag was set to false externally (probes, endstops etc)
-            // we stepped so schedule an unstep
-            unstep.set(m);
+    if(path.active && path_tick()) still_moving= true;
 
-            if(!ismoving || current_block->tick_info[m].step_count == current_block->tick_info[m].steps_to_move) {
-                // done
-                current_block->tick_info[m].steps_to_move = 0;
-                motor[m]->stop_moving(); // let motor know it is no longer moving
-            }
-        }
-
-        // see if any motors are still moving after this tick
-        if(motor[m]->is_moving()) still_moving= true;
-    }
+    if(n_shaped != 0) shape_tick();
 
     // do this after so we start at tick 0
     current_tick++; // count number of ticks
@@ -212,9 +459,9 @@ void StepTicker::step_tick (void)
     // Note there could be a race here if we run another tick before the unsteps have happened,
     // right now it takes about 3-4us but if the unstep were near 10uS or greater it would be an issue
     // also it takes at least 2us to get here so even when set to 1us pulse width it will still be about 3us
-    if( unstep.any()) {
-        LPC_TIM1->TCR = 3;
-        LPC_TIM1->TCR = 1;
+    if(step_slots != 0) {
+        write_steps();
+        start_unstep_timer();
     }
 
 
@@ -224,10 +471,13 @@ void StepTicker::step_tick (void)
 
         // all moves finished
         current_tick = 0;
+        if(replan_state == REPLAN_PENDING) replan_state= REPLAN_MISSED;
 
         // get next block
         // do it here so there is no delay in ticks
-        THECONVEYOR->block_finished();
+        // a parked block is only the first part of the block in the queue, which stays there
+        if(current_block == park_block) park_block= nullptr;
+        else THECONVEYOR->block_finished();
 
         if(THECONVEYOR->get_next_block(&current_block)) { // returns false if no new block is available
             running= start_next_block(); // returns true if there is at least one motor with steps to issue
@@ -244,6 +494,473 @@ void StepTicker::step_tick (void)
     }
 }
 
+/*
+ * Native arcs and kinematic lines
+ *
+ * The first axis of the path is ticked along its length instead of its own steps, see Block::ticked_steps(), and each step
+ * along it gives the point on the path the axes that follow it are stepped to, the others are stepped along with the length
+ * of the path as usual. A following axis moves at most about one step per step along the path, and it may change direction
+ * on the way, so it is given a tick for the direction pin to settle first. At the end they go to exactly where the block ends up.
+ *
+ * For a native arc the first arc axis is ticked along the arc and both arc axes follow it, each step along the arc turns the
+ * point on it through the same angle, in 2.62 fixed point with 64 bit intermediates, so there is no drift over thousands of steps.
+ *
+ * For a kinematic line on a linear delta the first tower is ticked along the line and all three towers follow it, the arm
+ * solution has worked out where they are at waypoints along it, close enough together that they move in a straight line from
+ * one to the next, see Block::prepare_waypoints(), and the point on the line is moved towards the next one in 32.32 fixed point.
+ * So the line is planned as one block, with no junctions where the delta segments would meet.
+ */
+
+// (a * b) >> 62 rounded towards zero, from 32 bit multiplies, a is 32.32 fixed point steps and b is no more than 1.0
+static inline int64_t mul_q62(int64_t a, int64_t b)
+{
+    bool negative= (a < 0) != (b < 0);
+    uint64_t ua= (a < 0) ? -a : a;
+    uint64_t ub= (b < 0) ? -b : b;
+    uint64_t ll= (ua & 0xFFFFFFFF) * (ub & 0xFFFFFFFF);
+    uint64_t lh= (ua & 0xFFFFFFFF) * (ub >> 32);
+    uint64_t hl= (ua >> 32) * (ub & 0xFFFFFFFF);
+    uint64_t hh= (ua >> 32) * (ub >> 32);
+    uint64_t mid= (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    uint64_t hi= hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    uint64_t r= (hi << 2) | ((mid & 0xFFFFFFFF) >> 30);
+    return negative ? -(int64_t)r : (int64_t)r;
+}
+
+void StepTicker::start_path()
+{
+    if(current_block->arc) {
+        const Block::path_t *p= current_block->path();
+        const float q62= (float)(1LL << 62);
+        const float q32= (float)(1LL << 32);
+        arc.cos_m1= (int64_t)(p->arc_cos_m1 * q62);
+        for (int k = 0; k < 2; ++k) {
+            path.axis[k]= p->arc_axis[k];
+            arc.position[k]= arc.start[k]= (int64_t)(p->arc_start[k] * q32);
+            arc.sin[k]= (int64_t)(p->arc_sin[k] * q62);
+        }
+        path.n= 2;
+
+    } else {
+        for (int k = 0; k < 3; ++k) {
+            path.axis[k]= ALPHA_STEPPER + k;
+            kin.position[k]= 0;
+        }
+        kin.waypoint= 0;
+        path.n= 3;
+    }
+
+    for (int k = 0; k < path.n; ++k) {
+        path.made[k]= path.target[k]= 0;
+        motor[path.axis[k]]->start_moving();
+    }
+    path.active= true;
+}
+
+// turn the point on the arc one step along it
+void StepTicker::arc_path_step()
+{
+    int64_t x= arc.position[0], y= arc.position[1];
+    arc.position[0]= x + mul_q62(x, arc.cos_m1) - mul_q62(y, arc.sin[0]);
+    arc.position[1]= y + mul_q62(y, arc.cos_m1) + mul_q62(x, arc.sin[1]);
+    for (int k = 0; k < 2; ++k) {
+        path.target[k]= (int32_t)((arc.position[k] - arc.start[k] + (1LL << 31)) >> 32);
+    }
+}
+
+// move the point on the kinematic line one step along it, it is put exactly on each waypoint as it gets there
+void StepTicker::kin_path_step(uint32_t step)
+{
+    const Block::waypoint_t& w= current_block->waypoints()[kin.waypoint];
+    if(step == w.until) {
+        const Block::waypoint_t& next= current_block->waypoints()[++kin.waypoint];
+        for (int k = 0; k < 3; ++k) kin.position[k]= (int64_t)next.steps[k] << 32;
+    } else {
+        for (int k = 0; k < 3; ++k) kin.position[k] += (int64_t)w.steps_per_step[k] << 2;
+    }
+    for (int k = 0; k < 3; ++k) {
+        path.target[k]= (int32_t)((kin.position[k] + (1LL << 31)) >> 32);
+    }
+}
+
+// step the axes that follow the path towards the point on it, returns true until the path is done
+bool StepTicker::path_tick()
+{
+    bool busy= current_block->tick_info[path.axis[0]].steps_to_move != 0;
+    for (int k = 0; k < path.n; ++k) {
+        uint8_t m= path.axis[k];
+        if(path.made[k] == path.target[k]) continue;
+        busy= true;
+
+        bool dir= path.target[k] < path.made[k];
+        if(shaper[m] != nullptr) {
+            // the shaper sets the direction itself
+            shaped_step[m]= dir ? -1 : 1;
+
+        } else if(dir != motor[m]->which_direction()) {
+            // step on the next tick, once the direction pin has settled
+            motor[m]->set_direction(dir);
+            continue;
+
+        } else {
+            if(!motor[m]->count_step()) {
+                // stopped externally (probes, endstops etc)
+                current_block->tick_info[path.axis[0]].steps_to_move= 0;
+                ticking_mask &= ~(1 << path.axis[0]);
+                path.active= false;
+                for (int j = 0; j < path.n; ++j) motor[path.axis[j]]->stop_moving();
+                return false;
+            }
+            queue_step(m);
+        }
+        path.made[k] += dir ? -1 : 1;
+    }
+
+    if(!busy) {
+        path.active= false;
+        for (int j = 0; j < path.n; ++j) motor[path.axis[j]]->stop_moving();
+    }
+    return busy;
+}
+
+/*
+ * Replanning the executing block
+ *
+ * To change the speed of the block that is executing, for the feed override, the rest of it is replanned as a block of its own.
+ * predict_current_block() copies the executing block and runs the copy forward the given number of ticks, through the same
+ * tick_motor() the ISR uses, so it knows exactly how many steps each motor will have made by then, the counters and the rate.
+ * The rest of the block is then planned from there in the main loop, and the ISR swaps to it on that tick, if the motors
+ * have made the steps predicted (a motor stopped by an endstop, a halt, or the block finishing early all mean it missed).
+ * For the feed hold the replanned block can be parked, it is just the part of the rest that slows down to a stop, when it
+ * finishes the block in the queue is not finished, the conveyor has made it into what is left to do after the hold.
+ */
+
+// the block is copied into b, its tick info slot must be set, returns false if the block will have less than min_ticks_left left by then
+bool StepTicker::predict_current_block(Block *b, uint32_t ticks, uint32_t min_ticks_left)
+{
+    if(event_driven || replan_state == REPLAN_PENDING) return false;
+
+    uint8_t slot= b->tick_info_slot;
+
+    // take a copy of the block and where it is up to in between ticks
+    __disable_irq();
+    const Block *from= current_block;
+    uint32_t tick= current_tick;
+    bool ok= running && from != nullptr && !from->arc && !from->kinematic;
+    if(ok) {
+        *b= *from;
+        b->set_tick_info_slot(slot);
+        memcpy(b->tick_info, from->tick_info, sizeof(Block::tickinfo_t) * Block::n_actuators);
+        memcpy(b->tick_info_cold(), from->tick_info_cold(), sizeof(Block::tickinfo_cold_t) * Block::n_actuators);
+        *b->tick_info_block= *from->tick_info_block;
+    }
+    __enable_irq();
+    if(!ok) return false;
+
+    Block::tickinfo_t *ti= b->tick_info;
+    const Block::tickinfo_block_t& tb= *b->tick_info_block;
+    if(tick + ticks + min_ticks_left > tb.total_move_ticks) return false;
+
+    // run it forward the same as step_tick() does
+    for (uint32_t n = 0; n < ticks; ++n, ++tick) {
+        if(tick == tb.multi_step_tick) b->multi_step_event(tick);
+
+        bool still_moving= false;
+        for (uint8_t i = 0; i < tb.n_active_actuators; i++) {
+            uint8_t m= tb.active_actuators[i];
+            if(ti[m].steps_to_move == 0) continue; // finished
+
+            if(tick_motor(b, m, tick)) {
+                ti[m].step_count += std::min<uint32_t>(ti[m].multi_step, ti[m].steps_to_move - ti[m].step_count);
+                if(ti[m].step_count == ti[m].steps_to_move) {
+                    ti[m].steps_to_move= 0;
+                    continue;
+                }
+            }
+            still_moving= true;
+        }
+        if(!still_moving) return false;
+    }
+
+    for (uint8_t i = 0; i < tb.n_active_actuators; i++) {
+        uint8_t m= tb.active_actuators[i];
+        replan_step_count[m]= ti[m].step_count;
+    }
+    replan_from= from;
+    replan_tick= tick;
+    return true;
+}
+
+// swap the executing block for the replanned rest of it, if the motors are where predict_current_block() said they would be
+void StepTicker::start_replanned_block()
+{
+    replan_state= REPLAN_MISSED;
+    if(current_block != replan_from) return;
+
+    for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= current_block->tick_info_block->active_actuators[i];
+        const Block::tickinfo_t& ti= current_block->tick_info[m];
+        if(ti.step_count != replan_step_count[m]) return;
+        // stopped externally
+        if(ti.steps_to_move == 0 && replan_block->steps[m] != 0) return;
+    }
+
+    // a motor that has no steps left in the replanned block is done
+    for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= current_block->tick_info_block->active_actuators[i];
+        if(current_block->tick_info[m].steps_to_move != 0 && replan_block->steps[m] == 0) motor[m]->stop_moving();
+    }
+
+    current_block= replan_block;
+    ticking_mask= current_block->tick_info_block->active_mask;
+    current_tick= 0;
+    replan_state= REPLAN_DONE;
+}
+
+/*
+ * Event driven mode
+ *
+ * Instead of running tick_motor() for every motor on every tick, the tick each motor will next step on is calculated
+ * in advance and TIMER0 is set to fire only when the soonest of those is due.
+ * Between acceleration events the rate changes by a constant amount each tick, so the counter after k ticks is
+ * counter + k*steps_per_tick + acceleration_change*k*(k+1)/2 and the tick it reaches 1.0 can be searched for directly,
+ * this gives the same step ticks as the fixed tick mode. The acceleration event ticks themselves are run through tick_motor(),
+ * as are the ticks in the parts of an S-curve where the acceleration is changing.
+ * The ticks are on a fixed time grid from the start of the block, so a late interrupt does not accumulate. A tick is period + 1
+ * timer counts, as the fixed tick timer resets on the count after the match, so both modes produce the same step timing.
+ */
+
+// how long we wait at most before checking for halt or a new block, in timer counts (1ms)
+#define EVENT_MAX_WAIT (SystemCoreClock / 4000)
+// time given to the direction pins to settle before the first step of a block, in timer counts (10us)
+#define EVENT_DIRECTION_SETUP (SystemCoreClock / 400000)
+// the most ticks find_next_step() will run one at a time before returning
+#define EVENT_MAX_TICK_LOOP 64
+
+// the sum of steps_per_tick over the next k ticks, arranged so the halving is exact and it does not overflow for the k it is used for
+static inline uint64_t ticks_distance(int64_t v, int64_t a, uint32_t k)
+{
+    uint64_t w= (uint64_t)(2 * v) + (uint64_t)(a * ((int64_t)k + 1)); // twice the average rate over the k ticks
+    return (k & 1) ? (uint64_t)k * (w / 2) : (uint64_t)(k / 2) * w;
+}
+
+// advance the motor up to n ticks with no acceleration events in them
+// returns k if it steps on the k'th of those ticks, or 0 if it does not step (and has been advanced all n ticks)
+static uint32_t skip_ticks(Block::tickinfo_t& ti, uint32_t n)
+{
+    int64_t v= ti.steps_per_tick;
+    int64_t a= ti.acceleration_change;
+    uint64_t remaining= (ti.counter >= STEPTICKER_FPSCALE) ? 0 : STEPTICKER_FPSCALE - ti.counter;
+
+    // the tick the rate drops to zero, tick_motor() forces a step there
+    uint32_t kz= UINT32_MAX;
+    if(v + a <= 0) {
+        kz= 1;
+    } else if(a < 0) {
+        uint64_t z= ((uint64_t)v - a - 1) / (uint64_t)(-a);
+        if(z < kz) kz= z;
+    }
+
+    // find the first tick the counter reaches 1.0 before that
+    // doubling k at most quadruples the distance, so none of this can overflow as it stops once it reaches remaining < 1.0
+    uint32_t limit= std::min(n, kz - 1);
+    uint32_t k= 0;
+    if(limit > 0) {
+        uint32_t lo= 0, hi= 1;
+        while(ticks_distance(v, a, hi) < remaining) {
+            lo= hi;
+            if(hi == limit) break;
+            hi= (hi > limit / 2) ? limit : hi * 2;
+        }
+        if(lo != hi) {
+            while(hi - lo > 1) {
+                uint32_t mid= lo + (hi - lo) / 2;
+                if(ticks_distance(v, a, mid) >= remaining) hi= mid;
+                else lo= mid;
+            }
+            k= hi;
+        }
+    }
+
+    if(k != 0) {
+        ti.counter += ticks_distance(v, a, k) - STEPTICKER_FPSCALE;
+        ti.steps_per_tick= v + a * k;
+        return k;
+    }
+
+    if(kz <= n) {
+        // same as tick_motor() we force the step when the rate gets to zero
+        ti.counter= 0;
+        ti.steps_per_tick= 0;
+        return kz;
+    }
+
+    ti.counter += ticks_distance(v, a, n);
+    ti.steps_per_tick= v + a * n;
+    return 0;
+}
+
+// run the motor forward from the given tick, returns the tick it next steps on
+// while the acceleration is changing (S-curve) the ticks have to be run one at a time, so to keep the ISR short this
+// gives up after EVENT_MAX_TICK_LOOP of them and returns the tick it got to with stepped false, to be continued from there
+static uint32_t find_next_step(Block *block, uint8_t m, uint32_t tick, bool& stepped)
+{
+    Block::tickinfo_t& ti= block->tick_info[m];
+    uint32_t budget= EVENT_MAX_TICK_LOOP;
+    stepped= true;
+    while(true) {
+        if(ti.jerk_change == 0) {
+            // ticks before the next acceleration event, if it has passed there are no more
+            uint32_t n= (ti.next_accel_event >= tick) ? ti.next_accel_event - tick : UINT32_MAX - tick;
+            if(n > 0) {
+                uint32_t k= skip_ticks(ti, n);
+                if(k != 0) return tick + k - 1;
+                tick += n;
+            }
+        }
+
+        // the event tick itself, or any tick while the jerk is not zero
+        if(tick_motor(block, m, tick)) return tick;
+        if(--budget == 0) {
+            stepped= false;
+            return tick;
+        }
+        ++tick;
+    }
+}
+
+// start the block we just got from the conveyor, tick 0 of it will be at the given time (or later)
+void StepTicker::start_next_event_block(uint32_t start)
+{
+    running= start_next_block(); // sets the direction pins
+    if(!running) return;
+
+    uint32_t earliest= LPC_TIM0->TC + EVENT_DIRECTION_SETUP;
+    if((int32_t)(start - earliest) < 0) start= earliest;
+    block_start= start;
+
+    for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= current_block->tick_info_block->active_actuators[i];
+        bool stepped;
+        next_step_tick[m]= find_next_step(current_block, m, 0, stepped);
+        step_due[m]= stepped;
+    }
+}
+
+// set MR0 to the time of the next step, or to poll for a new block if there is nothing running
+void StepTicker::schedule_event(uint32_t now)
+{
+    uint32_t wait= EVENT_MAX_WAIT;
+    if(running) {
+        uint32_t t= UINT32_MAX;
+        for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+            uint8_t m= current_block->tick_info_block->active_actuators[i];
+            if(current_block->tick_info[m].steps_to_move != 0 && next_step_tick[m] < t) t= next_step_tick[m];
+        }
+
+        if(t != UINT32_MAX) {
+            current_tick= t;
+            int32_t d= (block_start + t * (period + 1)) - now;
+            if(d < (int32_t)wait) wait= (d < 0) ? 0 : d;
+        }
+    }
+
+    // the match must be far enough ahead that the timer has not already passed it, and the unstep has been done
+    uint32_t target= now + wait;
+    uint32_t earliest= LPC_TIM0->TC + unstep_delay * 2 + 1;
+    if((int32_t)(target - earliest) < 0) target= earliest;
+    LPC_TIM0->MR0= target;
+}
+
+// event driven step clock, called when the next step is due
+void StepTicker::step_event (void)
+{
+    uint32_t now= LPC_TIM0->TC;
+
+    if(!running) {
+        // check if anything new available
+        if(THECONVEYOR->get_next_block(&current_block)) { // returns false if no new block is available
+            start_next_event_block(now);
+        }
+        schedule_event(now);
+        return;
+    }
+
+    if(THEKERNEL->is_halted()) {
+        running= false;
+        current_tick = 0;
+        current_block= nullptr;
+        schedule_event(now);
+        return;
+    }
+
+    if((int32_t)(now - (block_start + current_tick * (period + 1))) < 0) {
+        // woken up early to check for halt, nothing is due yet
+        schedule_event(now);
+        return;
+    }
+
+    bool still_moving= false;
+    for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= current_block->tick_info_block->active_actuators[i];
+        Block::tickinfo_t& ti= current_block->tick_info[m];
+        if(ti.steps_to_move == 0) continue; // finished
+
+        if(next_step_tick[m] == current_tick && !step_due[m]) {
+            // no step yet, find_next_step() gave up part way
+            bool stepped;
+            next_step_tick[m]= find_next_step(current_block, m, current_tick + 1, stepped);
+            step_due[m]= stepped;
+
+        } else if(next_step_tick[m] == current_tick) {
+            ++ti.step_count;
+
+            // step the motor
+            bool ismoving= motor[m]->count_step(); // returns false if the moving flag was set to false externally (probes, endstops etc)
+            // the pin is set along with the others on the same port once all motors have been checked
+            queue_step(m);
+
+            if(!ismoving || ti.step_count == ti.steps_to_move) {
+                // done
+                ti.steps_to_move = 0;
+                motor[m]->stop_moving(); // let motor know it is no longer moving
+
+            } else {
+                bool stepped;
+                next_step_tick[m]= find_next_step(current_block, m, current_tick + 1, stepped);
+                step_due[m]= stepped;
+            }
+        }
+
+        // see if any motors are still moving after this step
+        if(motor[m]->is_moving()) still_moving= true;
+    }
+
+    if(step_slots != 0) {
+        write_steps();
+        LPC_TIM1->TCR = 3;
+        LPC_TIM1->TCR = 1;
+    }
+
+    if(!still_moving) {
+        // the next block starts on the tick after the last step of this one, same as in the fixed tick mode
+        uint32_t next_start= block_start + (current_tick + 1) * (period + 1);
+        current_tick = 0;
+
+        THECONVEYOR->block_finished();
+
+        if(THECONVEYOR->get_next_block(&current_block)) { // returns false if no new block is available
+            start_next_event_block(next_start);
+
+        }else{
+            current_block= nullptr;
+            running= false;
+        }
+    }
+
+    schedule_event(now);
+}
+
 // only called from the step tick ISR (single consumer)
 bool StepTicker::start_next_block()
 {
@@ -251,18 +968,21 @@ bool StepTicker::start_next_block()
 
     bool ok= false;
     // need to prepare each active motor
-    for (uint8_t m = 0; m < num_motors; m++) {
-        if(current_block->tick_info[m].steps_to_move == 0) continue;
+    for (uint8_t i = 0; i < current_block->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= current_block->tick_info_block->active_actuators[i];
 
         ok= true; // mark at least one motor is moving
         // set direction bit here
         // NOTE this would be at least 10us before first step pulse.
         // TODO does this need to be done sooner, if so how without delaying next tick
-        motor[m]->set_direction(current_block->direction_bits[m]);
+        // a shaped motor may still be issuing steps of the last block, its shaper sets the direction
+        if(shaper[m] == nullptr) motor[m]->set_direction((current_block->direction_bits >> m) & 1);
         motor[m]->start_moving(); // also let motor know it is moving now
     }
 
+    ticking_mask= current_block->tick_info_block->active_mask;
     current_tick= 0;
+    if(current_block->arc || current_block->kinematic) start_path();
 
     if(ok) {
         //SET_STEPTICKER_DEBUG_PIN(1);
@@ -278,9 +998,63 @@ bool StepTicker::start_next_block()
 }
 
 
+// run the input shapers for this tick, the steps they issue are written out along with the unshaped ones
+void StepTicker::shape_tick()
+{
+    bool busy= false;
+    for (uint8_t i = 0; i < n_shaped; i++) {
+        uint8_t m= shaped_motors[i];
+        InputShaper *s= shaper[m];
+        int8_t in= shaped_step[m];
+        if(in == 0 && !s->is_busy()) continue;
+
+        shaped_step[m]= 0;
+        if(s->tick(in)) {
+            motor[m]->count_step();
+            queue_step(m);
+        }
+        // the shaper holds back the first step after a change of direction for a tick
+        if(s->get_direction() != motor[m]->which_direction()) motor[m]->set_direction(s->get_direction());
+        if(s->is_busy()) busy= true;
+    }
+    shapers_busy= busy;
+}
+
+// drop any steps the shapers have not issued, on halt
+void StepTicker::flush_shapers()
+{
+    for (uint8_t i = 0; i < n_shaped; i++) {
+        uint8_t m= shaped_motors[i];
+        shaper[m]->flush();
+        shaped_step[m]= 0;
+    }
+    shapers_busy= false;
+}
+
+// only called before the step ticker is started
+bool StepTicker::set_input_shaper(uint8_t m, InputShaper *s)
+{
+    // event driven mode only runs when a step is due, the shapers need every tick
+    if(event_driven || m >= num_motors) return false;
+
+    if(shaper[m] == nullptr) shaped_motors[n_shaped++]= m;
+    shaper[m]= s;
+    return true;
+}
+
 // returns index of the stepper motor in the array and bitset
 int StepTicker::register_motor(StepperMotor* m)
 {
+    // work out which port slot and bit the step pin is, so the ISR does not need to look at the pin
+    Pin pin= m->get_step_pin();
+    if(pin.connected()) {
+        step_slot[num_motors]= (pin.port_number * 2) + (pin.is_inverting() ? 1 : 0);
+        step_mask[num_motors]= 1 << pin.pin;
+    } else {
+        step_slot[num_motors]= 0;
+        step_mask[num_motors]= 0;
+    }
+
     motor[num_motors++] = m;
     return num_motors - 1;
 }
@@ -20,6 +20,7 @@
 
 class StepperMotor;
 class Block;
+class InputShaper;
 
 // handle 2.62 Fixed point
 #define STEPTICKER_FPSCALE (1LL<<62)
@@ -37,11 +38,35 @@ class StepTicker{
         const Block *get_current_block() const { return current_block; }
 
         void step_tick (void);
+        void step_event (void);
         void handle_finish (void);
         void start();
 
+        // event driven mode only fires the step interrupt when a step is due, must be set before set_frequency()
+        void set_event_driven(bool f) { event_driven= f; }
+        bool is_event_driven() const { return event_driven; }
+
+        // the most step pulses a fast motor is given in one tick, so it can step faster than the tick rate, must be set after set_unstep_time()
+        void set_multi_step(uint8_t n);
+        // not with the input shapers, they issue one step at a time
+        uint8_t get_multi_step() const { return (n_shaped == 0) ? multi_step : 1; }
+        static const uint8_t k_max_multi_step= 4;
+
+        // run the steps of the motor through the input shaper, only in the fixed tick mode, returns false if it cannot be used
+        bool set_input_shaper(uint8_t m, InputShaper *s);
+        // true while a shaper still has steps to issue after the blocks have finished
+        bool is_shaping() const { return shapers_busy; }
+
+        // replanning the rest of the executing block, only in the fixed tick mode, see Conveyor::replan_current_block()
+        enum REPLAN_STATE { REPLAN_NONE, REPLAN_PENDING, REPLAN_DONE, REPLAN_MISSED };
+        bool predict_current_block(Block *b, uint32_t ticks, uint32_t min_ticks_left);
+        void replan_current_block(Block *b, bool park= false) { replan_block= b; park_block= park ? b : nullptr; replan_state= REPLAN_PENDING; }
+        REPLAN_STATE get_replan_state() const { return replan_state; }
+
         // whatever setup the block should register this to know when it is done
         std::function<void()> finished_fnc{nullptr};
+        // runs handle_finish() in PendSV, after the step interrupts and before the main loop
+        void pend_finish();
 
         static StepTicker *getInstance() { return instance; }
 
@@ -49,17 +74,99 @@ class StepTicker{
         static StepTicker *instance;
 
         bool start_next_block();
+        bool tick_actuator(uint8_t m);
+        // set the step pin of the motor when the steps for this tick are written out
+        inline void queue_step(uint8_t m) { step_bits[step_slot[m]] |= step_mask[m]; step_slots |= (1 << step_slot[m]); }
+        void write_steps();
+        void start_unstep_timer();
+        void queue_train(uint8_t m, uint8_t pulses);
+        void start_next_event_block(uint32_t start);
+        void schedule_event(uint32_t now);
+        void shape_tick();
+        void start_replanned_block();
+        void start_path();
+        void arc_path_step();
+        void kin_path_step(uint32_t step);
+        bool path_tick();
+        void flush_shapers();
 
         float frequency;
         uint32_t period;
+        uint32_t unstep_delay;
         std::array<StepperMotor*, k_max_actuators> motor;
-        std::bitset<k_max_actuators> unstep;
+
+        // The step pins are set and cleared a whole GPIO port at a time.
+        // Each port has two slots, the pins that are set to step and the inverted pins that are cleared to step,
+        // slot is port * 2 + inverted, and the bits in step_slots/unstep_slots say which slots have pins in them
+        static const int k_step_slots= 10;
+        std::array<uint8_t, k_max_actuators> step_slot;
+        std::array<uint32_t, k_max_actuators> step_mask;
+        std::array<uint32_t, k_step_slots> step_bits;   // pins to step in this tick
+        std::array<uint32_t, k_step_slots> unstep_bits; // pins that have been stepped and need to be unstepped
+        volatile uint16_t step_slots;
+        volatile uint16_t unstep_slots;
+
+        // a tick that gives motors more than one step pulse sets the first with the others, and TIMER1 sets the rest
+        // train_gap counts apart, train_bits[j] are the pins for pulse j + 2, see unstep_tick()
+        std::array<std::array<uint32_t, k_step_slots>, k_max_multi_step - 1> train_bits;
+        std::array<uint16_t, k_max_multi_step - 1> train_slots;
+        uint32_t train_gap;
+        uint8_t train_pulse;      // the next pulse of the train
+        uint8_t multi_step;
+        bool train_queued;
+        bool train_running;
+        bool train_step_due;      // the next TIMER1 match sets a pulse of the train rather than unsteps
 
         Block *current_block;
         uint32_t current_tick{0};
+        uint8_t ticking_mask;     // the motors of the current block that still have steps to make, a bit per actuator
+
+        // event driven mode, the tick each motor steps on next and the timer count of tick 0 of the current block
+        std::array<uint32_t, k_max_actuators> next_step_tick;
+        std::bitset<k_max_actuators> step_due; // false if the motor does not step on next_step_tick, but needs to be looked at again
+        uint32_t block_start;
+
+        // the replanned block takes over from replan_from at replan_tick, if the motors have made the steps predicted by then
+        Block *replan_block;
+        const Block *replan_from;
+        uint32_t replan_tick;
+        std::array<uint32_t, k_max_actuators> replan_step_count;
+        volatile REPLAN_STATE replan_state;
+        const Block *park_block; // the block in the queue is not finished when this one is
+
+        // the native arc or kinematic line being executed, the first axis is ticked along the path and the others follow it
+        struct {
+            int32_t made[3];     // the steps each axis has made from the start
+            int32_t target[3];   // and the steps it has to get to
+            uint8_t axis[3];
+            uint8_t n;
+            bool active;
+        } path;
+
+        // the point on the native arc is turned a step along the arc at a time, in fixed point so it does not drift
+        struct {
+            int64_t position[2]; // from the centre, 32.32 fixed point steps of each arc axis
+            int64_t start[2];    // where it started
+            int64_t cos_m1;      // 2.62 fixed point
+            int64_t sin[2];      // 2.62 fixed point
+        } arc;
+
+        // the point on the kinematic line moves in a straight line from one waypoint to the next
+        struct {
+            int64_t position[3]; // 32.32 fixed point steps of each tower
+            uint8_t waypoint;    // the waypoint it is heading from
+        } kin;
+
+        // input shaping, the steps the block generates for a shaped motor go into shaped_step and are issued by its shaper
+        std::array<InputShaper*, k_max_actuators> shaper;
+        std::array<uint8_t, k_max_actuators> shaped_motors;
+        std::array<int8_t, k_max_actuators> shaped_step;
+        uint8_t n_shaped;
+        volatile bool shapers_busy;
 
         struct {
             volatile bool running:1;
             uint8_t num_motors:4;
+            bool event_driven:1;
         };
 };
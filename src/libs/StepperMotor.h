@@ -19,7 +19,11 @@ class StepperMotor  : public Module {
         uint8_t get_motor_id() const { return motor_id; }
 
         // called from step ticker ISR
-        inline bool step() { step_pin.set(1); current_position_steps += (direction?-1:1); return moving; }
+        inline bool step() { step_pin.set(1); return count_step(); }
+        // called from step ticker ISR when it sets the step pins itself, one write per GPIO port
+        inline bool count_step() { current_position_steps += (direction?-1:1); return moving; }
+        // same for a tick that gives the motor n step pulses, see StepTicker::set_multi_step()
+        inline bool count_steps(uint8_t n) { current_position_steps += (direction?-n:n); return moving; }
         // called from unstep ISR
         inline void unstep() { step_pin.set(0); }
         // called from step ticker ISR
@@ -34,6 +38,7 @@ class StepperMotor  : public Module {
         void manual_step(bool dir);
 
         bool which_direction() const { return direction; }
+        Pin get_step_pin() const { return step_pin; }
 
         float get_steps_per_second()  const { return steps_per_second; }
         float get_steps_per_mm()  const { return steps_per_mm; }
@@ -28,6 +28,10 @@ class StreamOutput {
         virtual int _getc(void) { return -1; }
         virtual int puts(const char* str) = 0;
         virtual bool ready() { return true; };
+        // how many more characters the receive buffer of this stream has room for, -1 if it does not have one
+        virtual int get_rx_free() { return -1; }
+        // switches what is received to the binary motion protocol and back, false if this stream does not do it
+        virtual bool set_binary_mode(bool on) { return false; }
 
         static NullStreamOutput NullStream;
 };
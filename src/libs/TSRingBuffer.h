@@ -35,6 +35,11 @@ public:
         return (next(m_wIndex) == m_rIndex);
     }
 
+    size_t free() const
+    {
+        return (m_rIndex + m_size - m_wIndex - 1) % m_size;
+    }
+
     bool put(const T &value)
     {
         if (full())
@@ -22,8 +22,10 @@
 #include "USBSerial.h"
 
 #include "libs/Kernel.h"
+#include "Robot.h"
 #include "libs/SerialMessage.h"
 #include "StreamOutputPool.h"
+#include "BinaryMotion.h"
 #include "utils.h"
 
 #include "mbed.h"
@@ -33,7 +35,7 @@
 
 #define iprintf(...) do { } while (0)
 
-USBSerial::USBSerial(USB *u): USBCDC(u), rxbuf(256), txbuf(128 + 8)
+USBSerial::USBSerial(USB *u): USBCDC(u), rxbuf(512), txbuf(128 + 8)
 {
     usb = u;
     nl_in_rx = 0;
@@ -42,6 +44,10 @@ USBSerial::USBSerial(USB *u): USBCDC(u), rxbuf(256), txbuf(128 + 8)
     halt_flag = false;
     query_flag = false;
     last_char_was_cr = false;
+    feed_override_command = 0;
+    binary_mode = false;
+    binary_left = 0;
+    binary = nullptr;
 }
 
 bool USBSerial::ensure_tx_space(int space)
@@ -83,7 +89,7 @@ int USBSerial::_getc()
     if (rxbuf.free() == MAX_PACKET_SIZE_EPBULK) {
         usb->endpointSetInterrupt(CDC_BulkOut.bEndpointAddress, true);
         iprintf("rxbuf has room for another packet, interrupt enabled\n");
-    } else if ((rxbuf.free() < MAX_PACKET_SIZE_EPBULK) && (nl_in_rx == 0)) {
+    } else if ((rxbuf.free() < MAX_PACKET_SIZE_EPBULK) && (nl_in_rx == 0) && !binary_mode) {
         // handle potential deadlock where a short line, and the beginning of a very long line are bundled in one usb packet
         rxbuf.flush();
         flush_to_nl = true;
@@ -195,6 +201,22 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
     for (uint8_t i = 0; i < size; i++) {
         char b= c[i];
 
+        if(binary_mode) {
+            // frames go into the buffer as they are, only the bytes between them can be realtime characters
+            if(binary_left > 0 || b == (char)BinaryMotion::k_sync) {
+                if(binary_left == 0) {
+                    binary_left= 0xFFFF; // the len is next
+                } else if(binary_left == 0xFFFF) {
+                    binary_left= (b == 0 || (uint8_t)b > BinaryMotion::k_max_payload) ? 0 : BinaryMotion::frame_left(b);
+                } else {
+                    --binary_left;
+                }
+                rxbuf.queue(b);
+                continue;
+            }
+            if(b == 0x08 || b == 0x7F) continue;
+        }
+
         // handle backspace and delete by deleting the last character in the buffer if there is one
         if(b == 0x08 || b == 0x7F) {
             if(!rxbuf.isEmpty()) rxbuf.pop();
@@ -217,6 +239,11 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
             continue;
         }
 
+        if(THEKERNEL->is_grbl_mode() && (uint8_t)b >= 0x90 && (uint8_t)b <= 0x94) { // realtime feed override
+            feed_override_command = b;
+            continue;
+        }
+
         if(THEKERNEL->is_feed_hold_enabled()) {
             if(b == '!') { // safe pause
                 THEKERNEL->set_feed_hold(true);
@@ -229,6 +256,9 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
             }
         }
 
+        // anything else between frames is dropped
+        if(binary_mode) continue;
+
         if(b == '\n' && last_char_was_cr) {
             // handle \r\n as single line terminator
             last_char_was_cr= false;
@@ -267,7 +297,7 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
         // if buffer is full, stall endpoint, do not accept more data
         r = false;
 
-        if (nl_in_rx == 0) {
+        if (nl_in_rx == 0 && !binary_mode) {
             // we have to check for long line deadlock here too
             flush_to_nl = true;
             rxbuf.flush();
@@ -282,7 +312,7 @@ bool USBSerial::USBEvent_EPOut(uint8_t bEP, uint8_t bEPStatus)
     return r;
 }
 
-uint8_t USBSerial::available()
+uint16_t USBSerial::available()
 {
     return rxbuf.available();
 }
@@ -296,6 +326,19 @@ void USBSerial::on_module_loaded()
 {
     this->register_for_event(ON_MAIN_LOOP);
     this->register_for_event(ON_IDLE);
+    this->register_for_event(ON_HALT);
+}
+
+// whatever halted, an error in a frame, an M112 in a text record or the kill button, the stream goes back to text and
+// the host has to send M800 again, the frames it had in flight are dropped
+void USBSerial::on_halt(void *argument)
+{
+    if(argument == nullptr && binary_mode) {
+        binary_mode = false;
+        binary_left = 0;
+        rxbuf.flush();
+        nl_in_rx = 0;
+    }
 }
 
 void USBSerial::on_idle(void *argument)
@@ -314,7 +357,12 @@ void USBSerial::on_idle(void *argument)
 
     if(query_flag) {
         query_flag = false;
-        puts(THEKERNEL->get_query_string().c_str());
+        puts(THEKERNEL->get_query_string(this).c_str());
+    }
+
+    if(feed_override_command != 0) {
+        THEKERNEL->feed_override_command(feed_override_command);
+        feed_override_command = 0;
     }
 }
 
@@ -340,13 +388,26 @@ void USBSerial::on_main_loop(void *argument)
             txbuf.flush();
             rxbuf.flush();
             nl_in_rx = 0;
+            binary_mode = false;
+        }
+    }
+
+    if (binary_mode) {
+        // a frame is taken in when the Robot has room for more moves, one frame each time round like a line
+        if (!THEROBOT->is_move_queue_full()) {
+            while (available()) {
+                if (binary->receive(_getc(), this)) break;
+            }
+            if (binary->is_ended()) binary_mode = false;
         }
+        return;
     }
 
     // if we are in feed hold we do not process anything
     //if(THEKERNEL->get_feed_hold()) return;
 
-    if (nl_in_rx) {
+    // the line stays in the buffer until the Robot has room for another move
+    if (nl_in_rx && !THEROBOT->is_move_queue_full()) {
         string received;
         while (available()) {
             int c = _getc();
@@ -365,6 +426,18 @@ void USBSerial::on_main_loop(void *argument)
     }
 }
 
+// the received bytes are frames from after the ok of the M800 until a frame with the end record in it
+bool USBSerial::set_binary_mode(bool on)
+{
+    if (on) {
+        if (binary == nullptr) binary = new BinaryMotion();
+        binary->reset();
+        binary_left = 0;
+    }
+    binary_mode = on;
+    return true;
+}
+
 void USBSerial::on_attach()
 {
     attach = true;
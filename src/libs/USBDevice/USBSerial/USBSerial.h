@@ -26,6 +26,8 @@
 #include "Module.h"
 #include "StreamOutput.h"
 
+class BinaryMotion;
+
 class USBSerial_Receiver {
 protected:
     virtual bool SerialEvent_RX(void) = 0;
@@ -39,8 +41,10 @@ public:
     int _getc();
     int puts(const char *);
 
-    uint8_t available();
+    uint16_t available();
     bool ready();
+    int get_rx_free() { return rxbuf.free(); }
+    bool set_binary_mode(bool on);
 
     uint16_t writeBlock(const uint8_t * buf, uint16_t size);
 
@@ -50,6 +54,7 @@ public:
     void on_module_loaded(void);
     void on_main_loop(void *);
     void on_idle(void *);
+    void on_halt(void *);
 
 protected:
 //     virtual bool EpCallback(uint8_t, uint8_t);
@@ -66,6 +71,11 @@ protected:
     // keep track of number of newlines in the buffer
     // this makes it trivial to detect if there's a new line available
     volatile int nl_in_rx;
+    volatile uint8_t feed_override_command;
+
+    // in binary mode the bytes of the frame that are still to come, 0 between frames, see BinaryMotion
+    uint16_t binary_left;
+    BinaryMotion *binary;
 
 
     volatile struct {
@@ -80,6 +90,7 @@ protected:
         // flushing until we find a newline.
         // this flag asserts when we are doing this
         bool flush_to_nl:1;
+        bool binary_mode:1;
     };
 
 private:
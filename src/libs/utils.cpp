@@ -149,8 +149,8 @@ bool file_exists( const string file_name )
     FILE *lp = fopen(file_name.c_str(), "r");
     if(lp) {
         exists = true;
+        fclose(lp);
     }
-    fclose(lp);
     return exists;
 }
 
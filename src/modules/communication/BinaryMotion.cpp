@@ -0,0 +1,230 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "BinaryMotion.h"
+
+#include "libs/Kernel.h"
+#include "utils/Gcode.h"
+#include "libs/SerialMessage.h"
+#include "libs/StreamOutput.h"
+
+#include <string.h>
+
+#define MOVE_RECORD 0x01
+#define TEXT_RECORD 0x02
+#define END_RECORD  0x03
+
+#define MOVE_F    0x10
+#define MOVE_S    0x20
+#define MOVE_WIDE 0x40
+#define MOVE_G0   0x80
+
+BinaryMotion::BinaryMotion()
+{
+    reset();
+}
+
+// ready for the first frame after an M800
+void BinaryMotion::reset()
+{
+    got= 0;
+    next_seq= 0;
+    memset(last, 0, sizeof(last));
+    in_frame= false;
+    resending= false;
+    ended= false;
+}
+
+bool BinaryMotion::receive(uint8_t c, StreamOutput *stream)
+{
+    if(!in_frame) {
+        // anything between frames is dropped, after a bad frame this finds the start of the next one
+        if(c == k_sync) {
+            in_frame= true;
+            got= 0;
+        }
+        return false;
+    }
+
+    if(got == 0 && (c == 0 || c > k_max_payload)) {
+        // not a len so that was not the start of a frame
+        in_frame= (c == k_sync);
+        return false;
+    }
+
+    frame[got++]= c;
+    if(got < 1 + frame_left(frame[0])) return false;
+
+    in_frame= false;
+    handle_frame(stream);
+    return true;
+}
+
+void BinaryMotion::handle_frame(StreamOutput *stream)
+{
+    uint8_t len= frame[0];
+    uint8_t seq= frame[1];
+    uint16_t crc= frame[len + 2] | (frame[len + 3] << 8);
+
+    if(crc16(frame, len + 2) != crc) {
+        // only asked for once, the frames after it are dropped until it comes again
+        if(!resending) {
+            resending= true;
+            stream->printf("rs %u\n", next_seq);
+        }
+        return;
+    }
+
+    if(seq != next_seq) {
+        // one that was sent again after it was handled is dropped, one after a frame that went missing needs a resend
+        if((uint8_t)(seq - next_seq) < 128 && !resending) {
+            resending= true;
+            stream->printf("rs %u\n", next_seq);
+        }
+        return;
+    }
+
+    resending= false;
+    ++next_seq;
+    if(execute(frame + 2, frame + 2 + len, stream)) {
+        stream->printf("ack %u\n", seq);
+    }
+}
+
+// we cannot continue safely after an error in a frame so we enter HALT state, which also ends binary mode
+static bool halt(StreamOutput *stream)
+{
+    stream->printf("Entering Alarm/Halt state\n");
+    THEKERNEL->call_event(ON_HALT, nullptr);
+    return false;
+}
+
+// handles the records in the payload, returns false if it stopped at an error
+bool BinaryMotion::execute(const uint8_t *p, const uint8_t *end, StreamOutput *stream)
+{
+    bool halt_reported= false;
+
+    while(p < end) {
+        switch(*p++) {
+            case MOVE_RECORD: {
+                Gcode gcode(1, stream);
+                p= read_move(p, end, gcode);
+                if(p == nullptr) {
+                    stream->printf("error:bad move record\n");
+                    return halt(stream);
+                }
+
+                // as GcodeDispatch does for a line while halted
+                if(THEKERNEL->is_halted()) {
+                    if(!halt_reported) stream->printf("!!\n");
+                    halt_reported= true;
+                    continue;
+                }
+
+                THEKERNEL->call_event(ON_GCODE_RECEIVED, &gcode);
+
+                if(gcode.is_error) {
+                    stream->printf(THEKERNEL->is_grbl_mode() ? "error:" : "Error: ");
+                    stream->printf("%s\n", gcode.txt_after_ok.empty() ? "unknown" : gcode.txt_after_ok.c_str());
+                    return halt(stream);
+                }
+                break;
+            }
+
+            case TEXT_RECORD: {
+                if(p >= end || end - p - 1 < *p) {
+                    stream->printf("error:bad text record\n");
+                    return halt(stream);
+                }
+                uint8_t n= *p++;
+                struct SerialMessage message;
+                message.message.assign((const char *)p, n);
+                message.stream= stream;
+                p += n;
+                THEKERNEL->call_event(ON_CONSOLE_LINE_RECEIVED, &message);
+                break;
+            }
+
+            case END_RECORD:
+                ended= true;
+                break;
+
+            default:
+                stream->printf("error:unknown record %02X\n", p[-1]);
+                return halt(stream);
+        }
+    }
+
+    return true;
+}
+
+static inline int16_t read_i16(const uint8_t *p)
+{
+    return (int16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline float read_float(const uint8_t *p)
+{
+    uint32_t u= read_u32(p);
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+const uint8_t *BinaryMotion::read_move(const uint8_t *p, const uint8_t *end, Gcode &gcode)
+{
+    if(p >= end) return nullptr;
+    uint8_t flags= *p++;
+    gcode.g= (flags & MOVE_G0) ? 0 : 1;
+
+    for (int i = 0; i < 4; ++i) {
+        if((flags & (1 << i)) == 0) continue;
+
+        if(flags & MOVE_WIDE) {
+            if(end - p < 4) return nullptr;
+            last[i]= (int32_t)read_u32(p);
+            p += 4;
+        } else {
+            if(end - p < 2) return nullptr;
+            last[i] += read_i16(p);
+            p += 2;
+        }
+
+        // divided in double so it is the nearest float to the decimal, the same as strtof gets from the text
+        gcode.set_value("XYZE"[i], (float)(last[i] / (i == 3 ? 100000.0 : 1000.0)));
+    }
+
+    if(flags & MOVE_F) {
+        if(end - p < 4) return nullptr;
+        gcode.set_value('F', read_float(p));
+        p += 4;
+    }
+
+    if(flags & MOVE_S) {
+        if(end - p < 4) return nullptr;
+        gcode.set_value('S', read_float(p));
+        p += 4;
+    }
+
+    return p;
+}
+
+uint16_t BinaryMotion::crc16(const uint8_t *p, size_t n, uint16_t crc)
+{
+    while(n-- > 0) {
+        crc ^= (uint16_t)*p++ << 8;
+        for (int i = 0; i < 8; ++i) {
+            crc= (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,68 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class StreamOutput;
+class Gcode;
+
+/*
+    The binary motion protocol, a stream is switched to it with M800 and back with an end record or a halt, see fast-stream.py -b
+
+    frame:  0xA5 len seq payload[len] crc
+        len is 1-250, seq counts up from 0 after the M800, crc is CRC-16/CCITT (0x1021 from 0xFFFF) of len seq and the
+        payload, low byte first.
+    the payload is one or more records, all values are little endian:
+        0x01 move:  flags, then a value for each of X Y Z E that is in the flags, then F and S as floats if they are in it
+                    flags: bit 0-3 X Y Z E, bit 4 F, bit 5 S, bit 6 the values are int32 not int16 deltas, bit 7 G0 not G1
+                    XYZ are in thousandths of the units and E in hundred thousandths, an int16 is the change from the last
+                    value of that letter
+        0x02 text:  len, then a line of gcode that is handled as if it came in as text, its replies go to the stream
+        0x03 end:   back to text after this frame
+    replies:
+        ack seq    the frame has been handled, the moves in it are queued
+        rs seq     resend from seq, the frames after a bad one are dropped until it comes again
+
+    A move is the same G0/G1 a line with those words would have been, it is not parsed, the words are set in the Gcode.
+*/
+class BinaryMotion {
+    public:
+        BinaryMotion();
+
+        static const uint8_t k_sync= 0xA5;
+        static const uint8_t k_max_payload= 250;
+        // the bytes after the len
+        static size_t frame_left(uint8_t len) { return len + 3; }
+
+        void reset();
+        // takes the next byte from the stream, returns true when it has handled a frame
+        bool receive(uint8_t c, StreamOutput *stream);
+        bool is_ended() const { return ended; }
+
+        // reads a move record into the gcode, returns where the next record is or nullptr if it is cut short
+        const uint8_t *read_move(const uint8_t *p, const uint8_t *end, Gcode &gcode);
+
+        static uint16_t crc16(const uint8_t *p, size_t n, uint16_t crc= 0xFFFF);
+
+    private:
+        void handle_frame(StreamOutput *stream);
+        bool execute(const uint8_t *p, const uint8_t *end, StreamOutput *stream);
+
+        uint8_t frame[k_max_payload + 4];   // len seq payload crc
+        uint16_t got;
+        uint8_t next_seq;
+        int32_t last[4];                    // the last X Y Z E value, the int16 deltas are from these
+
+        struct {
+            bool in_frame:1;
+            bool resending:1;
+            bool ended:1;
+        };
+};
@@ -27,6 +27,9 @@
 #include "LPC17xx.h"
 #include "version.h"
 
+#include <string.h>
+#include <algorithm>
+
 #define panel_display_message_checksum CHECKSUM("display_message")
 #define panel_checksum             CHECKSUM("panel")
 
@@ -39,6 +42,49 @@ static bool is_allowed_mcode(int m) {
     return false;
 }
 
+// A view of part of the received line, the line is split into its commands without copying any of it
+struct line_view_t {
+    const char *s;
+    size_t n;
+
+    bool empty() const { return n == 0; }
+    char operator[](size_t i) const { return s[i]; }
+    string str() const { return string(s, n); }
+    bool starts_with(const char *p) const { return n >= strlen(p) && strncmp(s, p, strlen(p)) == 0; }
+
+    line_view_t substr(size_t pos, size_t len= string::npos) const
+    {
+        if(pos > n) pos= n;
+        return {s + pos, std::min(len, n - pos)};
+    }
+
+    size_t find_first_of(const char *chars, size_t pos= 0) const
+    {
+        for (size_t i = pos; i < n; ++i) {
+            if(strchr(chars, s[i]) != nullptr) return i;
+        }
+        return string::npos;
+    }
+
+    size_t find_first_not_of(const char *chars, size_t pos= 0) const
+    {
+        for (size_t i = pos; i < n; ++i) {
+            if(strchr(chars, s[i]) == nullptr) return i;
+        }
+        return string::npos;
+    }
+};
+
+// the ok for a line, with the free blocks and receive buffer space if report_buffer_space is set
+static void send_ok(StreamOutput *stream)
+{
+    if(THEKERNEL->is_report_buffer_space()) {
+        stream->printf("ok Bf:%u,%d\n", THECONVEYOR->get_free_blocks(), stream->get_rx_free());
+    } else {
+        stream->printf("ok\n");
+    }
+}
+
 GcodeDispatch::GcodeDispatch()
 {
     uploading = false;
@@ -53,24 +99,26 @@ void GcodeDispatch::on_module_loaded()
 }
 
 // When a command is received, if it is a Gcode, dispatch it as an object via an event
+// The line is worked on in place in the message, which the caller keeps until this returns, a G1 line does not allocate
 void GcodeDispatch::on_console_line_received(void *line)
 {
-    SerialMessage new_message = *static_cast<SerialMessage *>(line);
-    string possible_command = new_message.message;
+    SerialMessage &new_message = *static_cast<SerialMessage *>(line);
+    line_view_t possible_command= {new_message.message.data(), new_message.message.size()};
+    string pycam_command; // only used for a line of pycam syntax
 
     int ln = 0;
     int cs = 0;
 
     // just reply ok to empty lines
     if(possible_command.empty()) {
-        new_message.stream->printf("ok\n");
+        send_ok(new_message.stream);
         return;
     }
 
 try_again:
 
     char first_char = possible_command[0];
-    unsigned int n;
+    size_t n;
 
     if(first_char == '$') {
         // ignore as simpleshell will handle it
@@ -85,7 +133,7 @@ try_again:
 
         //Get linenumber
         if ( first_char == 'N' ) {
-            Gcode full_line = Gcode(possible_command, new_message.stream, false);
+            Gcode full_line(possible_command.s, possible_command.n, new_message.stream, false);
             ln = (int) full_line.get_int('N');
             int chksum = (int) full_line.get_int('*');
 
@@ -93,7 +141,7 @@ try_again:
             if ( full_line.has_m ) {
                 if ( full_line.m == 110 ) {
                     currentline = ln;
-                    new_message.stream->printf("ok\n");
+                    send_ok(new_message.stream);
                     return;
                 }
             }
@@ -104,8 +152,8 @@ try_again:
 			//Calculate checksum
             if ( chkpos != string::npos ) {
 				possible_command = possible_command.substr(0, chkpos);
-                for (auto c = possible_command.cbegin(); *c != '*' && c != possible_command.cend(); c++)
-                    cs = cs ^ *c;
+                for (size_t i = 0; i < possible_command.n; i++)
+                    cs = cs ^ possible_command[i];
                 cs &= 0xff;  // Defensive programming...
                 cs -= chksum;
 			}
@@ -116,7 +164,7 @@ try_again:
 				possible_command = possible_command.substr(lnsize);
 			}else{
 				// it is a blank line
-				possible_command.clear();
+				possible_command.n= 0;
 			}
 
         } else {
@@ -139,21 +187,21 @@ try_again:
             }
 
             bool sent_ok= false; // used for G1 optimization
-            while(possible_command.size() > 0) {
+            while(!possible_command.empty()) {
                 if(!uploading || upload_stream != new_message.stream) {
                     // assumes G or M are always the first on the line
                     size_t nextcmd = possible_command.find_first_of("GM", 2);
-                    string single_command;
+                    line_view_t single_command;
                     if(nextcmd == string::npos) {
                         single_command = possible_command;
-                        possible_command = "";
+                        possible_command.n= 0;
                     } else {
                         single_command = possible_command.substr(0, nextcmd);
                         possible_command = possible_command.substr(nextcmd);
                     }
 
                     // Prepare gcode for dispatch
-                    Gcode *gcode = new Gcode(single_command, new_message.stream);
+                    Gcode *gcode = new Gcode(single_command.s, single_command.n, new_message.stream);
 
                     if(THEKERNEL->is_halted()) {
                         // we ignore all commands until M999, unless it is in the exceptions list (like M105 get temp)
@@ -162,7 +210,7 @@ try_again:
                                 THEKERNEL->call_event(ON_HALT, (void *)1); // clears on_halt
                                 new_message.stream->printf("WARNING: After HALT you should HOME as position is currently unknown\n");
                             }
-                            new_message.stream->printf("ok\n");
+                            send_ok(new_message.stream);
                             delete gcode;
                             return;
 
@@ -197,8 +245,8 @@ try_again:
                             }else{
                                 delete gcode;
                                 // extract next G0/G1 from the rest of the line, ignore if it is not one of these
-                                gcode = new Gcode(possible_command, new_message.stream);
-                                possible_command= "";
+                                gcode = new Gcode(possible_command.s, possible_command.n, new_message.stream);
+                                possible_command.n= 0;
                                 if(!gcode->has_g || gcode->g > 1) {
                                     // not G0 or G1 so ignore it as it is invalid
                                     delete gcode;
@@ -213,7 +261,7 @@ try_again:
                             // optimize G1 to send ok immediately (one per line) before it is planned
                             if(!sent_ok) {
                                 sent_ok= true;
-                                new_message.stream->printf("ok\n");
+                                send_ok(new_message.stream);
                             }
                         }
 
@@ -228,7 +276,7 @@ try_again:
                             case 28: // start upload command
                                 delete gcode;
 
-                                this->upload_filename = "/sd/" + single_command.substr(4); // rest of line is filename
+                                this->upload_filename = "/sd/" + single_command.substr(4).str(); // rest of line is filename
                                 // open file
                                 upload_fd = fopen(this->upload_filename.c_str(), "w");
                                 if(upload_fd != NULL) {
@@ -269,7 +317,7 @@ try_again:
                             case 115: { // M115 Get firmware version and capabilities
                                 Version vers;
 
-                                new_message.stream->printf("FIRMWARE_NAME:Smoothieware, FIRMWARE_URL:http%%3A//smoothieware.org, X-SOURCE_CODE_URL:https://github.com/Smoothieware/Smoothieware, FIRMWARE_VERSION:%s, X-FIRMWARE_BUILD_DATE:%s, X-SYSTEM_CLOCK:%ldMHz, X-AXES:%d, X-GRBL_MODE:%d", vers.get_build(), vers.get_build_date(), SystemCoreClock / 1000000, MAX_ROBOT_ACTUATORS, THEKERNEL->is_grbl_mode());
+                                new_message.stream->printf("FIRMWARE_NAME:Smoothieware, FIRMWARE_URL:http%%3A//smoothieware.org, X-SOURCE_CODE_URL:https://github.com/Smoothieware/Smoothieware, FIRMWARE_VERSION:%s, X-FIRMWARE_BUILD_DATE:%s, X-SYSTEM_CLOCK:%ldMHz, X-AXES:%d, X-GRBL_MODE:%d", vers.get_build(), vers.get_build_date(), (long)(SystemCoreClock / 1000000), MAX_ROBOT_ACTUATORS, THEKERNEL->is_grbl_mode());
 
                                 #ifdef CNC
                                 new_message.stream->printf(", X-CNC:1");
@@ -292,17 +340,27 @@ try_again:
 
                             case 117: // M117 is a special non compliant Gcode as it allows arbitrary text on the line following the command
                             {    // concatenate the command again and send to panel if enabled
-                                string str= single_command.substr(4) + possible_command;
+                                string str= single_command.substr(4).str() + possible_command.str();
                                 PublicData::set_value( panel_checksum, panel_display_message_checksum, &str );
                                 delete gcode;
-                                new_message.stream->printf("ok\n");
+                                send_ok(new_message.stream);
                                 return;
                             }
 
+                            case 800: // M800 switch this stream to the binary motion protocol, see BinaryMotion.h
+                                delete gcode;
+                                if(new_message.stream->set_binary_mode(true)) {
+                                    // the host waits for this before it sends the first frame
+                                    new_message.stream->printf("ok binary 1\n");
+                                } else {
+                                    new_message.stream->printf("error:binary motion is not supported on this stream\n");
+                                }
+                                return;
+
                             case 1000: // M1000 is a special command that will pass thru the raw lowercased command to the simpleshell (for hosts that do not allow such things)
                             {
                                 // reconstruct entire command line again
-                                string str= single_command.substr(5) + possible_command;
+                                string str= single_command.substr(5).str() + possible_command.str();
                                 while(is_whitespace(str.front())){ str= str.substr(1); } // strip leading whitespace
 
                                 delete gcode;
@@ -319,7 +377,7 @@ try_again:
                                     }
                                 }
 
-                                new_message.stream->printf("ok\n");
+                                send_ok(new_message.stream);
                                 return;
                             }
 
@@ -345,14 +403,14 @@ try_again:
                             case 501: // load config override
                             case 504: // save to specific config override file
                                 {
-                                    string arg= get_arguments(single_command + possible_command); // rest of line is filename
+                                    string arg= get_arguments(single_command.str() + possible_command.str()); // rest of line is filename
                                     if(arg.empty()) arg= "/sd/config-override";
                                     else arg= "/sd/config-override." + arg;
                                     //new_message.stream->printf("args: <%s>\n", arg.c_str());
                                     SimpleShell::parse_command((gcode->m == 501) ? "load_command" : "save_command", arg, new_message.stream);
                                 }
                                 delete gcode;
-                                new_message.stream->printf("ok\n");
+                                send_ok(new_message.stream);
                                 return;
 
                             case 502: // M502 deletes config-override so everything defaults to what is in config
@@ -414,10 +472,10 @@ try_again:
                             if(THEKERNEL->is_ok_per_line() || THEKERNEL->is_grbl_mode()) {
                                 // only send ok once per line if this is a multi g code line send ok on the last one
                                 if(possible_command.empty())
-                                    new_message.stream->printf("ok\n");
+                                    send_ok(new_message.stream);
                             } else {
                                 // maybe should do the above for all hosts?
-                                new_message.stream->printf("ok\n");
+                                send_ok(new_message.stream);
                             }
                         }
                     }
@@ -426,7 +484,7 @@ try_again:
 
                 } else {
                     // we are uploading and it is the upload stream so so save it
-                    if(possible_command.substr(0, 3) == "M29") {
+                    if(possible_command.starts_with("M29")) {
                         // done uploading, close file
                         fclose(upload_fd);
                         upload_fd = NULL;
@@ -439,19 +497,18 @@ try_again:
 
                     if(upload_fd == NULL) {
                         // error detected writing to file so discard everything until it stops
-                        new_message.stream->printf("ok\n");
+                        send_ok(new_message.stream);
                         break;
                     }
 
-                    possible_command.append("\n");
-                    if(fwrite(possible_command.c_str(), 1, possible_command.size(), upload_fd) != possible_command.size()) {
+                    if(fwrite(possible_command.s, 1, possible_command.n, upload_fd) != possible_command.n || fputc('\n', upload_fd) == EOF) {
                         // error writing to file
                         new_message.stream->printf("Error:error writing to file.\n");
                         fclose(upload_fd);
                         upload_fd = NULL;
 
                     } else {
-                         new_message.stream->printf("ok\n");
+                         send_ok(new_message.stream);
                         //printf("uploading file write ok\n");
                     }
                     break;
@@ -465,7 +522,7 @@ try_again:
 
     } else if ( first_char == ';' || first_char == '(' || first_char == '\n' || first_char == '\r' ) {
         // Ignore comments and blank lines
-        new_message.stream->printf("ok\n");
+        send_ok(new_message.stream);
 
     } else if( (n=possible_command.find_first_of("XYZF")) == 0 || (first_char == ' ' && n != string::npos) ) {
         // handle pycam syntax, use last modal group 1 command and resubmit if an X Y Z or F is found on its own line
@@ -477,7 +534,8 @@ try_again:
             // use last modal command (G1 or G0 etc)
             snprintf(buf, sizeof(buf), "G%d ", modal_group_1);
         }
-        possible_command.insert(0, buf);
+        pycam_command= buf + possible_command.str();
+        possible_command= {pycam_command.data(), pycam_command.size()};
         goto try_again;
 
 
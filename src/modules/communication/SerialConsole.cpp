@@ -9,6 +9,7 @@
 
 #include "libs/Module.h"
 #include "libs/Kernel.h"
+#include "Robot.h"
 #include "libs/nuts_bolts.h"
 #include "libs/SerialMessage.h"
 #include "libs/StreamOutput.h"
@@ -184,6 +185,7 @@ void SerialConsole::on_module_loaded()
 
     query_flag = false;
     halt_flag = false;
+    feed_override_command = 0;
     lf_count = 0;
     last_char_was_cr = false;
 
@@ -210,6 +212,10 @@ void SerialConsole::on_serial_char_received(char received)
         THEKERNEL->set_stop_request(true); // generic stop what you are doing request
         return;
     }
+    if(THEKERNEL->is_grbl_mode() && (uint8_t)received >= 0x90 && (uint8_t)received <= 0x94) { // realtime feed override
+        feed_override_command = received;
+        return;
+    }
     if(received == '\n' && last_char_was_cr) {
         // ignore the \n of a \r\n pair
         last_char_was_cr = false;
@@ -226,9 +232,13 @@ void SerialConsole::on_serial_char_received(char received)
 
 void SerialConsole::on_idle(void * argument)
 {
+    if(feed_override_command != 0) {
+        THEKERNEL->feed_override_command(feed_override_command);
+        feed_override_command = 0;
+    }
     if(query_flag) {
         query_flag = false;
-        puts(THEKERNEL->get_query_string().c_str());
+        puts(THEKERNEL->get_query_string(this).c_str());
     }
     if(halt_flag) {
         halt_flag = false;
@@ -244,7 +254,8 @@ void SerialConsole::on_idle(void * argument)
 // Actual event calling must happen in the main loop because if it happens in the interrupt we will loose data
 void SerialConsole::on_main_loop(void * argument)
 {
-    if(lf_count > 0) {
+    // the line stays in the buffer until the Robot has room for another move
+    if(lf_count > 0 && !THEROBOT->is_move_queue_full()) {
         string received;
         received.reserve(20);
         while(1) {
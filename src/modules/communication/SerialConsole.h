@@ -30,16 +30,18 @@ class SerialConsole : public Module, public StreamOutput {
         int _getc(void);
         bool ready();
         int puts(const char*);
+        int get_rx_free() { return buffer.free(); }
 
-        TSRingBuffer<char, 256> buffer;   // Receive buffer
+        TSRingBuffer<char, 512> buffer;   // Receive buffer
 
         struct {
           bool query_flag:1;
           bool halt_flag:1;
           bool last_char_was_cr:1;
           uint8_t uartn:2;
-          uint8_t lf_count:8;
         };
+        volatile uint16_t lf_count;   // the lines in the buffer, every byte of it can be one
+        volatile uint8_t feed_override_command;
 };
 
 #endif
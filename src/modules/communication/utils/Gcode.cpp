@@ -10,13 +10,35 @@
 #include "libs/StreamOutput.h"
 #include "utils.h"
 #include <stdlib.h>
+#include <string.h>
 #include <algorithm>
 
 // This is a gcode object. It represents a GCode string/command, and caches some important values about that command for the sake of performance.
 // It gets passed around in events, and attached to the queue ( that'll change )
+// The words of the command are parsed once when it is made, so looking up the letters does not scan the string again
 Gcode::Gcode(const string &command, StreamOutput *stream, bool strip)
 {
-    this->command= strdup(command.c_str());
+    init(command.data(), command.size(), stream, strip);
+}
+
+// made from part of a line without copying it to a string first
+Gcode::Gcode(const char *command, size_t len, StreamOutput *stream, bool strip)
+{
+    init(command, len, stream, strip);
+}
+
+// a G command made from its words instead of a line, see set_value()
+Gcode::Gcode(unsigned int g, StreamOutput *stream)
+{
+    init("", 0, stream, true);
+    this->has_g= true;
+    this->g= g;
+}
+
+void Gcode::init(const char *command, size_t len, StreamOutput *stream, bool strip)
+{
+    this->line= this->line_buf;
+    set_line(command, len);
     this->m= 0;
     this->g= 0;
     this->subcode= 0;
@@ -29,36 +51,32 @@ Gcode::Gcode(const string &command, StreamOutput *stream, bool strip)
 
 Gcode::~Gcode()
 {
-    if(command != nullptr) {
-        // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
-        free(command);
-    }
+    if(line != line_buf) free(line);
 }
 
 Gcode::Gcode(const Gcode &to_copy)
 {
-    this->command               = strdup(to_copy.command); // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
-    this->has_m                 = to_copy.has_m;
-    this->has_g                 = to_copy.has_g;
-    this->m                     = to_copy.m;
-    this->g                     = to_copy.g;
-    this->subcode               = to_copy.subcode;
-    this->add_nl                = to_copy.add_nl;
-    this->is_error              = to_copy.is_error;
-    this->stream                = to_copy.stream;
-    this->txt_after_ok.assign( to_copy.txt_after_ok );
+    this->line= this->line_buf;
+    *this= to_copy;
 }
 
 Gcode &Gcode::operator= (const Gcode &to_copy)
 {
     if( this != &to_copy ) {
-        this->command               = strdup(to_copy.command); // TODO we can reference count this so we share copies, may save more ram than the extra count we need to store
+        set_line(to_copy.line, strlen(to_copy.line));
+        this->command               = this->line + (to_copy.command - to_copy.line);
+        this->letters               = to_copy.letters;
+        this->values                = to_copy.values;
+        memcpy(this->value, to_copy.value, sizeof(this->value));
+        memcpy(this->value_at, to_copy.value_at, sizeof(this->value_at));
+        this->num_args              = to_copy.num_args;
         this->has_m                 = to_copy.has_m;
         this->has_g                 = to_copy.has_g;
         this->m                     = to_copy.m;
         this->g                     = to_copy.g;
         this->subcode               = to_copy.subcode;
         this->add_nl                = to_copy.add_nl;
+        this->stripped              = to_copy.stripped;
         this->is_error              = to_copy.is_error;
         this->stream                = to_copy.stream;
         this->txt_after_ok.assign( to_copy.txt_after_ok );
@@ -66,22 +84,115 @@ Gcode &Gcode::operator= (const Gcode &to_copy)
     return *this;
 }
 
+// keep a copy of the line, in the object if it fits, the command is all of it until it is stripped
+void Gcode::set_line(const char *s, size_t len)
+{
+    char *old= (this->line != this->line_buf) ? this->line : nullptr;
+    if(len < k_line_size) {
+        this->line= this->line_buf;
+    } else {
+        this->line= (char *)malloc(len + 1);
+        ++alloc_stats.long_lines;
+    }
+    memmove(this->line, s, len);
+    this->line[len]= '\0';
+    free(old);
+    this->command= this->line;
+}
 
-// Whether or not a Gcode has a letter
-bool Gcode::has_letter( char letter ) const
+// A Gcode is made with new for each command GcodeDispatch sends, and deleted when it has been handled, so they come
+// from a few fixed slots instead of the heap. More than one is only in use when a command is dispatched while another
+// one is still being handled, say from on_idle while waiting for the queue.
+#define GCODE_POOL_SIZE 4
+
+Gcode::alloc_stats_t Gcode::alloc_stats= {0, 0, 0, 0, GCODE_POOL_SIZE};
+static union gcode_slot_t {
+    gcode_slot_t *next;
+    char mem[sizeof(Gcode)] __attribute__((aligned(8)));
+} gcode_pool[GCODE_POOL_SIZE];
+static gcode_slot_t *gcode_free_slots= nullptr;
+
+void *Gcode::operator new(size_t size)
 {
-    for (size_t i = 0; i < strlen(this->command); ++i) {
-        if( command[i] == letter ) {
-            return true;
+    static bool pool_ready= false;
+    if(!pool_ready) {
+        for (int i = 0; i < GCODE_POOL_SIZE; ++i) {
+            gcode_pool[i].next= gcode_free_slots;
+            gcode_free_slots= &gcode_pool[i];
         }
+        pool_ready= true;
     }
-    return false;
+
+    if(size > sizeof(gcode_slot_t) || gcode_free_slots == nullptr) {
+        ++alloc_stats.from_heap;
+        return ::operator new(size);
+    }
+
+    gcode_slot_t *slot= gcode_free_slots;
+    gcode_free_slots= slot->next;
+    ++alloc_stats.from_pool;
+    ++alloc_stats.pool_used;
+    return slot;
 }
 
-// Retrieve the value for a given letter
-float Gcode::get_value( char letter, char **ptr ) const
+void Gcode::operator delete(void *p)
+{
+    if(p >= (void *)&gcode_pool[0] && p < (void *)&gcode_pool[GCODE_POOL_SIZE]) {
+        gcode_slot_t *slot= (gcode_slot_t *)p;
+        slot->next= gcode_free_slots;
+        gcode_free_slots= slot;
+        --alloc_stats.pool_used;
+    } else {
+        ::operator delete(p);
+    }
+}
+
+Gcode::alloc_stats_t Gcode::get_alloc_stats()
+{
+    return alloc_stats;
+}
+
+// Parse the words of the command in one pass, each letter A-Z is a word, its value is the number straight after it if
+// there is one. The first value of each letter is kept, and where it is so get_int() can read it as an integer.
+// Every letter is looked at, even in the middle of another word, so this finds exactly what scanning the string would
+void Gcode::parse_words()
+{
+    this->letters= 0;
+    this->values= 0;
+    this->num_args= 0;
+    for (const char *cs = command; *cs; cs++) {
+        char c= *cs;
+        if(c < 'A' || c > 'Z') continue;
+
+        uint32_t bit= 1 << (c - 'A');
+        this->letters |= bit;
+        if(c != 'T') ++this->num_args;
+        if(this->values & bit) continue;
+
+        char *cn;
+        float r= strtof(cs + 1, &cn);
+        if(cn > cs + 1) {
+            this->values |= bit;
+            this->value[c - 'A']= r;
+            this->value_at[c - 'A']= cs + 1 - command;
+        }
+    }
+}
+
+// add a word to the table, for a Gcode that was not parsed from a line
+void Gcode::set_value(char letter, float value)
+{
+    uint32_t bit= 1 << (letter - 'A');
+    if((this->letters & bit) == 0 && letter != 'T') ++this->num_args;
+    this->letters |= bit;
+    this->values |= bit;
+    this->value[letter - 'A']= value;
+    this->value_at[letter - 'A']= strlen(command);
+}
+
+// scan the command for the first value of the letter, for the letters that are not in the word table
+static float scan_value(const char *cs, char letter, char **ptr)
 {
-    const char *cs = command;
     char *cn = NULL;
     for (; *cs; cs++) {
         if( letter == *cs ) {
@@ -96,9 +207,8 @@ float Gcode::get_value( char letter, char **ptr ) const
     return 0;
 }
 
-int Gcode::get_int( char letter, char **ptr ) const
+static int scan_int(const char *cs, char letter, char **ptr)
 {
-    const char *cs = command;
     char *cn = NULL;
     for (; *cs; cs++) {
         if( letter == *cs ) {
@@ -113,9 +223,8 @@ int Gcode::get_int( char letter, char **ptr ) const
     return 0;
 }
 
-uint32_t Gcode::get_uint( char letter, char **ptr ) const
+static uint32_t scan_uint(const char *cs, char letter, char **ptr)
 {
-    const char *cs = command;
     char *cn = NULL;
     for (; *cs; cs++) {
         if( letter == *cs ) {
@@ -130,27 +239,61 @@ uint32_t Gcode::get_uint( char letter, char **ptr ) const
     return 0;
 }
 
+static inline bool is_word_letter(char letter) { return letter >= 'A' && letter <= 'Z'; }
+
+// Whether or not a Gcode has a letter
+bool Gcode::has_letter( char letter ) const
+{
+    if(is_word_letter(letter)) return (letters & (1 << (letter - 'A'))) != 0;
+    return letter != 0 && strchr(command, letter) != nullptr;
+}
+
+// Retrieve the value for a given letter
+float Gcode::get_value( char letter, char **ptr ) const
+{
+    if(ptr != nullptr || !is_word_letter(letter)) return scan_value(command, letter, ptr);
+    return (values & (1 << (letter - 'A'))) ? value[letter - 'A'] : 0;
+}
+
+// the integer is read from where the value is, if it is not an integer there (.5 say) the rest of the command is scanned for one
+int Gcode::get_int( char letter, char **ptr ) const
+{
+    if(ptr != nullptr || !is_word_letter(letter)) return scan_int(command, letter, ptr);
+    if((values & (1 << (letter - 'A'))) == 0) return 0;
+
+    const char *cs= command + value_at[letter - 'A'];
+    if(*cs == '\0') return value[letter - 'A']; // from set_value(), there is no text for it
+    char *cn;
+    int r = strtol(cs, &cn, 10);
+    return (cn > cs) ? r : scan_int(command, letter, nullptr);
+}
+
+uint32_t Gcode::get_uint( char letter, char **ptr ) const
+{
+    if(ptr != nullptr || !is_word_letter(letter)) return scan_uint(command, letter, ptr);
+    if((values & (1 << (letter - 'A'))) == 0) return 0;
+
+    const char *cs= command + value_at[letter - 'A'];
+    if(*cs == '\0') return value[letter - 'A'];
+    char *cn;
+    int r = strtoul(cs, &cn, 10);
+    return (cn > cs) ? r : scan_uint(command, letter, nullptr);
+}
+
+// the letters other than T, an unstripped command does not count the first character, that is the G or M
 int Gcode::get_num_args() const
 {
-    int count = 0;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        if( this->command[i] >= 'A' && this->command[i] <= 'Z' ) {
-            if(this->command[i] == 'T') continue;
-            count++;
-        }
-    }
-    return count;
+    char c= command[0];
+    return num_args - ((!stripped && is_word_letter(c) && c != 'T') ? 1 : 0);
 }
 
 std::map<char,float> Gcode::get_args() const
 {
     std::map<char,float> m;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        char c= this->command[i];
-        if( c >= 'A' && c <= 'Z' ) {
-            if(c == 'T') continue;
-            m[c]= get_value(c);
-        }
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        if(c == 'T' || !has_letter(c)) continue;
+        if(!stripped && c == command[0] && strchr(command + 1, c) == nullptr) continue;
+        m[c]= get_value(c);
     }
     return m;
 }
@@ -158,12 +301,10 @@ std::map<char,float> Gcode::get_args() const
 std::map<char,int> Gcode::get_args_int() const
 {
     std::map<char,int> m;
-    for(size_t i = stripped?0:1; i < strlen(command); i++) {
-        char c= this->command[i];
-        if( c >= 'A' && c <= 'Z' ) {
-            if(c == 'T') continue;
-            m[c]= get_int(c);
-        }
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        if(c == 'T' || !has_letter(c)) continue;
+        if(!stripped && c == command[0] && strchr(command + 1, c) == nullptr) continue;
+        m[c]= get_int(c);
     }
     return m;
 }
@@ -172,17 +313,17 @@ std::map<char,int> Gcode::get_args_int() const
 void Gcode::prepare_cached_values(bool strip)
 {
     char *p= nullptr;
-    if( this->has_letter('G') ) {
+    if( strchr(this->command, 'G') != nullptr ) {
         this->has_g = true;
-        this->g = this->get_int('G', &p);
+        this->g = scan_int(this->command, 'G', &p);
 
     } else {
         this->has_g = false;
     }
 
-    if( this->has_letter('M') ) {
+    if( strchr(this->command, 'M') != nullptr ) {
         this->has_m = true;
-        this->m = this->get_int('M', &p);
+        this->m = scan_int(this->command, 'M', &p);
 
     } else {
         this->has_m = false;
@@ -198,14 +339,10 @@ void Gcode::prepare_cached_values(bool strip)
         }
     }
 
-    if(!strip) return;
+    // remove the Gxxx or Mxxx from the command, it just starts after it in the line
+    if (strip && p != nullptr) this->command= p;
 
-    // remove the Gxxx or Mxxx from string
-    if (p != nullptr) {
-        char *n= strdup(p); // create new string starting at end of the numeric value
-        free(command);
-        command= n;
-    }
+    parse_words();
 }
 
 // strip off X Y Z I J K parameters if G0/1/2/3
@@ -234,9 +371,8 @@ void Gcode::strip_parameters()
         // strip whitespace to save even more, this causes problems so don't do it
         //newcmd.erase(std::remove_if(newcmd.begin(), newcmd.end(), ::isspace), newcmd.end());
 
-        // release the old one
-        free(command);
         // copy the new shortened one
-        command= strdup(newcmd.c_str());
+        set_line(newcmd.data(), newcmd.size());
+        parse_words();
     }
 }
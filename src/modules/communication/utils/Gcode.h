@@ -19,6 +19,8 @@ class StreamOutput;
 class Gcode {
     public:
         Gcode(const string&, StreamOutput*, bool strip=true);
+        Gcode(const char *command, size_t len, StreamOutput*, bool strip=true);
+        Gcode(unsigned int g, StreamOutput*);
         Gcode(const Gcode& to_copy);
         Gcode& operator= (const Gcode& to_copy);
         ~Gcode();
@@ -32,6 +34,21 @@ class Gcode {
         std::map<char,float> get_args() const;
         std::map<char,int> get_args_int() const;
         void strip_parameters();
+        void set_value(char letter, float value);
+
+        // new and delete take the Gcode from a small pool, the heap is only used if they are all in use
+        static void *operator new(size_t size);
+        static void operator delete(void *p);
+
+        // counts of where the Gcodes and their lines came from, for the mem command
+        struct alloc_stats_t {
+            uint32_t from_pool;
+            uint32_t from_heap;
+            uint32_t long_lines;
+            uint8_t pool_used;
+            uint8_t pool_size;
+        };
+        static alloc_stats_t get_alloc_stats();
 
         // FIXME these should be private
         unsigned int m;
@@ -50,7 +67,24 @@ class Gcode {
         string txt_after_ok;
 
     private:
+        void init(const char *command, size_t len, StreamOutput *stream, bool strip);
+        void set_line(const char *s, size_t len);
+        void parse_words();
         void prepare_cached_values(bool strip=true);
-        char *command;
+
+        // the line is kept in the object itself unless it is too long
+        static const size_t k_line_size= 64;
+        char *line;
+        char line_buf[k_line_size];
+        char *command; // where the command starts in the line, after the Gxxx or Mxxx if it has been stripped
+
+        // the words of the command, parsed once, see parse_words()
+        uint32_t letters;          // a bit for each of A-Z in the command
+        uint32_t values;           // and for each of those that has a value
+        float value[26];           // the first value of each letter
+        uint16_t value_at[26];     // and where it is in the command
+        uint8_t num_args;
+
+        static alloc_stats_t alloc_stats;
 };
 #endif
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <array>
 
 #ifndef MAX_ROBOT_ACTUATORS
@@ -16,6 +16,9 @@
 #include "Gcode.h"
 #include "libs/StreamOutputPool.h"
 #include "StepTicker.h"
+#include "StepperMotor.h"
+#include "Robot.h"
+#include "arm_solutions/BaseSolution.h"
 #include "platform_memory.h"
 
 #include "mri.h"
@@ -24,9 +27,30 @@
 using std::string;
 
 #define STEP_TICKER_FREQUENCY THEKERNEL->step_ticker->get_frequency()
+// a motor is given more than one step pulse per tick it steps on once it would step on more than this fraction of the ticks
+#define MULTI_STEP_RATE 0.5F
 
 uint8_t Block::n_actuators= 0;
-double Block::fp_scale= 0;
+planner_fp_t Block::fp_scale= 0;
+uint8_t Block::max_multi_step= 1;
+Block::tickinfo_t *Block::tick_info_arena= nullptr;
+Block::tickinfo_block_t *Block::tick_info_block_arena= nullptr;
+Block::tickinfo_cold_t *Block::tick_info_cold_arena= nullptr;
+Block::waypoint_t *Block::waypoint_arena= nullptr;
+Block::cold_t *Block::cold_arena= nullptr;
+Block::path_t *Block::path_arena= nullptr;
+bool Block::has_paths= false;
+void (Block::*Block::prepare_fnc)(float, float, float, float, float, float, float)= &Block::prepare<MAX_ROBOT_ACTUATORS>;
+
+// round to the nearest fixed point value in the precision the tick info is worked out in
+static inline int64_t fp_round(planner_fp_t x)
+{
+#ifdef PLANNER_SINGLE_PRECISION
+    return llroundf(x);
+#else
+    return llround(x);
+#endif
+}
 
 // A block represents a movement, it's length for each stepper motor, and the corresponding acceleration curves.
 // It's stacked on a queue, and that queue is then executed in order, to move the motors.
@@ -36,13 +60,62 @@ double Block::fp_scale= 0;
 Block::Block()
 {
     tick_info= nullptr;
+    tick_info_block= nullptr;
+    tick_info_slot= 0;
+    cold_i= 0;
     clear();
 }
 
-void Block::init(uint8_t n)
+void Block::init(uint8_t n, bool waypoints, bool paths)
 {
     n_actuators= n;
+    has_paths= paths;
+    switch(n) {
+        case 3: prepare_fnc= &Block::prepare<3>; break;
+        #if MAX_ROBOT_ACTUATORS > 3
+        case 4: prepare_fnc= &Block::prepare<4>; break;
+        #endif
+        #if MAX_ROBOT_ACTUATORS > 4
+        case 5: prepare_fnc= &Block::prepare<5>; break;
+        #endif
+        #if MAX_ROBOT_ACTUATORS > 5
+        case 6: prepare_fnc= &Block::prepare<6>; break;
+        #endif
+        default: prepare_fnc= &Block::prepare<MAX_ROBOT_ACTUATORS>; break;
+    }
+#ifdef PLANNER_SINGLE_PRECISION
+    fp_scale= (float)STEPTICKER_FPSCALE / (STEP_TICKER_FREQUENCY * STEP_TICKER_FREQUENCY); // we scale up by fixed point offset first to avoid tiny values
+#else
     fp_scale= (double)STEPTICKER_FPSCALE / pow((double)STEP_TICKER_FREQUENCY, 2.0); // we scale up by fixed point offset first to avoid tiny values
+#endif
+    max_multi_step= THEKERNEL->step_ticker->get_multi_step();
+
+    // the tick info is only needed from when a block is prepared until it has finished executing, that is only ever the
+    // executing block and the next one, so rather than each block having its own they share these slots, see set_tick_info_slot()
+    // the last two are where Conveyor::replan_current_block() works out the rest of the executing block, turn about
+    tick_info_arena= (tickinfo_t *)AHB1.alloc(sizeof(tickinfo_t) * n_actuators * k_tick_info_slots);
+    tick_info_block_arena= (tickinfo_block_t *)AHB1.alloc(sizeof(tickinfo_block_t) * k_tick_info_slots);
+    tick_info_cold_arena= (tickinfo_cold_t *)AHB1.alloc(sizeof(tickinfo_cold_t) * n_actuators * k_tick_info_slots);
+    // the waypoints of a kinematic line are worked out when it is prepared too, see prepare_waypoints()
+    if(waypoints) waypoint_arena= (waypoint_t *)AHB1.alloc(sizeof(waypoint_t) * k_max_waypoints * k_tick_info_slots);
+    if(tick_info_arena == nullptr || tick_info_block_arena == nullptr || tick_info_cold_arena == nullptr || (waypoints && waypoint_arena == nullptr)) {
+        // if we ran out of memory in AHB1 just stop here
+        __debugbreak();
+    }
+}
+
+// the slot is the parity of the index of the block in the queue, so the executing block and the next one never share one
+void Block::set_tick_info_slot(uint8_t slot)
+{
+    tick_info= &tick_info_arena[slot * n_actuators];
+    tick_info_block= &tick_info_block_arena[slot];
+    tick_info_slot= slot;
+}
+
+size_t Block::tick_info_arena_size()
+{
+    return ((sizeof(tickinfo_t) + sizeof(tickinfo_cold_t)) * n_actuators + sizeof(tickinfo_block_t)) * k_tick_info_slots
+           + ((waypoint_arena != nullptr) ? sizeof(waypoint_t) * k_max_waypoints * k_tick_info_slots : 0);
 }
 
 void Block::clear()
@@ -58,67 +131,51 @@ void Block::clear()
     entry_speed         = 0.0F;
     exit_speed          = 0.0F;
     acceleration        = 100.0F; // we don't want to get divide by zeroes if this is not set
-    initial_rate        = 0.0F;
-    accelerate_until    = 0;
-    decelerate_after    = 0;
+    jerk                = 0.0F;
     direction_bits      = 0;
     recalculate_flag    = false;
+    prepared            = false;
     nominal_length_flag = false;
     max_entry_speed     = 0.0F;
     is_ticking          = false;
     is_g123             = false;
     locked              = false;
+    s_curve             = false;
+    feed_override       = false;
+    arc                 = false;
+    kinematic           = false;
     s_value             = 0.0F;
-
-    total_move_ticks= 0;
-    if(tick_info == nullptr) {
-        // we create this once for this block
-        tick_info= new tickinfo_t[n_actuators]; //(tickinfo_t *)malloc(sizeof(tickinfo_t) * n_actuators);
-        if(tick_info == nullptr) {
-            // if we ran out of memory in AHB0 just stop here
-            __debugbreak();
-        }
-    }
-
-    for(int i = 0; i < n_actuators; ++i) {
-        tick_info[i].steps_per_tick= 0;
-        tick_info[i].counter= 0;
-        tick_info[i].acceleration_change= 0;
-        tick_info[i].deceleration_change= 0;
-        tick_info[i].plateau_rate= 0;
-        tick_info[i].steps_to_move= 0;
-        tick_info[i].step_count= 0;
-        tick_info[i].next_accel_event= 0;
-    }
 }
 
 void Block::debug() const
 {
-    THEKERNEL->streams->printf("%p: steps-X:%lu Y:%lu Z:%lu ", this, this->steps[0], this->steps[1], this->steps[2]);
+    // the timing is only worked out once it is prepared, until then it is whatever the slot was last used for
+    tickinfo_block_t tb{};
+    if(this->prepared) tb= *this->tick_info_block;
+    THEKERNEL->streams->printf("%p: steps-X:%lu Y:%lu Z:%lu ", this, (unsigned long)this->steps[0], (unsigned long)this->steps[1], (unsigned long)this->steps[2]);
     for (size_t i = E_AXIS; i < n_actuators; ++i) {
-        THEKERNEL->streams->printf("%c:%lu ", 'A' + i-E_AXIS, this->steps[i]);
+        THEKERNEL->streams->printf("%c:%lu ", (char)('A' + i-E_AXIS), (unsigned long)this->steps[i]);
     }
-    THEKERNEL->streams->printf("(max:%lu) nominal:r%1.4f/s%1.4f mm:%1.4f acc:%1.2f accu:%lu decu:%lu ticks:%lu rates:%1.4f/%1.4f entry/max:%1.4f/%1.4f exit:%1.4f primary:%d ready:%d locked:%d ticking:%d recalc:%d nomlen:%d time:%f\r\n",
-                               this->steps_event_count,
+    THEKERNEL->streams->printf("(max:%lu) nominal:r%1.4f/s%1.4f mm:%1.4f acc:%1.2f accu:%lu decu:%lu ticks:%lu entry/max:%1.4f/%1.4f exit:%1.4f primary:%d ready:%d prepared:%d locked:%d ticking:%d recalc:%d nomlen:%d time:%f\r\n",
+                               (unsigned long)this->steps_event_count,
                                this->nominal_rate,
                                this->nominal_speed,
                                this->millimeters,
                                this->acceleration,
-                               this->accelerate_until,
-                               this->decelerate_after,
-                               this->total_move_ticks,
-                               this->initial_rate,
-                               this->maximum_rate,
+                               (unsigned long)tb.accelerate_until,
+                               (unsigned long)tb.decelerate_after,
+                               (unsigned long)tb.total_move_ticks,
                                this->entry_speed,
                                this->max_entry_speed,
                                this->exit_speed,
                                this->primary_axis,
                                this->is_ready,
+                               this->prepared,
                                this->locked,
                                this->is_ticking,
                                recalculate_flag ? 1 : 0,
                                nominal_length_flag ? 1 : 0,
-                               total_move_ticks/STEP_TICKER_FREQUENCY
+                               tb.total_move_ticks/STEP_TICKER_FREQUENCY
                               );
 }
 
@@ -144,6 +201,11 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     // This is a simplification to get rid of rate_delta and get the steps/s² accel directly from the mm/s² accel
     float acceleration_per_second = (this->acceleration * this->steps_event_count) / this->millimeters;
 
+    if(this->jerk > 0.0F) {
+        calculate_s_curve(initial_rate, final_rate, exitspeed, acceleration_per_second);
+        return;
+    }
+
     float maximum_possible_rate = sqrtf( ( this->steps_event_count * acceleration_per_second ) + ( ( powf(initial_rate, 2) + powf(final_rate, 2) ) / 2.0F ) );
 
     //printf("id %d: acceleration_per_second: %f, maximum_possible_rate: %f steps/sec, %f mm/sec\n", this->id, acceleration_per_second, maximum_possible_rate, maximum_possible_rate/100);
@@ -151,13 +213,14 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     // Now this is the maximum rate we'll achieve this move, either because
     // it's the higher we can achieve, or because it's the higher we are
     // allowed to achieve
-    this->maximum_rate = std::min(maximum_possible_rate, this->nominal_rate);
+    float maximum_rate = std::min(maximum_possible_rate, this->nominal_rate);
 
     // Now figure out how long it takes to accelerate in seconds
-    float time_to_accelerate = ( this->maximum_rate - initial_rate ) / acceleration_per_second;
+    // when the rest of an executing block is replanned the entry speed can be above the nominal speed, then it decelerates to it
+    float time_to_accelerate = fabsf( maximum_rate - initial_rate ) / acceleration_per_second;
 
     // Now figure out how long it takes to decelerate
-    float time_to_decelerate = ( final_rate -  this->maximum_rate ) / -acceleration_per_second;
+    float time_to_decelerate = ( final_rate -  maximum_rate ) / -acceleration_per_second;
 
     // Now we know how long it takes to accelerate and decelerate, but we must
     // also know how long the entire move takes so we can figure out how long
@@ -167,14 +230,14 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     // Only if there is actually a plateau ( we are limited by nominal_rate )
     if(maximum_possible_rate > this->nominal_rate) {
         // Figure out the acceleration and deceleration distances ( in steps )
-        float acceleration_distance = ( ( initial_rate + this->maximum_rate ) / 2.0F ) * time_to_accelerate;
-        float deceleration_distance = ( ( this->maximum_rate + final_rate ) / 2.0F ) * time_to_decelerate;
+        float acceleration_distance = ( ( initial_rate + maximum_rate ) / 2.0F ) * time_to_accelerate;
+        float deceleration_distance = ( ( maximum_rate + final_rate ) / 2.0F ) * time_to_decelerate;
 
         // Figure out the plateau steps
         float plateau_distance = this->steps_event_count - acceleration_distance - deceleration_distance;
 
         // Figure out the plateau time in seconds
-        plateau_time = plateau_distance / this->maximum_rate;
+        plateau_time = plateau_distance / maximum_rate;
     }
 
     // Figure out how long the move takes total ( in seconds )
@@ -201,34 +264,275 @@ void Block::calculate_trapezoid( float entryspeed, float exitspeed )
     float acceleration_time = acceleration_ticks / STEP_TICKER_FREQUENCY;  // This can be moved into the operation below, separated for clarity, note we need to do this instead of using time_to_accelerate(seconds) directly because time_to_accelerate(seconds) and acceleration_ticks(seconds) do not have the same value anymore due to the rounding
     float deceleration_time = deceleration_ticks / STEP_TICKER_FREQUENCY;
 
-    float acceleration_in_steps = (acceleration_time > 0.0F ) ? ( this->maximum_rate - initial_rate ) / acceleration_time : 0;
-    float deceleration_in_steps =  (deceleration_time > 0.0F ) ? ( this->maximum_rate - final_rate ) / deceleration_time : 0;
+    float acceleration_in_steps = (acceleration_time > 0.0F ) ? ( maximum_rate - initial_rate ) / acceleration_time : 0;
+    float deceleration_in_steps =  (deceleration_time > 0.0F ) ? ( maximum_rate - final_rate ) / deceleration_time : 0;
 
-    // we have a potential race condition here as we could get interrupted anywhere in the middle of this call, we need to lock
-    // the updates to the blocks to get around it
-    this->locked= true;
     // Now figure out the two acceleration ramp change events in ticks
-    this->accelerate_until = acceleration_ticks;
-    this->decelerate_after = total_move_ticks - deceleration_ticks;
+    this->tick_info_block->accelerate_until = acceleration_ticks;
+    this->tick_info_block->decelerate_after = total_move_ticks - deceleration_ticks;
+    this->tick_info_block->accel_jerk_ticks = 0;
+    this->tick_info_block->decel_jerk_ticks = 0;
 
     // We now have everything we need for this block to call a Steppermotor->move method !!!!
     // Theorically, if accel is done per tick, the speed curve should be perfect.
-    this->total_move_ticks = total_move_ticks;
+    this->tick_info_block->total_move_ticks = total_move_ticks;
+
+    this->exit_speed = exitspeed;
+
+    // prepare the block for stepticker
+    (this->*prepare_fnc)(initial_rate, maximum_rate, final_rate, acceleration_in_steps, deceleration_in_steps, 0, 0);
+}
+
+// time in seconds an S-curve takes to change the speed by delta_v
+static float s_curve_time(float delta_v, float acceleration, float jerk)
+{
+    if(delta_v <= 0.0F) return 0.0F;
+    // the acceleration reaches its limit and stays there for a while
+    if(delta_v >= acceleration * acceleration / jerk) return (delta_v / acceleration) + (acceleration / jerk);
+    // the acceleration ramps up and straight back down again before reaching its limit
+    return 2.0F * sqrtf(delta_v / jerk);
+}
+
+// distance an S-curve takes to change the speed from v0 to v1, it is symmetrical so the average speed is the mean of the two
+static float s_curve_distance(float v0, float v1, float acceleration, float jerk)
+{
+    return ((v0 + v1) / 2.0F) * s_curve_time(fabsf(v1 - v0), acceleration, jerk);
+}
+
+/* Calculates the S-curve parameters, same as calculate_trapezoid() but the acceleration changes at a constant jerk
+// Each of the acceleration and deceleration is split into three parts, the acceleration ramps up, stays at its peak
+// and then ramps back down, so the speed follows an S rather than a straight line.
+//                                  _-----_ <- maximum_rate
+//                                /         \
+//  initial_rate ->            _-            \
+//                                            -_ <- final_rate
+//                              time -->
+*/
+void Block::calculate_s_curve(float initial_rate, float final_rate, float exitspeed, float acceleration_per_second)
+{
+    float jerk_per_second = (this->jerk * this->steps_event_count) / this->millimeters;
+
+    // find the highest rate we can reach and still get down to the final rate, the distance increases with the rate
+    // so it is a simple bisection, as the planner has checked the entry and exit speeds the lower bound always fits
+    // when replanning above the nominal rate the lower bound is the entry rate, it is held there until it has to decelerate
+    float maximum_rate = this->nominal_rate;
+    float distance = s_curve_distance(initial_rate, maximum_rate, acceleration_per_second, jerk_per_second) +
+                     s_curve_distance(maximum_rate, final_rate, acceleration_per_second, jerk_per_second);
+    if(distance > this->steps_event_count) {
+        float lo = std::max(initial_rate, final_rate);
+        float hi = std::max(this->nominal_rate, lo);
+        for (int i = 0; i < 20; ++i) {
+            float mid = (lo + hi) / 2.0F;
+            float d = s_curve_distance(initial_rate, mid, acceleration_per_second, jerk_per_second) +
+                      s_curve_distance(mid, final_rate, acceleration_per_second, jerk_per_second);
+            if(d > this->steps_event_count) hi = mid;
+            else lo = mid;
+        }
+        maximum_rate = lo;
+        distance = s_curve_distance(initial_rate, lo, acceleration_per_second, jerk_per_second) +
+                   s_curve_distance(lo, final_rate, acceleration_per_second, jerk_per_second);
+    }
+
+    float time_to_accelerate = s_curve_time(fabsf(maximum_rate - initial_rate), acceleration_per_second, jerk_per_second);
+    float time_to_decelerate = s_curve_time(maximum_rate - final_rate, acceleration_per_second, jerk_per_second);
+    float plateau_time = std::max(0.0F, (this->steps_event_count - distance) / maximum_rate);
+    float total_move_time = time_to_accelerate + time_to_decelerate + plateau_time;
+
+    // round into ticks, same as the trapezoid
+    uint32_t acceleration_ticks = floorf( time_to_accelerate * STEP_TICKER_FREQUENCY );
+    uint32_t deceleration_ticks = floorf( time_to_decelerate * STEP_TICKER_FREQUENCY );
+    uint32_t total_move_ticks   = floorf( total_move_time    * STEP_TICKER_FREQUENCY );
+
+    // the time the acceleration ramps take, it is the whole of each half if the peak acceleration is never reached
+    float max_ramp_time = acceleration_per_second / jerk_per_second;
+    uint32_t accel_jerk_ticks = roundf( std::min(max_ramp_time, time_to_accelerate / 2.0F) * STEP_TICKER_FREQUENCY );
+    uint32_t decel_jerk_ticks = roundf( std::min(max_ramp_time, time_to_decelerate / 2.0F) * STEP_TICKER_FREQUENCY );
+    accel_jerk_ticks = std::min(accel_jerk_ticks, acceleration_ticks / 2);
+    decel_jerk_ticks = std::min(decel_jerk_ticks, deceleration_ticks / 2);
+
+    // Now figure out the jerk to reach EXACTLY maximum_rate in EXACTLY acceleration_ticks, with a ramp of n ticks at each end
+    // the rate changes by jerk * n * (ticks - n), the jerk here is the change in steps/sec per tick per tick
+    float accel_jerk_in_steps = (accel_jerk_ticks > 0) ? ( maximum_rate - initial_rate ) / ((float)accel_jerk_ticks * (acceleration_ticks - accel_jerk_ticks)) : 0;
+    float decel_jerk_in_steps = (decel_jerk_ticks > 0) ? ( maximum_rate - final_rate ) / ((float)decel_jerk_ticks * (deceleration_ticks - decel_jerk_ticks)) : 0;
+
+    this->tick_info_block->accelerate_until = acceleration_ticks;
+    this->tick_info_block->decelerate_after = total_move_ticks - deceleration_ticks;
+    this->tick_info_block->accel_jerk_ticks = accel_jerk_ticks;
+    this->tick_info_block->decel_jerk_ticks = decel_jerk_ticks;
+    this->tick_info_block->total_move_ticks = total_move_ticks;
+    this->s_curve = true;
 
-    this->initial_rate = initial_rate;
     this->exit_speed = exitspeed;
 
     // prepare the block for stepticker
-    this->prepare(acceleration_in_steps, deceleration_in_steps);
+    (this->*prepare_fnc)(initial_rate, maximum_rate, final_rate, 0, 0, accel_jerk_in_steps, decel_jerk_in_steps);
+}
 
-    this->locked= false;
+// the step pulses a tick for a rate in steps per tick
+static uint8_t multi_step_for(float rate, uint8_t max_multi_step)
+{
+    uint8_t n= 1;
+    while(n < max_multi_step && rate > MULTI_STEP_RATE * n) n *= 2;
+    return n;
+}
+
+// how far through a speed change of n ticks the rate is at tick t, the S-curve ramps the acceleration over r ticks at each end
+static float ramp_fraction(uint32_t t, uint32_t n, uint32_t r)
+{
+    if(r == 0) return (float)t / n;
+    float k= 2.0F * r * (n - r);
+    if(t <= r) return (float)t * t / k;
+    if(t >= n - r) return 1.0F - (float)(n - t) * (n - t) / k;
+    return ((float)r * r + 2.0F * r * (t - r)) / k;
+}
+
+// the first tick of the speed change the rate is past fraction f of the way through it
+static uint32_t ramp_tick(float f, uint32_t n, uint32_t r)
+{
+    uint32_t lo= 0, hi= n;
+    while(lo < hi) {
+        uint32_t mid= lo + (hi - lo) / 2;
+        if(ramp_fraction(mid, n, r) > f) hi= mid;
+        else lo= mid + 1;
+    }
+    return lo;
+}
+
+/* Works out the ticks the step pulses the motor is given change at, like the AMASS levels of Grbl, the rates are the motor's
+// Below MULTI_STEP_RATE steps a tick a tick gives one step pulse, above it two, and above twice that four, so the tick info steps
+// on no more than half the ticks until the motor is given the most, and it never gets a burst of pulses at a low speed. As the rate only goes one way in
+// the acceleration and in the deceleration each of the multi step rates is gone through once in each.
+*/
+void Block::plan_multi_step(uint8_t m, float initial_rate, float maximum_rate, float final_rate)
+{
+    tickinfo_cold_t& tc= this->tick_info_cold()[m];
+    tickinfo_block_t& tb= *this->tick_info_block;
+    tc.multi_step_at.fill(UINT32_MAX);
+    tc.multi_step_i= 0;
+    if(max_multi_step <= 1 || this->arc || this->kinematic) {
+        this->tick_info[m].multi_step= tc.peak_multi_step= 1;
+        return;
+    }
+
+    float r0= initial_rate / STEP_TICKER_FREQUENCY;
+    float r1= maximum_rate / STEP_TICKER_FREQUENCY;
+    float r2= final_rate / STEP_TICKER_FREQUENCY;
+    uint8_t first= multi_step_for(r0, max_multi_step);
+    uint8_t plateau= multi_step_for(r1, max_multi_step);
+    this->tick_info[m].multi_step= first;
+    tc.peak_multi_step= std::max(first, plateau);
+
+    // the acceleration, when the rest of an executing block is replanned above the nominal rate it slows down to it instead
+    uint8_t n= 0;
+    for (uint8_t p= first; p != plateau; p= tc.multi_step_to[n++]) {
+        tc.multi_step_to[n]= (plateau > p) ? p * 2 : p / 2;
+        float rate= MULTI_STEP_RATE * std::min(p, tc.multi_step_to[n]);
+        tc.multi_step_at[n]= ramp_tick((rate - r0) / (r1 - r0), tb.accelerate_until, tb.accel_jerk_ticks);
+    }
+
+    uint8_t last= multi_step_for(r2, max_multi_step);
+    for (uint8_t p= plateau; p != last; p= tc.multi_step_to[n++]) {
+        tc.multi_step_to[n]= p / 2;
+        float rate= MULTI_STEP_RATE * (p / 2);
+        tc.multi_step_at[n]= tb.decelerate_after + ramp_tick((r1 - rate) / (r1 - r2), tb.total_move_ticks - tb.decelerate_after, tb.decel_jerk_ticks);
+    }
+
+    tb.multi_step_tick= std::min(tb.multi_step_tick, tc.multi_step_at[0]);
+}
+
+// a counter for `from` step pulses a tick, for `to` of them, it is kept to 1.0 so adding the rate cannot overflow, the time a step
+// was due before that is lost
+int64_t Block::rescale_counter(int64_t counter, uint8_t from, uint8_t to)
+{
+    int s= __builtin_ctz(to) - __builtin_ctz(from);
+    if(s >= 0) return counter >> s;
+    if(counter >= (STEPTICKER_FPSCALE >> -s)) return STEPTICKER_FPSCALE;
+    return counter << -s;
+}
+
+// a motor's rate has gone through a multi step rate, from this tick it is given a different number of step pulses on each tick
+// it steps on, and its tick info is scaled to match, called from the step ticker ISR, see plan_multi_step()
+void Block::multi_step_event(uint32_t tick)
+{
+    tickinfo_block_t& tb= *this->tick_info_block;
+    uint32_t next= UINT32_MAX;
+    for (uint8_t i = 0; i < tb.n_active_actuators; i++) {
+        uint8_t m= tb.active_actuators[i];
+        tickinfo_t& ti= this->tick_info[m];
+        tickinfo_cold_t& tc= this->tick_info_cold()[m];
+        while(tc.multi_step_at[tc.multi_step_i] == tick) {
+            // they are powers of two so it is a shift, not a 64 bit divide
+            uint8_t to= tc.multi_step_to[tc.multi_step_i++];
+            int s= __builtin_ctz(to) - __builtin_ctz(ti.multi_step);
+            if(s > 0) {
+                ti.steps_per_tick >>= s;
+                ti.acceleration_change >>= s;
+                ti.jerk_change >>= s;
+            } else {
+                ti.steps_per_tick *= 1 << -s;
+                ti.acceleration_change *= 1 << -s;
+                ti.jerk_change *= 1 << -s;
+            }
+            ti.counter= rescale_counter(ti.counter, ti.multi_step, to);
+            ti.multi_step= to;
+        }
+        next= std::min(next, tc.multi_step_at[tc.multi_step_i]);
+    }
+    tb.multi_step_tick= next;
 }
 
 // Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
 // acceleration within the allotted distance.
-float Block::max_allowable_speed(float acceleration, float target_velocity, float distance)
+// If the jerk is limited the speed change takes longer, and so more distance, than with a constant acceleration
+float Block::max_allowable_speed(float acceleration, float target_velocity, float distance, float jerk)
 {
-    return sqrtf(target_velocity * target_velocity - 2.0F * acceleration * distance);
+    float v = sqrtf(target_velocity * target_velocity - 2.0F * acceleration * distance);
+    if(jerk <= 0.0F) return v;
+
+    // if the acceleration limit is reached the distance is (v0 + v1) / 2 * ((v0 - v1) / a + a / j), which is a quadratic in v0
+    float a = fabsf(acceleration);
+    float c = a * a / jerk;
+    float v0 = (sqrtf(powf(2.0F * target_velocity - c, 2) + 8.0F * a * distance) - c) / 2.0F;
+    if(v0 - target_velocity >= c) return v0;
+
+    // otherwise the distance is (v0 + v1) * sqrt((v0 - v1) / j), solve (v0 + v1)^2 * (v0 - v1) = distance^2 * j for v0
+    // the function is convex so Newton's method from the trapezoid speed, which is always higher, converges from above
+    float k = distance * distance * jerk;
+    float x = v;
+    for (int i = 0; i < 8; ++i) {
+        float f = (x + target_velocity) * (x + target_velocity) * (x - target_velocity) - k;
+        if(f <= 0.0F) break;
+        float dx = f / ((x + target_velocity) * (3.0F * x - target_velocity));
+        x -= dx;
+        if(dx < x * 0.0001F) break;
+    }
+
+    return x;
+}
+
+// The lowest speed the block can slow down to from entry_velocity within the distance, the opposite of max_allowable_speed()
+float Block::min_exit_speed(float acceleration, float entry_velocity, float distance, float jerk)
+{
+    float v2 = entry_velocity * entry_velocity - 2.0F * acceleration * distance;
+    float v = (v2 > 0.0F) ? sqrtf(v2) : 0.0F;
+    if(jerk <= 0.0F) return v;
+
+    // the jerk limited speed change takes longer, so the exit speed is higher, search for the one max_allowable_speed() gives the entry speed for
+    if(max_allowable_speed(-acceleration, v, distance, jerk) >= entry_velocity) return v;
+    float lo = v, hi = entry_velocity;
+    for (int i = 0; i < 16; ++i) {
+        float mid = (lo + hi) / 2.0F;
+        if(max_allowable_speed(-acceleration, mid, distance, jerk) >= entry_velocity) hi = mid;
+        else lo = mid;
+    }
+    return hi;
+}
+
+// The distance it takes to slow down from the velocity to a stop
+float Block::stopping_distance(float acceleration, float velocity, float jerk)
+{
+    if(jerk <= 0.0F) return velocity * velocity / (2.0F * acceleration);
+    return s_curve_distance(velocity, 0.0F, acceleration, jerk);
 }
 
 // Called by Planner::recalculate() when scanning the plan from last to first entry.
@@ -241,7 +545,7 @@ float Block::reverse_pass(float exit_speed)
         // If nominal length true, max junction speed is guaranteed to be reached. Only compute
         // for max allowable speed if block is decelerating and nominal length is false.
         if ((!this->nominal_length_flag) && (this->max_entry_speed > exit_speed)) {
-            float max_entry_speed = max_allowable_speed(-this->acceleration, exit_speed, this->millimeters);
+            float max_entry_speed = max_allowable_speed(-this->acceleration, exit_speed, this->millimeters, this->jerk);
 
             this->entry_speed = min(max_entry_speed, this->max_entry_speed);
 
@@ -275,18 +579,19 @@ float Block::forward_pass(float prev_max_exit_speed)
         // since we're now acceleration or cruise limited
         // we don't need to recalculate our entry speed anymore
         recalculate_flag = false;
+    } else {
+        // decel limited, a later block may still let us enter faster
+        recalculate_flag = true;
     }
-    // else
-    // // decel limited, do nothing
 
     return max_exit_speed();
 }
 
 float Block::max_exit_speed()
 {
-    // if block is currently executing, return cached exit speed from calculate_trapezoid
-    // this ensures that a block following a currently executing block will have correct entry speed
-    if(is_ticking)
+    // if block has been prepared for execution, return cached exit speed from calculate_trapezoid
+    // this ensures that a block following a prepared or executing block will have correct entry speed
+    if(prepared)
         return this->exit_speed;
 
     // if nominal_length_flag is asserted
@@ -296,14 +601,24 @@ float Block::max_exit_speed()
         return nominal_speed;
 
     // otherwise, we have to work out max exit speed based on entry and acceleration
-    float max = max_allowable_speed(-this->acceleration, this->entry_speed, this->millimeters);
+    float max = max_allowable_speed(-this->acceleration, this->entry_speed, this->millimeters, this->jerk);
 
     return min(max, nominal_speed);
 }
 
-// prepare block for the step ticker, called everytime the block changes
-// this is done during planning so does not delay tick generation and step ticker can simply grab the next block during the interrupt
-void Block::prepare(float acceleration_in_steps, float deceleration_in_steps)
+// the nominal speed for the feed override factor, the speed asked for scaled by it if it applies, up to the machine limits
+float Block::override_speed(float factor) const
+{
+    const cold_t *c= cold();
+    if(c->programmed_speed <= 0.0F) return nominal_speed;
+    return std::min(c->programmed_speed * (feed_override ? factor : 1.0F), c->speed_limit);
+}
+
+// prepare block for the step ticker, called once just before the block is executed, see Conveyor::prepare_block()
+// this is normally done in the main loop while the previous block executes, so the step ticker can simply grab the next block during the interrupt
+// N is the number of actuators, so the loop over them is unrolled
+template<uint8_t N>
+void Block::prepare(float initial_rate, float maximum_rate, float final_rate, float acceleration_in_steps, float deceleration_in_steps, float accel_jerk_in_steps, float decel_jerk_in_steps)
 {
 
     float inv = 1.0F / this->steps_event_count;
@@ -313,40 +628,61 @@ void Block::prepare(float acceleration_in_steps, float deceleration_in_steps)
     // was....
     // float acceleration_per_tick = acceleration_in_steps / STEP_TICKER_FREQUENCY_2; // that is 100,000² too big for a float
     // float deceleration_per_tick = deceleration_in_steps / STEP_TICKER_FREQUENCY_2;
-    double acceleration_per_tick = acceleration_in_steps * fp_scale; // this is now scaled to fit a 2.30 fixed point number
-    double deceleration_per_tick = deceleration_in_steps * fp_scale;
-
-    for (uint8_t m = 0; m < n_actuators; m++) {
-        uint32_t steps = this->steps[m];
+    planner_fp_t acceleration_per_tick = acceleration_in_steps * fp_scale; // this is now scaled to fit a 2.30 fixed point number
+    planner_fp_t deceleration_per_tick = deceleration_in_steps * fp_scale;
+    tickinfo_block_t& tb= *this->tick_info_block;
+
+    tb.n_active_actuators= 0;
+    tb.active_mask= 0;
+    tb.multi_step_tick= UINT32_MAX;
+    for (uint8_t m = 0; m < N; m++) {
+        uint32_t steps = ticked_steps(m);
         this->tick_info[m].steps_to_move = steps;
         if(steps == 0) continue;
 
+        tb.active_actuators[tb.n_active_actuators++]= m;
+        tb.active_mask |= 1 << m;
+
         float aratio = inv * steps;
+        plan_multi_step(m, initial_rate * aratio, maximum_rate * aratio, final_rate * aratio);
+
+        // the tick info is for the step pulses the motor starts with, the cold tick info for the most it gets
+        float peak_ratio = aratio / this->tick_info_cold()[m].peak_multi_step;
+        aratio /= this->tick_info[m].multi_step;
 
-        this->tick_info[m].steps_per_tick = (int64_t)round((((double)this->initial_rate * aratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE); // steps/sec / tick frequency to get steps per tick in 2.62 fixed point
+        this->tick_info[m].steps_per_tick = fp_round((((planner_fp_t)initial_rate * aratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE); // steps/sec / tick frequency to get steps per tick in 2.62 fixed point
         this->tick_info[m].counter = 0; // 2.62 fixed point
         this->tick_info[m].step_count = 0;
-        this->tick_info[m].next_accel_event = this->total_move_ticks + 1;
+        this->tick_info[m].next_accel_event = tb.total_move_ticks + 1;
 
-        double acceleration_change = 0;
-        if(this->accelerate_until != 0) { // If the next accel event is the end of accel
-            this->tick_info[m].next_accel_event = this->accelerate_until;
+        planner_fp_t acceleration_change = 0;
+        if(tb.accelerate_until != 0) { // If the next accel event is the end of accel
+            this->tick_info[m].next_accel_event = tb.accelerate_until;
             acceleration_change = acceleration_per_tick;
 
-        } else if(this->decelerate_after == 0 /*&& this->accelerate_until == 0*/) {
+        } else if(tb.decelerate_after == 0 /*&& tb.accelerate_until == 0*/) {
             // we start off decelerating
             acceleration_change = -deceleration_per_tick;
 
-        } else if(this->decelerate_after != this->total_move_ticks /*&& this->accelerate_until == 0*/) {
+        } else if(tb.decelerate_after != tb.total_move_ticks /*&& tb.accelerate_until == 0*/) {
             // If the next event is the start of decel ( don't set this if the next accel event is accel end )
-            this->tick_info[m].next_accel_event = this->decelerate_after;
+            this->tick_info[m].next_accel_event = tb.decelerate_after;
         }
 
         // already converted to fixed point just needs scaling by ratio
         //#define STEPTICKER_TOFP(x) ((int64_t)round((double)(x)*STEPTICKER_FPSCALE))
-        this->tick_info[m].acceleration_change= (int64_t)round(acceleration_change * aratio);
-        this->tick_info[m].deceleration_change= -(int64_t)round(deceleration_per_tick * aratio);
-        this->tick_info[m].plateau_rate= (int64_t)round(((this->maximum_rate * aratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE);
+        this->tick_info[m].acceleration_change= fp_round(acceleration_change * aratio);
+        this->tick_info_cold()[m].deceleration_change= -fp_round(deceleration_per_tick * peak_ratio);
+        this->tick_info_cold()[m].plateau_rate= fp_round(((maximum_rate * peak_ratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE);
+
+        this->tick_info[m].jerk_change= 0;
+        if(this->s_curve) {
+            // the jerk is in steps/sec per tick per tick, convert to steps per tick per tick per tick
+            this->tick_info_cold()[m].accel_jerk= fp_round((((planner_fp_t)accel_jerk_in_steps * peak_ratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE);
+            this->tick_info_cold()[m].decel_jerk= fp_round((((planner_fp_t)decel_jerk_in_steps * peak_ratio) / STEP_TICKER_FREQUENCY) * STEPTICKER_FPSCALE);
+            this->tick_info[m].acceleration_change= 0;
+            s_curve_segment(m, 0);
+        }
 
         #if 0
         THEKERNEL->streams->printf("spt: %08lX %08lX, ac: %08lX %08lX, dc: %08lX %08lX, pr: %08lX %08lX\n",
@@ -354,19 +690,133 @@ void Block::prepare(float acceleration_in_steps, float deceleration_in_steps)
             (uint32_t)(this->tick_info[m].steps_per_tick&0xFFFFFFFF), // 2.62 fixed point
             (uint32_t)(this->tick_info[m].acceleration_change>>32), // 2.62 fixed point signed
             (uint32_t)(this->tick_info[m].acceleration_change&0xFFFFFFFF), // 2.62 fixed point signed
-            (uint32_t)(this->tick_info[m].deceleration_change>>32), // 2.62 fixed point
-            (uint32_t)(this->tick_info[m].deceleration_change&0xFFFFFFFF), // 2.62 fixed point
-            (uint32_t)(this->tick_info[m].plateau_rate>>32), // 2.62 fixed point
-            (uint32_t)(this->tick_info[m].plateau_rate&0xFFFFFFFF) // 2.62 fixed point
+            (uint32_t)(this->tick_info_cold()[m].deceleration_change>>32), // 2.62 fixed point
+            (uint32_t)(this->tick_info_cold()[m].deceleration_change&0xFFFFFFFF), // 2.62 fixed point
+            (uint32_t)(this->tick_info_cold()[m].plateau_rate>>32), // 2.62 fixed point
+            (uint32_t)(this->tick_info_cold()[m].plateau_rate&0xFFFFFFFF) // 2.62 fixed point
         );
         #endif
     }
 }
 
+// Sets the jerk for the S-curve segment that starts at the given tick, and the tick of the next event
+// Called from prepare() for tick 0, and from the step ticker ISR on the last tick of each segment
+void Block::s_curve_segment(uint8_t m, uint32_t from)
+{
+    tickinfo_t& ti= this->tick_info[m];
+    const tickinfo_cold_t& tc= this->tick_info_cold()[m];
+    const tickinfo_block_t& tb= *this->tick_info_block;
+    uint32_t an= tb.accel_jerk_ticks;
+    uint32_t dn= tb.decel_jerk_ticks;
+
+    if(from < an) {
+        // acceleration ramping up
+        ti.jerk_change= cold_rate(m, tc.accel_jerk);
+        ti.next_accel_event= an - 1;
+
+    } else if(from < tb.accelerate_until - an) {
+        // constant acceleration
+        ti.jerk_change= 0;
+        ti.next_accel_event= tb.accelerate_until - an - 1;
+
+    } else if(from < tb.accelerate_until) {
+        // acceleration ramping down
+        ti.jerk_change= -cold_rate(m, tc.accel_jerk);
+        ti.next_accel_event= tb.accelerate_until - 1;
+
+    } else if(from <= tb.decelerate_after) {
+        // plateau, set the exact rate to remove any rounding errors from the acceleration
+        if(from == tb.accelerate_until && from > 0) ti.steps_per_tick= cold_rate(m, tc.plateau_rate);
+        ti.jerk_change= 0;
+        ti.acceleration_change= 0;
+        ti.next_accel_event= tb.decelerate_after;
+
+    } else if(from <= tb.decelerate_after + dn) {
+        // deceleration ramping up
+        ti.jerk_change= -cold_rate(m, tc.decel_jerk);
+        ti.next_accel_event= tb.decelerate_after + dn;
+
+    } else if(from <= tb.total_move_ticks - dn) {
+        // constant deceleration
+        ti.jerk_change= 0;
+        ti.next_accel_event= tb.total_move_ticks - dn;
+
+    } else if(from <= tb.total_move_ticks) {
+        // deceleration ramping down
+        ti.jerk_change= cold_rate(m, tc.decel_jerk);
+        ti.next_accel_event= tb.total_move_ticks;
+
+    } else {
+        // past the end of the move, a motor that is a step behind from rounding would crawl at the exit rate,
+        // keep slowing down so the rate goes to zero and the step ticker forces the last step, as the trapezoid does
+        ti.jerk_change= -cold_rate(m, tc.decel_jerk);
+        ti.next_accel_event= from - 1;
+    }
+}
+
+// the steps the step ticker runs the motor's tick info for, for the arc axes of a native arc the first one has the steps along the arc
+uint32_t Block::ticked_steps(uint8_t m) const
+{
+    if(this->arc) {
+        const path_t *p= path();
+        if(m == p->arc_axis[0]) return p->path_steps;
+        if(m == p->arc_axis[1]) return 0;
+    }
+    if(this->kinematic && m <= GAMMA_STEPPER) {
+        return (m == ALPHA_STEPPER) ? path()->path_steps : 0;
+    }
+    return this->steps[m];
+}
+
+// the steps the motor has still to make in the block, once the tick info is running
+uint32_t Block::steps_left(uint8_t m) const
+{
+    const tickinfo_t& ti= this->tick_info[m];
+    if(ti.steps_to_move == 0) return 0;
+    return ti.steps_to_move - ti.step_count;
+}
+
+// work out where the towers are at each waypoint of a kinematic line, from the same arm solution and rounding the planner
+// used, and the last one is exactly where it put the end of the line. This is done when the block is prepared, normally in
+// the main loop, so only the waypoints of the blocks about to be executed are ever kept
+void Block::prepare_waypoints()
+{
+    const path_t *p= path();
+    waypoint_t *waypoints= this->waypoints();
+    uint8_t n= p->kin_intervals;
+    float points[k_max_waypoints][3];
+    ActuatorCoordinates actuator[k_max_waypoints];
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 3; ++j) points[i][j]= p->kin_start[j] + p->kin_delta[j] * i / n;
+    }
+    THEROBOT->arm_solution->cartesian_to_actuators(points[0], 3, actuator, n);
+
+    int32_t start[3], last[3];
+    for (int j = 0; j < 3; ++j) {
+        start[j]= lroundf(actuator[0][j] * THEROBOT->actuators[j]->get_steps_per_mm());
+        last[j]= 0;
+    }
+
+    uint32_t from= 0;
+    for (int i = 0; i < n; ++i) {
+        waypoint_t& w= waypoints[i];
+        w.until= ((uint64_t)p->path_steps * (i + 1)) / n;
+        uint32_t d= std::max(w.until - from, (uint32_t)1);
+        for (int j = 0; j < 3; ++j) {
+            int32_t next= (i == n - 1) ? ((this->direction_bits >> j) & 1 ? -(int32_t)this->steps[j] : (int32_t)this->steps[j])
+                                       : lroundf(actuator[i + 1][j] * THEROBOT->actuators[j]->get_steps_per_mm()) - start[j];
+            w.steps[j]= last[j];
+            w.steps_per_step[j]= (int32_t)fp_round((planner_fp_t)(next - last[j]) * (1 << 30) / d);
+            last[j]= next;
+        }
+        from= w.until;
+    }
+}
+
 // returns current rate (steps/sec) for the given actuator
 float Block::get_trapezoid_rate(int i) const
 {
     // convert steps per tick from fixed point to float and convert to steps/sec
     // FIXME steps_per_tick can change at any time, potential race condition if it changes while being read here
-    return STEPTICKER_FROMFP(tick_info[i].steps_per_tick) * STEP_TICKER_FREQUENCY;
+    return STEPTICKER_FROMFP(tick_info[i].steps_per_tick) * STEP_TICKER_FREQUENCY * tick_info[i].multi_step;
 }
@@ -7,76 +7,190 @@
 
 #pragma once
 
-#include <bitset>
+#include <cstdint>
 #include "ActuatorCoordinates.h"
 
+// the tick info is worked out in double precision, which the M3 only has in software, PLANNER_SINGLE_PRECISION works it out
+// in float instead, the steps are the same and the timing of them within a tick or so, see make compare-planner in the host build
+#ifdef PLANNER_SINGLE_PRECISION
+using planner_fp_t= float;
+#else
+using planner_fp_t= double;
+#endif
+
 class Block {
     public:
         Block();
 
-        static void init(uint8_t);
+        static void init(uint8_t n, bool waypoints= false, bool paths= false);
+        static size_t tick_info_arena_size();
 
         void calculate_trapezoid( float entry_speed, float exit_speed );
 
         float reverse_pass(float exit_speed);
         float forward_pass(float next_entry_speed);
         float max_exit_speed();
+        float override_speed(float factor) const;
         void debug() const;
         void ready() { is_ready= true; }
         void clear();
+        void set_tick_info_slot(uint8_t slot);
         float get_trapezoid_rate(int i) const;
+        // a rate from the cold tick info of the motor, for the step pulses it is given now
+        int64_t cold_rate(uint8_t m, int64_t rate) const { return rate * (tick_info_cold()[m].peak_multi_step / tick_info[m].multi_step); }
+        void s_curve_segment(uint8_t m, uint32_t from);
+        void multi_step_event(uint32_t tick);
+        static int64_t rescale_counter(int64_t counter, uint8_t from, uint8_t to);
+        uint32_t ticked_steps(uint8_t m) const;
+        uint32_t steps_left(uint8_t m) const;
+        void prepare_waypoints();
+
+        static float max_allowable_speed( float acceleration, float target_velocity, float distance, float jerk);
+        static float min_exit_speed( float acceleration, float entry_velocity, float distance, float jerk);
+        static float stopping_distance( float acceleration, float velocity, float jerk);
 
     private:
-        float max_allowable_speed( float acceleration, float target_velocity, float distance);
-        void prepare(float acceleration_in_steps, float deceleration_in_steps);
+        void calculate_s_curve(float initial_rate, float final_rate, float exitspeed, float acceleration_per_second);
+        void plan_multi_step(uint8_t m, float initial_rate, float maximum_rate, float final_rate);
+        template<uint8_t N> void prepare(float initial_rate, float maximum_rate, float final_rate, float acceleration_in_steps, float deceleration_in_steps, float accel_jerk_in_steps, float decel_jerk_in_steps);
+        // prepare() for the number of actuators, picked in init()
+        static void (Block::*prepare_fnc)(float, float, float, float, float, float, float);
 
-        static double fp_scale; // optimize to store this as it does not change
+        static planner_fp_t fp_scale; // optimize to store this as it does not change
+        static uint8_t max_multi_step;
+        // two for the executing block and the next one, and two the rest of the executing block is replanned in, see Conveyor::replan_current_block()
+        static const uint8_t k_tick_info_slots= 4;
+        // up and back down through 2 and 4 step pulses
+        static const uint8_t k_max_multi_step_events= 4;
 
     public:
-        std::array<uint32_t, k_max_actuators> steps; // Number of steps for each axis for this block
-        uint32_t steps_event_count;  // Steps for the longest axis
+        static const uint8_t k_replan_slot= 2; // the first of the two replan slots
+
+        // a block holds no more steps than this for any actuator, or along the path of a native arc or kinematic line,
+        // a longer move is planned as more than one block, see Planner::append_block()
+        static const uint16_t k_max_steps= UINT16_MAX;
+
+        std::array<uint16_t, k_max_actuators> steps; // Number of steps for each axis for this block
+        uint16_t steps_event_count;  // Steps for the longest axis
         float nominal_rate;       // Nominal rate in steps per second
         float nominal_speed;      // Nominal speed in mm per second
         float millimeters;        // Distance for this move
         float entry_speed;
         float exit_speed;
         float acceleration;       // the acceleration for this block
-        float initial_rate;       // Initial rate in steps per second
-        float maximum_rate;
+        float jerk;               // the jerk for this block, 0 is a trapezoid with constant acceleration
 
         float max_entry_speed;
 
-        // this is tick info needed for this block. applies to all motors
-        uint32_t accelerate_until;
-        uint32_t decelerate_after;
-        uint32_t total_move_ticks;
-        std::bitset<k_max_actuators> direction_bits;     // Direction for each axis in bit form, relative to the direction port's mask
+        // the blocks in the queue only have what the planner and the step ticker use on every block, the rest is kept alongside
+        // the queue on the heap, at the same index as the block, see BlockQueue::resize()
+        // the feed override rescales the nominal speed of the blocks in the queue, see Planner::set_feed_override()
+        using cold_t= struct {
+            float programmed_speed;   // the speed asked for, before the feed override
+            float speed_limit;        // the fastest the machine limits allow this block to go
+            float max_junction_speed; // the max entry speed allowed by the corner alone, 0 if it does not depend on the nominal speeds
+        };
+
+        // a native arc or a kinematic line, the step ticker ticks one actuator along the path and moves the actuators that
+        // follow it to each point on it, see StepTicker::path_tick(), steps and direction_bits are still where they end up
+        // this is only allocated if native arcs or kinematic lines are enabled
+        using path_t= struct {
+            uint16_t path_steps;      // the steps along the path
+            union {
+                struct {
+                    float arc_start[2];       // from the centre to the start, in steps of each arc axis
+                    float arc_cos_m1;         // cos - 1 of the angle each step along the arc turns through
+                    float arc_sin[2];         // sin of it, scaled by the steps per mm of the axis it is added to over the other one
+                    uint8_t arc_axis[2];
+                };
+                struct {
+                    float kin_start[3];       // where the line starts, in mm
+                    float kin_delta[3];       // and how far it goes
+                    uint8_t kin_intervals;    // the evenly spaced waypoints it is cut into
+                };
+            };
+        };
+
+        cold_t *cold() const { return &cold_arena[cold_i]; }
+        path_t *path() const { return &path_arena[cold_i]; }
+        static cold_t *cold_arena;
+        static path_t *path_arena;
+        static bool has_paths;
+
+        // a waypoint of a kinematic line, the towers move in a straight line from one to the next, see Block::prepare_waypoints()
+        static const uint8_t k_max_waypoints= 16;
+        using waypoint_t= struct {
+            int32_t steps[3];         // where each tower is at the waypoint, in steps from the start of the line
+            int32_t steps_per_step[3]; // 2.30 fixed point, how far each tower moves per step along the line to the next one
+            uint32_t until;           // the step along the line the next waypoint is at
+        };
+        static waypoint_t *waypoint_arena;
 
         // this is the data needed to determine when each motor needs to be issued a step
+        // the fields the step ticker uses on every tick are kept together, the ones only used at acceleration events are in tickinfo_cold_t
         using tickinfo_t= struct {
             int64_t steps_per_tick; // 2.62 fixed point
             int64_t counter; // 2.62 fixed point
             int64_t acceleration_change; // 2.62 fixed point signed
-            int64_t deceleration_change; // 2.62 fixed point
-            int64_t plateau_rate; // 2.62 fixed point
-            uint32_t steps_to_move;
+            int64_t jerk_change; // 2.62 fixed point signed, only non zero in an S-curve
+            uint32_t steps_to_move; // in steps, not ticks that step when a tick gives the motor more than one step pulse
             uint32_t step_count;
             uint32_t next_accel_event;
+            uint8_t multi_step; // the step pulses the motor is given on each tick it steps on, see plan_multi_step()
+        };
+        using tickinfo_cold_t= struct {
+            int64_t deceleration_change; // 2.62 fixed point
+            int64_t plateau_rate; // 2.62 fixed point
+            int64_t accel_jerk; // 2.62 fixed point
+            int64_t decel_jerk; // 2.62 fixed point
+            // the ticks the step pulses change at, the ones not used are never reached, the rates above are for the most it gets
+            std::array<uint32_t, k_max_multi_step_events + 1> multi_step_at;
+            std::array<uint8_t, k_max_multi_step_events> multi_step_to;
+            uint8_t multi_step_i; // the next one
+            uint8_t peak_multi_step;
+        };
+        // this is tick info needed for this block. applies to all motors
+        using tickinfo_block_t= struct {
+            uint32_t accelerate_until;
+            uint32_t decelerate_after;
+            uint32_t total_move_ticks;
+            uint32_t accel_jerk_ticks; // S-curve only, ticks the acceleration takes to ramp up to its peak, and again to ramp back down
+            uint32_t decel_jerk_ticks; // S-curve only, same for the deceleration
+            uint32_t multi_step_tick; // the next tick the step pulses a motor is given change at, see multi_step_event()
+            // the actuators that have steps in this block, so the step ticker does not have to look at the others
+            std::array<uint8_t, k_max_actuators> active_actuators;
+            uint8_t n_active_actuators;
+            uint8_t active_mask;      // the same as a bit per actuator, for the step tick
         };
 
-        // need info for each active motor
+        // need info for each active motor, points into the shared arena once the block has been prepared
         tickinfo_t *tick_info;
+        tickinfo_block_t *tick_info_block;
+        tickinfo_cold_t *tick_info_cold() const { return &tick_info_cold_arena[tick_info_slot * n_actuators]; }
+        waypoint_t *waypoints() const { return &waypoint_arena[tick_info_slot * k_max_waypoints]; }
+        static tickinfo_t *tick_info_arena;
+        static tickinfo_block_t *tick_info_block_arena;
+        static tickinfo_cold_t *tick_info_cold_arena;
 
         static uint8_t n_actuators;
 
+        uint16_t cold_i;          // the index of its cold data and path, set once by BlockQueue::resize()
+        uint8_t direction_bits;   // Direction for each axis in bit form, relative to the direction port's mask
+
         struct {
-            bool recalculate_flag:1;             // Planner flag to recalculate trapezoids on entry junction
+            bool recalculate_flag:1;             // Planner flag set while the entry speed may still change
+            bool prepared:1;                     // set once the trapezoid has been worked out, the planner does not change the block after this
             bool nominal_length_flag:1;          // Planner flag for nominal speed always reached
             bool is_ready:1;
             bool primary_axis:1;                 // set if this move is a primary axis
             bool is_g123:1;                      // set if this is a G1, G2 or G3
             volatile bool is_ticking:1;          // set when this block is being actively ticked by the stepticker
             volatile bool locked:1;              // set to true when the critical data is being updated, stepticker will have to skip if this is set
+            bool s_curve:1;                      // set if this block has a jerk limited acceleration profile
+            bool feed_override:1;                // set if the feed override applies to this block
+            bool arc:1;                          // set if this is a native arc
+            bool kinematic:1;                    // set if this is a kinematic line
+            uint8_t tick_info_slot:2;            // the slot its tick info is in, see set_tick_info_slot()
             uint16_t s_value:12;                 // for laser 1.11 Fixed point
         };
 };
@@ -2,6 +2,7 @@
 #include "Block.h"
 
 #include <cstdlib>
+#include <new>
 #include "cmsis.h"
 #include "platform_memory.h"
 
@@ -12,17 +13,20 @@
 BlockQueue::BlockQueue()
 {
     head_i = tail_i = length = 0;
-    isr_tail_i = tail_i;
+    isr_tail_i = planned_i = tail_i;
     ring = nullptr;
 }
 
 BlockQueue::BlockQueue(unsigned int length)
 {
     head_i = tail_i = 0;
-    isr_tail_i = tail_i;
+    isr_tail_i = planned_i = tail_i;
     void *v= AHB0.alloc(sizeof(Block) * length);
     ring = new(v) Block[length];
     // TODO: handle allocation failure
+    Block::cold_arena= (Block::cold_t *)malloc(sizeof(Block::cold_t) * length);
+    if(Block::has_paths) Block::path_arena= (Block::path_t *)malloc(sizeof(Block::path_t) * length);
+    for (unsigned int i = 0; i < length; i++) ring[i].cold_i= i;
     this->length = length;
 }
 
@@ -37,6 +41,10 @@ BlockQueue::~BlockQueue()
     if(ring != nullptr)
         AHB0.dealloc(ring); // delete [] ring;
     ring = nullptr;
+    free(Block::cold_arena);
+    free(Block::path_arena);
+    Block::cold_arena = nullptr;
+    Block::path_arena = nullptr;
 }
 
 /*
@@ -124,8 +132,12 @@ void BlockQueue::produce_head()
 
 void BlockQueue::consume_tail()
 {
-    if (!is_empty())
+    if (!is_empty()) {
+        // the planned block must stay in the queue, the next one is also fully planned as all before it have been executed
+        if (planned_i == tail_i)
+            planned_i = next(tail_i);
         tail_i = next(tail_i);
+    }
 }
 
 /*
@@ -141,6 +153,12 @@ bool BlockQueue::is_full() const
     return r;
 }
 
+unsigned int BlockQueue::count() const
+{
+    unsigned int h= head_i, t= isr_tail_i;
+    return (h >= t) ? h - t : h + length - t;
+}
+
 bool BlockQueue::is_empty() const
 {
     //__disable_irq();
@@ -171,6 +189,10 @@ bool BlockQueue::resize(unsigned int length)
                 if (ring != nullptr)
                     AHB0.dealloc(ring); // delete [] ring;
                 ring = nullptr;
+                free(Block::cold_arena);
+                free(Block::path_arena);
+                Block::cold_arena = nullptr;
+                Block::path_arena = nullptr;
 
                 return true;
             }
@@ -182,24 +204,44 @@ bool BlockQueue::resize(unsigned int length)
 
         // Note: we don't use realloc so we can fall back to the existing ring if allocation fails
         void *v= AHB0.alloc(sizeof(Block) * length);
+        if (v == nullptr)
+            return false;
+        // the data the blocks only need now and then goes on the heap, a block finds its own by its index, see Block::cold()
+        Block::cold_t *newcold = (Block::cold_t *)malloc(sizeof(Block::cold_t) * length);
+        Block::path_t *newpath = Block::has_paths ? (Block::path_t *)malloc(sizeof(Block::path_t) * length) : nullptr;
+        if (newcold == nullptr || (Block::has_paths && newpath == nullptr))
+        {
+            free(newcold);
+            free(newpath);
+            AHB0.dealloc(v);
+            return false;
+        }
         Block* newring = new(v) Block[length];
 
         if (newring != nullptr)
         {
+            for (unsigned int i = 0; i < length; i++)
+                newring[i].cold_i = i;
             Block* oldring = ring;
+            Block::cold_t *oldcold = Block::cold_arena;
+            Block::path_t *oldpath = Block::path_arena;
 
             __disable_irq();
 
             if (is_empty()) // check again in case something was pushed while malloc did its thing
             {
                 ring = newring;
+                Block::cold_arena = newcold;
+                Block::path_arena = newpath;
                 this->length = length;
-                head_i = tail_i = 0;
+                head_i = tail_i = planned_i = 0;
 
                 __enable_irq();
 
                 if (oldring != nullptr)
                     AHB0.dealloc(oldring); // delete [] oldring;
+                free(oldcold);
+                free(oldpath);
 
                 return true;
             }
@@ -208,6 +250,8 @@ bool BlockQueue::resize(unsigned int length)
 
             AHB0.dealloc(newring); // delete [] newring;
         }
+        free(newcold);
+        free(newpath);
     }
 
     return false;
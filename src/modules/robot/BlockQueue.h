@@ -37,6 +37,8 @@ public:
      */
     bool is_empty(void) const;
     bool is_full(void) const;
+    // the blocks the step ticker has not finished yet, including the one it is on
+    unsigned int count(void) const;
 
     /*
      * resize
@@ -75,6 +77,8 @@ protected:
     volatile unsigned int head_i;
     volatile unsigned int tail_i;
     volatile unsigned int isr_tail_i;
+    // the newest block whose entry speed can no longer change, the planner does not need to look at it or anything before it again
+    unsigned int planned_i;
 
 private:
     Block* ring;
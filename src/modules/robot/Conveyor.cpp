@@ -30,6 +30,11 @@
 #define planner_queue_size_checksum CHECKSUM("planner_queue_size")
 #define queue_delay_time_ms_checksum CHECKSUM("queue_delay_time_ms")
 
+// how far ahead of the step ticker the rest of the executing block is replanned from, it has to cover the time the replan takes
+#define REPLAN_LEAD_MS 5
+// not worth replanning the executing block if it has less than this left after that
+#define REPLAN_MIN_MS 10
+
 /*
  * The conveyor holds the queue of blocks, takes care of creating them, and starting the executing chain of blocks
  *
@@ -64,6 +69,14 @@ Conveyor::Conveyor()
     allow_fetch = false;
     flush= false;
     controlled_stop = false;
+    feed_override_changed= false;
+    replanning= false;
+    replanned= nullptr;
+    replanned_exit_speed= 0;
+    holding= false;
+    hold_planned= false;
+    parking= false;
+    hold_i= hold_from_i= 0;
 }
 
 void Conveyor::on_module_loaded()
@@ -71,17 +84,31 @@ void Conveyor::on_module_loaded()
     register_for_event(ON_IDLE);
     register_for_event(ON_HALT);
 
-    // Attach to the end_of_move stepper event
-    //THEKERNEL->step_ticker->finished_fnc = std::bind( &Conveyor::all_moves_finished, this);
-    queue_size = THEKERNEL->config->value(planner_queue_size_checksum)->by_default(32)->as_number();
+    // if the main loop has fallen behind the step ticker has the block it needs next prepared in PendSV, see get_next_block()
+    THEKERNEL->step_ticker->finished_fnc = std::bind( &Conveyor::prepare_late_block, this);
+    queue_size = THEKERNEL->config->value(planner_queue_size_checksum)->by_default(128)->as_number();
     queue_delay_time_ms = THEKERNEL->config->value(queue_delay_time_ms_checksum)->by_default(100)->as_number();
 }
 
 // we allocate the queue here after config is completed so we do not run out of memory during config
 void Conveyor::start(uint8_t n)
 {
-    Block::init(n); // set the number of motors which determines how big the tick info vector is
-    queue.resize(queue_size);
+    Block::init(n, THEROBOT->kinematic_lines, THEROBOT->native_arcs || THEROBOT->kinematic_lines); // set the number of motors which determines how big the tick info vector is
+
+    // the blocks share the tick info by the parity of their index, so the length has to be even for the last and first blocks to differ
+    size_t configured_size= queue_size;
+    queue_size= (queue_size + 1) & ~1;
+    // if there is not enough AHB0, or heap for the cold data, left for the configured queue use the biggest that fits
+    while(!queue.resize(queue_size)) {
+        if(queue_size <= 4) {
+            THEKERNEL->streams->printf("FATAL: not enough memory for the planner queue\n");
+            __debugbreak();
+        }
+        queue_size= (queue_size / 2 + 1) & ~1;
+    }
+    if(queue_size < configured_size) {
+        THEKERNEL->streams->printf("WARNING: planner_queue_size reduced to %u\n", (unsigned)queue_size);
+    }
     running = true;
 }
 
@@ -90,11 +117,29 @@ void Conveyor::on_halt(void* argument)
     if(argument == nullptr) {
         // marks queue to be flushed next time get_next_block() is called
         flush_queue();
+        holding= false;
     }
 }
 
 void Conveyor::on_idle(void*)
 {
+    planning= true;
+    if(replanning) check_replan();
+    if(!replanning && !THEKERNEL->is_halted()) {
+        if(THEKERNEL->get_feed_hold()) {
+            // stop, and as the step ticker moves on to the next block see if it can stop sooner in that one
+            if(!holding || !hold_planned || (queue.isr_tail_i != hold_from_i && queue.isr_tail_i != hold_i)) plan_hold();
+
+        } else if(holding) {
+            release_hold();
+
+        } else if(feed_override_changed) {
+            feed_override_changed= false;
+            apply_feed_override();
+        }
+    }
+    planning= false;
+
     if (running) {
         check_queue();
     }
@@ -122,7 +167,8 @@ bool Conveyor::is_idle() const
         for(auto &a : THEROBOT->actuators) {
             if(a->is_moving()) return false;
         }
-        return true;
+        // the input shapers issue the last steps after the blocks have finished
+        return !THEKERNEL->step_ticker->is_shaping();
     }
 
     return false;
@@ -131,6 +177,9 @@ bool Conveyor::is_idle() const
 // Wait for the queue to be empty and for all the jobs to finish in step ticker
 void Conveyor::wait_for_idle(bool wait_for_motors)
 {
+    // the Robot may be holding back moves that have not been planned yet, or one to merge the next one into
+    THEROBOT->flush_queued_moves();
+
     // wait for the job queue to empty, this means cycling everything on the block queue into the job queue
     // forcing them to be jobs
     running = false; // stops on_idle calling check_queue
@@ -191,7 +240,13 @@ void Conveyor::check_queue(bool force)
     if(force || queue.is_full() || (us_ticker_read() - last_time_check) >= (queue_delay_time_ms * 1000)) {
         last_time_check = us_ticker_read(); // reset timeout
         if(!flush) allow_fetch = true;
-        return;
+    }
+
+    // get the block the step ticker takes next ready while the current one executes, unless it is being replanned
+    if(allow_fetch && !replanning) {
+        planning= true;
+        prepare_next_block();
+        planning= false;
     }
 }
 
@@ -224,10 +279,19 @@ bool Conveyor::get_next_block(Block **block)
     // wait for queue to fill up, optimizes planning
     if(!allow_fetch) return false;
 
+    // the feed hold stops before this block
+    if(holding && queue.isr_tail_i == hold_i) return false;
+
     Block *b= queue.item_ref(queue.isr_tail_i);
     // we cannot use this now if it is being updated
     if(!b->locked) {
         if(!b->is_ready) __debugbreak(); // should never happen
+        // it is prepared in check_queue() while the previous block executes, if the main loop has fallen behind it is prepared
+        // in PendSV as soon as this interrupt returns and the step ticker takes it on the next tick
+        if(!b->prepared) {
+            if(!planning) THEKERNEL->step_ticker->pend_finish();
+            return false;
+        }
 
         b->is_ticking= true;
         b->recalculate_flag= false;
@@ -239,6 +303,294 @@ bool Conveyor::get_next_block(Block **block)
     return false;
 }
 
+// work out the trapezoid of the block and convert it to the tick info the step ticker uses
+// its exit speed is the entry speed of the block after it, after this the planner leaves the block alone, so it is only done once
+void Conveyor::prepare_block(unsigned int index)
+{
+    Block *b= queue.item_ref(index);
+    float exit_speed= next_entry_speed(index);
+
+    // the step ticker must not take the block while it is being updated
+    b->locked= true;
+    b->set_tick_info_slot(index & 1);
+    if(b->kinematic) b->prepare_waypoints();
+    b->calculate_trapezoid(b->entry_speed, exit_speed);
+    b->prepared= true;
+    b->locked= false;
+}
+
+// prepare the block the step ticker will take next, as late as possible so the planner can still raise its exit speed
+void Conveyor::prepare_next_block()
+{
+    unsigned int index= queue.isr_tail_i;
+    if(index != queue.head_i && queue.item_ref(index)->is_ticking) index= queue.next(index);
+    if(index == queue.head_i || queue.item_ref(index)->prepared) return;
+    // it starts again from a standstill after the feed hold
+    if(holding && index == hold_i) return;
+
+    prepare_block(index);
+}
+
+// PendSV, the step ticker needs a block the main loop has not prepared yet
+// the main loop cannot run until this returns, unless it is part way through planning the queue it is safe to prepare it here
+void Conveyor::prepare_late_block()
+{
+    if(planning || !allow_fetch || replanning) return;
+    prepare_next_block();
+}
+
+// the speed the block after the one at index enters at, the head block has been planned if it is being appended
+float Conveyor::next_entry_speed(unsigned int index)
+{
+    unsigned int next= queue.next(index);
+    if(next == queue.head_i && !queue.item_ref(next)->is_ready) return THEKERNEL->planner->get_minimum_planner_speed();
+    return queue.item_ref(next)->entry_speed;
+}
+
+/*
+ * The feed override
+ *
+ * The blocks in the queue that have not been prepared are given new nominal speeds and planned again, see Planner::set_feed_override().
+ * In the fixed tick mode the rest of the executing block is replanned too, so the new speed takes effect within REPLAN_LEAD_MS,
+ * as the next block is planned to start at the speed the executing one now finishes at, it is unprepared and planned again with the queue.
+ */
+void Conveyor::apply_feed_override()
+{
+    float factor= feed_override;
+    Planner *planner= THEKERNEL->planner;
+    Block *b= next_replan_block();
+    float speed= predict_rest_of_block(b);
+    if(speed < 0.0F) {
+        planner->set_feed_override(factor);
+        planner->replan();
+        return;
+    }
+
+    Block *current= queue.item_ref(queue.isr_tail_i);
+    unprepare_next_block();
+    planner->set_feed_override(factor);
+
+    // it can finish anywhere from the slowest it can slow down to, to the fastest it can speed up to, up to the new nominal speed
+    float nominal_speed= current->override_speed(factor);
+    float min_exit= Block::min_exit_speed(b->acceleration, speed, b->millimeters, b->jerk);
+    float max_exit= std::min(Block::max_allowable_speed(-b->acceleration, speed, b->millimeters, b->jerk), std::max(nominal_speed, min_exit));
+
+    replanned= current;
+    replanned_exit_speed= current->exit_speed;
+    current->exit_speed= max_exit;
+    planner->replan(min_exit);
+
+    float exit_speed= std::min(std::max(next_entry_speed(queue.isr_tail_i), min_exit), max_exit);
+    start_rest_of_block(b, speed, nominal_speed, exit_speed, false);
+}
+
+// turn about so the replan block the step ticker is executing is never overwritten
+Block *Conveyor::next_replan_block()
+{
+    Block *b= &replan_block[(THEKERNEL->step_ticker->get_current_block() == &replan_block[0]) ? 1 : 0];
+    b->set_tick_info_slot(Block::k_replan_slot + (b == &replan_block[0] ? 0 : 1));
+    return b;
+}
+
+// work out the rest of the executing block into b, from the tick the step ticker can swap to it
+// returns the speed it will be going then, or -1 if it cannot be replanned, then it finishes as planned
+float Conveyor::predict_rest_of_block(Block *b)
+{
+    if(queue.isr_tail_i == queue.head_i || !queue.item_ref(queue.isr_tail_i)->is_ticking) return -1.0F;
+
+    // work out where the executing block will be at the tick the rest of it starts
+    StepTicker *st= THEKERNEL->step_ticker;
+    if(!st->predict_current_block(b, REPLAN_LEAD_MS * st->get_frequency() / 1000, REPLAN_MIN_MS * st->get_frequency() / 1000)) return -1.0F;
+
+    // the rest is a block of its own, from the speed of the longest axis then
+    uint8_t longest= b->tick_info_block->active_actuators[0];
+    uint32_t steps_left= 0;
+    for (uint8_t i = 0; i < b->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= b->tick_info_block->active_actuators[i];
+        uint32_t left= b->steps_left(m);
+        if(left > steps_left) {
+            steps_left= left;
+            longest= m;
+        }
+    }
+    if(steps_left == 0) return -1.0F;
+
+    float mm_per_step= b->millimeters / b->steps[longest];
+    float speed= b->get_trapezoid_rate(longest) * mm_per_step;
+    for (uint8_t m = 0; m < Block::n_actuators; m++) {
+        b->steps[m]= (b->steps[m] == 0) ? 0 : b->steps_left(m);
+    }
+    b->steps_event_count= steps_left;
+    b->millimeters= steps_left * mm_per_step;
+    return speed;
+}
+
+// the next block starts at the speed the executing one now finishes at, it is planned again along with the queue
+// it cannot be ticking yet, the executing block has at least REPLAN_MIN_MS left
+void Conveyor::unprepare_next_block()
+{
+    unsigned int next_i= queue.next(queue.isr_tail_i);
+    if(next_i == queue.head_i) return;
+
+    Block *next= queue.item_ref(next_i);
+    next->locked= true;
+    next->prepared= false;
+    next->locked= false;
+}
+
+// plan the rest of the executing block in b and have the step ticker swap to it, the exit speed of the block in the queue is set to match
+// if park is set b is only the first part of the rest, when it finishes the block in the queue is not finished, see plan_hold()
+void Conveyor::start_rest_of_block(Block *b, float speed, float nominal_speed, float exit_speed, bool park)
+{
+    // carry on from where the counters will be so the steps are evenly spaced across the change
+    // the counters are for the step pulses a tick the motors are given then, the rest may start with a different number
+    int64_t counter[k_max_actuators];
+    uint8_t multi_step[k_max_actuators];
+    for (uint8_t i = 0; i < b->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= b->tick_info_block->active_actuators[i];
+        counter[m]= b->tick_info[m].counter;
+        multi_step[m]= b->tick_info[m].multi_step;
+    }
+
+    if(b->jerk <= 0.0F) {
+        // the trapezoid goes through the nominal speed, if it is below both ends it must be high enough to get back up in time
+        float v2= (speed * speed + exit_speed * exit_speed) / 2.0F - b->acceleration * b->millimeters;
+        if(v2 > nominal_speed * nominal_speed) nominal_speed= sqrtf(v2);
+    }
+    b->nominal_speed= nominal_speed;
+    b->nominal_rate= b->steps_event_count * nominal_speed / b->millimeters;
+    b->is_ticking= false;
+    b->calculate_trapezoid(speed, exit_speed);
+
+    for (uint8_t i = 0; i < b->tick_info_block->n_active_actuators; i++) {
+        uint8_t m= b->tick_info_block->active_actuators[i];
+        b->tick_info[m].counter= Block::rescale_counter(counter[m], multi_step[m], b->tick_info[m].multi_step);
+    }
+    b->is_ticking= true;
+
+    queue.item_ref(queue.isr_tail_i)->exit_speed= exit_speed;
+    THEKERNEL->step_ticker->replan_current_block(b, park);
+    replanning= true;
+}
+
+// see if the step ticker has taken the replanned block, if it missed it the executing block finishes as it was planned
+void Conveyor::check_replan()
+{
+    StepTicker::REPLAN_STATE state= THEKERNEL->step_ticker->get_replan_state();
+    if(state == StepTicker::REPLAN_PENDING) return;
+
+    replanning= false;
+    if(state == StepTicker::REPLAN_DONE) {
+        if(parking) park_rest_of_block();
+        const Block *b= THEKERNEL->step_ticker->get_current_block();
+        if(b != nullptr) current_feedrate= b->nominal_speed;
+
+    } else {
+        bool executing= replanned == queue.item_ref(queue.isr_tail_i) && replanned->is_ticking;
+        if(executing) replanned->exit_speed= replanned_exit_speed;
+        if(holding) hold_planned= false; // plan the hold again
+        else if(executing) THEKERNEL->planner->replan();
+    }
+    parking= false;
+}
+
+/*
+ * The feed hold
+ *
+ * Without this a feed hold only stops new moves being queued, so everything already in the queue runs first.
+ * Instead the machine slows down at the acceleration it is set to from the tick the step ticker can swap to (see the feed override),
+ * if it can stop within the executing block the rest of that block is split in two, the step ticker executes the part that
+ * slows down to a stop and parks there, the block in the queue becomes the part after that and waits, along with the rest of the
+ * queue, until the hold is released. Otherwise the executing block slows down all the way, the blocks after it are planned to carry
+ * on slowing down (see Planner::plan_stop()) and the step ticker does not take the block after the one it stops in.
+ * If the executing block cannot be replanned (the event driven mode, or it is nearly done) the blocks already prepared finish
+ * as planned and the rest slow down from there, as the step ticker moves on to the next block it is tried again in that one.
+ * On resume the blocks get their speeds back and the block after the stop starts from a standstill.
+ */
+void Conveyor::plan_hold()
+{
+    Planner *planner= THEKERNEL->planner;
+    holding= true;
+    hold_planned= true;
+    hold_from_i= queue.isr_tail_i;
+
+    Block *b= next_replan_block();
+    float speed= predict_rest_of_block(b);
+    if(speed < 0.0F) {
+        hold_i= planner->plan_stop();
+        return;
+    }
+
+    Block *current= queue.item_ref(queue.isr_tail_i);
+    replanned= current;
+    replanned_exit_speed= current->exit_speed;
+    unprepare_next_block();
+
+    float mm_per_step= b->millimeters / b->steps_event_count;
+    uint32_t stop_steps= ceilf(Block::stopping_distance(b->acceleration, speed, b->jerk) / mm_per_step);
+    if(stop_steps < b->steps_event_count) {
+        // it stops part way, each motor makes its share of the steps to there, the rest are left for after the hold
+        uint32_t steps_left= b->steps_event_count;
+        for (uint8_t m = 0; m < Block::n_actuators; m++) {
+            uint32_t n= ((uint64_t)b->steps[m] * stop_steps + steps_left / 2) / steps_left;
+            park_steps[m]= b->steps[m] - n;
+            b->steps[m]= n;
+        }
+        b->steps_event_count= stop_steps;
+        b->millimeters= stop_steps * mm_per_step;
+
+        hold_i= queue.isr_tail_i;
+        parking= true;
+        start_rest_of_block(b, speed, speed, planner->get_minimum_planner_speed(), true);
+        return;
+    }
+
+    // it cannot stop in the executing block, it slows down all the way and the blocks after it carry on slowing down
+    float exit_speed= Block::min_exit_speed(b->acceleration, speed, b->millimeters, b->jerk);
+    current->exit_speed= exit_speed;
+    hold_i= planner->plan_stop(exit_speed);
+    start_rest_of_block(b, speed, speed, exit_speed, false);
+}
+
+// the step ticker has swapped to the part of the executing block that stops, the block in the queue becomes the rest of it
+void Conveyor::park_rest_of_block()
+{
+    Block *block= replanned;
+    uint32_t steps= 0;
+    for (uint8_t m = 0; m < Block::n_actuators; m++) {
+        steps= std::max(steps, park_steps[m]);
+    }
+
+    block->locked= true;
+    block->millimeters *= (float)steps / block->steps_event_count;
+    block->steps_event_count= steps;
+    for (uint8_t m = 0; m < Block::n_actuators; m++) {
+        block->steps[m]= park_steps[m];
+    }
+    // it starts again from a standstill, release_hold() puts its nominal speed back for the new length
+    block->is_ticking= false;
+    block->prepared= false;
+    block->cold()->max_junction_speed= 0.0F;
+    block->max_entry_speed= block->entry_speed= THEKERNEL->planner->get_minimum_planner_speed();
+    block->locked= false;
+}
+
+// carry on after a feed hold
+void Conveyor::release_hold()
+{
+    Planner *planner= THEKERNEL->planner;
+    holding= false;
+
+    // the blocks get their speeds back, the one the step ticker stopped before starts from a standstill,
+    // if it has not got there yet it just speeds up again from where it is
+    planner->set_feed_override(feed_override);
+    if(queue.isr_tail_i == hold_i && (hold_i != queue.head_i || queue.item_ref(hold_i)->is_ready)) {
+        Block *block= queue.item_ref(hold_i);
+        if(!block->is_ticking) block->max_entry_speed= block->entry_speed= planner->get_minimum_planner_speed();
+    }
+    planner->replan();
+}
+
 // called from step ticker ISR when block is finished, do not do anything slow here
 void Conveyor::block_finished()
 {
@@ -9,8 +9,7 @@
 
 #include "libs/Module.h"
 #include "BlockQueue.h"
-
-class Block;
+#include "Block.h"
 
 class Conveyor : public Module
 {
@@ -25,6 +24,8 @@ public:
     void wait_for_idle(bool wait_for_motors=true);
     bool is_queue_empty() { return queue.is_empty(); };
     bool is_queue_full() { return queue.is_full(); };
+    unsigned int get_queued_blocks() const { return queue.count(); }
+    unsigned int get_free_blocks() const { return queue_size - 1 - queue.count(); }
     bool is_idle() const;
 
     // returns next available block writes it to block and returns true
@@ -34,14 +35,30 @@ public:
     void dump_queue(void);
     void flush_queue(void);
     float get_current_feedrate() const { return current_feedrate; }
+    size_t get_queue_size() const { return queue_size; }
     void force_queue() { check_queue(true); }
     void set_controlled_stop(bool f) { controlled_stop= f; }
+    // rescale the speed of the blocks in the queue, and the one executing, it is applied in on_idle()
+    void set_feed_override(float factor) { feed_override= factor; feed_override_changed= true; }
 
     friend class Planner; // for queue
 
 private:
     void check_queue(bool force= false);
     void queue_head_block(void);
+    void prepare_block(unsigned int index);
+    void prepare_next_block();
+    void prepare_late_block();
+    float next_entry_speed(unsigned int index);
+    void apply_feed_override();
+    Block *next_replan_block();
+    float predict_rest_of_block(Block *b);
+    void unprepare_next_block();
+    void start_rest_of_block(Block *b, float speed, float nominal_speed, float exit_speed, bool park);
+    void check_replan();
+    void plan_hold();
+    void park_rest_of_block();
+    void release_hold();
 
     using  Queue_t= BlockQueue;
     Queue_t queue;  // Queue of Blocks
@@ -49,12 +66,30 @@ private:
     uint32_t queue_delay_time_ms;
     size_t queue_size;
     float current_feedrate{0}; // actual nominal feedrate that current block is running at in mm/sec
+    float feed_override{1.0F};
+
+    // the rest of the executing block is replanned into one of these, turn about so the one executing is never overwritten
+    Block replan_block[2];
+    Block *replanned;          // the block in the queue that is being replanned
+    float replanned_exit_speed; // its exit speed before, if the step ticker misses the replan
+
+    // the feed hold stops before the block at hold_i, it was planned when the block at hold_from_i was executing
+    unsigned int hold_i;
+    unsigned int hold_from_i;
+    std::array<uint32_t, k_max_actuators> park_steps; // the steps left after the stop, when it stops part way through a block
 
     volatile struct {
         volatile bool running:1;
         volatile bool allow_fetch:1;
         volatile bool flush:1;
         volatile bool controlled_stop:1;
+        volatile bool feed_override_changed:1;
+        bool replanning:1;
+        bool holding:1;
+        bool hold_planned:1;
+        bool parking:1;
     };
+    // set while the main loop changes the plan of the queued blocks, prepare_late_block() leaves them alone then
+    volatile bool planning{false};
 
 };
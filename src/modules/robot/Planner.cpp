@@ -28,6 +28,7 @@ using namespace std;
 #define junction_deviation_checksum    CHECKSUM("junction_deviation")
 #define z_junction_deviation_checksum  CHECKSUM("z_junction_deviation")
 #define minimum_planner_speed_checksum CHECKSUM("minimum_planner_speed")
+#define s_curve_jerk_checksum          CHECKSUM("s_curve_jerk")
 
 // The Planner does the acceleration math for the queue of Blocks ( movements ).
 // It makes sure the speed stays within the configured constraints ( acceleration, junction_deviation, etc )
@@ -45,17 +46,38 @@ void Planner::config_load()
     this->junction_deviation = THEKERNEL->config->value(junction_deviation_checksum)->by_default(0.05F)->as_number();
     this->z_junction_deviation = THEKERNEL->config->value(z_junction_deviation_checksum)->by_default(NAN)->as_number(); // disabled by default
     this->minimum_planner_speed = THEKERNEL->config->value(minimum_planner_speed_checksum)->by_default(0.0f)->as_number();
+    this->jerk = THEKERNEL->config->value(s_curve_jerk_checksum)->by_default(0.0f)->as_number(); // disabled by default
 }
 
 
 // Append a block to the queue, compute it's speed factors
-bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors, float rate_mm_s, float distance, float *unit_vec, float acceleration, float s_value, bool g123)
+bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors, float rate_mm_s, float distance, float *unit_vec, float acceleration, float s_value, bool g123, float programmed_speed, float speed_limit, bool feed_override, const planner_arc_t *arc, const planner_kin_t *kin)
 {
+    // a block holds Block::k_max_steps for each actuator, a longer line is planned as that many equal blocks along it
+    // a native arc or kinematic line is made short enough by the robot, see Robot::fits_in_block()
+    if(arc == nullptr && kin == nullptr) {
+        uint32_t most= 0;
+        for (size_t i = 0; i < n_motors; i++) {
+            most= std::max(most, (uint32_t)labs(THEROBOT->actuators[i]->steps_to_target(actuator_pos[i])));
+        }
+        if(most > Block::k_max_steps) {
+            unsigned int n= most / Block::k_max_steps + 1;
+            ActuatorCoordinates start, piece;
+            for (size_t i = 0; i < n_motors; i++) start[i]= THEROBOT->actuators[i]->get_last_milestone();
+            for (unsigned int j = 1; j < n; j++) {
+                for (size_t i = 0; i < n_motors; i++) piece[i]= start[i] + (actuator_pos[i] - start[i]) * j / n;
+                append_block(piece, n_motors, rate_mm_s, distance / n, unit_vec, acceleration, s_value, g123, programmed_speed, speed_limit, feed_override);
+            }
+            return append_block(actuator_pos, n_motors, rate_mm_s, distance / n, unit_vec, acceleration, s_value, g123, programmed_speed, speed_limit, feed_override);
+        }
+    }
+
     // Create ( recycle ) a new block
     Block* block = THECONVEYOR->queue.head_ref();
 
     // Direction bits
-    bool has_steps = false;
+    block->direction_bits = 0;
+    bool has_steps = arc != nullptr || kin != nullptr; // a full circle ends where it started, and a delta tower can go there and back
     for (size_t i = 0; i < n_motors; i++) {
         int32_t steps = THEROBOT->actuators[i]->steps_to_target(actuator_pos[i]);
         // Update current position
@@ -65,7 +87,7 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
         }
 
         // find direction
-        block->direction_bits[i] = (steps < 0) ? 1 : 0;
+        if(steps < 0) block->direction_bits |= 1 << i;
         // save actual steps in block
         block->steps[i] = labs(steps);
     }
@@ -86,7 +108,7 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
 
     // use either regular junction deviation or z specific and see if a primary axis move
     block->primary_axis = true;
-    if(block->steps[ALPHA_STEPPER] == 0 && block->steps[BETA_STEPPER] == 0) {
+    if(arc == nullptr && kin == nullptr && block->steps[ALPHA_STEPPER] == 0 && block->steps[BETA_STEPPER] == 0) {
         if(block->steps[GAMMA_STEPPER] != 0) {
             // z only move
             if(!isnan(this->z_junction_deviation)) junction_deviation = this->z_junction_deviation;
@@ -107,11 +129,44 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
     }
 
     block->acceleration = acceleration; // save in block
+    block->jerk = this->jerk;
 
     // Max number of steps, for all axes
     auto mi = std::max_element(block->steps.begin(), block->steps.end());
     block->steps_event_count = *mi;
 
+    block->arc = arc != nullptr;
+    if(block->arc) {
+        Block::path_t *path = block->path();
+        // the first arc axis is ticked along the arc, in steps no longer than a step of either axis, see StepTicker::arc_tick()
+        float steps_per_mm0 = THEROBOT->actuators[arc->axis[0]]->get_steps_per_mm();
+        float steps_per_mm1 = THEROBOT->actuators[arc->axis[1]]->get_steps_per_mm();
+        path->path_steps = ceilf(arc->length * std::max(steps_per_mm0, steps_per_mm1));
+        block->steps_event_count = std::max(block->steps_event_count, path->path_steps);
+
+        // each of those turns the point on the arc through the same angle, in the steps of each axis
+        float theta = arc->angle / path->path_steps;
+        float half_sin = sinf(theta / 2.0F);
+        path->arc_cos_m1 = -2.0F * half_sin * half_sin; // cos - 1 without the loss of precision
+        path->arc_sin[0] = sinf(theta) * steps_per_mm0 / steps_per_mm1;
+        path->arc_sin[1] = sinf(theta) * steps_per_mm1 / steps_per_mm0;
+        path->arc_start[0] = arc->start[0] * steps_per_mm0;
+        path->arc_start[1] = arc->start[1] * steps_per_mm1;
+        path->arc_axis[0] = arc->axis[0];
+        path->arc_axis[1] = arc->axis[1];
+    }
+
+    block->kinematic = kin != nullptr;
+    if(block->kinematic) {
+        Block::path_t *path = block->path();
+        // the first tower is ticked along the line, the towers follow the waypoints worked out when it is prepared, see Block::prepare_waypoints()
+        path->path_steps = kin->path_steps;
+        block->steps_event_count = std::max(block->steps_event_count, path->path_steps);
+        memcpy(path->kin_start, kin->start, sizeof(path->kin_start));
+        memcpy(path->kin_delta, kin->delta, sizeof(path->kin_delta));
+        path->kin_intervals = kin->n_intervals;
+    }
+
     block->millimeters = distance;
 
     // Calculate speed in mm/sec for each axis. No divide by zero due to previous checks.
@@ -122,6 +177,9 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
         block->nominal_speed = 0.0F;
         block->nominal_rate  = 0;
     }
+    block->cold()->programmed_speed = programmed_speed;
+    block->cold()->speed_limit = speed_limit;
+    block->feed_override = feed_override;
 
     // Compute the acceleration rate for the trapezoid generator. Depending on the slope of the line
     // average travel per step event changes. For a line along one axis the travel per step event
@@ -141,6 +199,7 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
     // NOTE however it does not take into account independent axis, in most cartesian X and Y and Z are totally independent
     // and this allows one to stop with little to no decleration in many cases. This is particualrly bad on leadscrew based systems that will skip steps.
     float vmax_junction = minimum_planner_speed; // Set default max junction speed
+    block->cold()->max_junction_speed = 0.0F;
 
     // if unit_vec was null then it was not a primary axis move so we skip the junction deviation stuff
     if (unit_vec != nullptr && !THECONVEYOR->is_queue_empty()) {
@@ -162,11 +221,13 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
             // Skip and use default max junction speed for 0 degree acute junction.
             if (cos_theta <= 0.9999F) {
                 vmax_junction = std::min(previous_nominal_speed, block->nominal_speed);
+                block->cold()->max_junction_speed = INFINITY;
                 // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
                 if (cos_theta >= -0.9999F) {
                     // Compute maximum junction velocity based on maximum acceleration and junction deviation
                     float sin_theta_d2 = sqrtf(0.5F * (1.0F - cos_theta)); // Trig half angle identity. Always positive.
-                    vmax_junction = std::min(vmax_junction, sqrtf(acceleration * junction_deviation * sin_theta_d2 / (1.0F - sin_theta_d2)));
+                    block->cold()->max_junction_speed = sqrtf(acceleration * junction_deviation * sin_theta_d2 / (1.0F - sin_theta_d2));
+                    vmax_junction = std::min(vmax_junction, block->cold()->max_junction_speed);
                 }
             }
         }
@@ -174,7 +235,7 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
     block->max_entry_speed = vmax_junction;
 
     // Initialize block entry speed. Compute based on deceleration to user-defined minimum_planner_speed.
-    float v_allowable = max_allowable_speed(-acceleration, minimum_planner_speed, block->millimeters);
+    float v_allowable = Block::max_allowable_speed(-acceleration, minimum_planner_speed, block->millimeters, block->jerk);
     block->entry_speed = std::min(vmax_junction, v_allowable);
 
     // Initialize planner efficiency flags
@@ -192,17 +253,21 @@ bool Planner::append_block( ActuatorCoordinates &actuator_pos, uint8_t n_motors,
     block->recalculate_flag = true;
 
     // Update previous path unit_vector and nominal speed
-    if(unit_vec != nullptr) {
+    if(arc != nullptr) {
+        memcpy(previous_unit_vec, arc->exit_unit_vec, sizeof(previous_unit_vec));
+    } else if(unit_vec != nullptr) {
         memcpy(previous_unit_vec, unit_vec, sizeof(previous_unit_vec)); // previous_unit_vec[] = unit_vec[]
     } else {
         memset(previous_unit_vec, 0, sizeof(previous_unit_vec));
     }
 
+    // The block can now be used, recalculate() plans it as the newest block in the queue
+    THECONVEYOR->planning= true;
+    block->ready();
+
     // Math-heavy re-computing of the whole queue to take the new
     this->recalculate();
-
-    // The block can now be used
-    block->ready();
+    THECONVEYOR->planning= false;
 
     THECONVEYOR->queue_head_block();
 
@@ -215,7 +280,6 @@ void Planner::recalculate()
 
     unsigned int block_index;
 
-    Block* previous;
     Block* current;
 
     /*
@@ -223,13 +287,13 @@ void Planner::recalculate()
      *
      * we find its max entry speed given its exit speed
      *
-     * for each block, walking backwards in the queue:
+     * for each block, walking backwards in the queue from the head to the planned block:
      *
-     * if max entry speed == current entry speed
-     * then we can set recalculate to false, since clearly adding another block didn't allow us to enter faster
-     * and thus we don't need to check entry speed for this block any more
+     * the planned block is the newest one whose entry speed can no longer change, either because it is accel limited
+     * or because it is already entering at its max entry speed, in both cases adding more blocks cannot let anything
+     * up to it go any faster, so we never need to look at it or the blocks before it again
      *
-     * once we find an accel limited block, we must find the max exit speed and walk the queue forwards
+     * once we reach the planned block, we must find its max exit speed and walk the queue forwards
      *
      * for each block, walking forwards in the queue:
      *
@@ -237,11 +301,13 @@ void Planner::recalculate()
      * we can tell if we're accel or decel limited (or coasting)
      *
      * if prev_exit > max_entry
-     *     then we're still decel limited. update previous trapezoid with our max entry for prev exit
+     *     then we're still decel limited. our max entry is the exit of the previous block
      * if max_entry >= prev_exit
-     *     then we're accel limited. set recalculate to false, work out max exit speed
+     *     then we're accel limited. this is now the planned block, work out max exit speed
      *
-     * finally, work out trapezoid for the final (and newest) block.
+     * the trapezoids are not worked out here, only the entry speeds, Conveyor::prepare_block() works out the trapezoid
+     * once when the block is about to be executed, after which the block is not changed again, most blocks are
+     * replanned many times before then.
      */
 
     /*
@@ -251,11 +317,18 @@ void Planner::recalculate()
 
     float entry_speed = minimum_planner_speed;
 
-    block_index = queue.head_i;
+    // the head block is only ready while it is being appended, otherwise the newest block is the one before it
+    unsigned int newest_i = queue.head_i;
+    if (!queue.item_ref(newest_i)->is_ready) {
+        if (queue.is_empty()) return;
+        newest_i = queue.prev(newest_i);
+    }
+
+    block_index = newest_i;
     current     = queue.item_ref(block_index);
 
-    if (!queue.is_empty()) {
-        while ((block_index != queue.tail_i) && current->recalculate_flag) {
+    {
+        while (block_index != queue.tail_i && block_index != queue.planned_i && !current->prepared) {
             entry_speed = current->reverse_pass(entry_speed);
 
             block_index = queue.prev(block_index);
@@ -264,17 +337,15 @@ void Planner::recalculate()
 
         /*
          * Step 2:
-         * now current points to either tail or first non-recalculate block
+         * now current points to either tail, the planned block or a block that has been prepared for execution
          * and has not had its reverse_pass called
-         * or its calculate_trapezoid
          * entry_speed is set to the *exit* speed of current.
          * each block from current to head has its entry speed set to its max entry speed- limited by decel or nominal_rate
          */
 
         float exit_speed = current->max_exit_speed();
 
-        while (block_index != queue.head_i) {
-            previous    = current;
+        while (block_index != newest_i) {
             block_index = queue.next(block_index);
             current     = queue.item_ref(block_index);
 
@@ -282,27 +353,139 @@ void Planner::recalculate()
             // so this block can decide if it's accel or decel limited and update its fields as appropriate
             exit_speed = current->forward_pass(exit_speed);
 
-            previous->calculate_trapezoid(previous->entry_speed, current->entry_speed);
+            // this block and everything before it is now fully planned
+            if (!current->recalculate_flag && block_index != newest_i) queue.planned_i = block_index;
         }
     }
+}
 
-    /*
-     * Step 3:
-     * work out trapezoid for final (and newest) block
-     */
+// sets the nominal speed of the block and the flag that goes with it, the max entry speed is up to the caller
+void Planner::set_nominal_speed(Block *block, float speed)
+{
+    block->nominal_speed = speed;
+    block->nominal_rate = block->steps_event_count * speed / block->millimeters;
+    block->nominal_length_flag = speed <= Block::max_allowable_speed(-block->acceleration, minimum_planner_speed, block->millimeters, block->jerk);
+}
+
+/*
+ * Rescale the nominal speeds of the blocks that have not been prepared yet for a new feed override factor
+ *
+ * each block keeps the speed the gcode asked for and the most the machine limits allow, the new nominal speed is
+ * the first times the factor, up to the limit, and the max entry speed is worked out again from the new nominal speeds
+ * the same way append_block() does. replan() must be called after this to work out the entry speeds again.
+ */
+void Planner::set_feed_override(float factor)
+{
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
 
-    // now current points to the head item
-    // which has not had calculate_trapezoid run yet
-    current->calculate_trapezoid(current->entry_speed, minimum_planner_speed);
+    // the head block is included if it is waiting to be appended
+    unsigned int end_i = queue.item_ref(queue.head_i)->is_ready ? queue.next(queue.head_i) : queue.head_i;
+    float previous_nominal_speed = 0;
+
+    for (unsigned int block_index = queue.isr_tail_i; block_index != end_i; block_index = queue.next(block_index)) {
+        Block *block = queue.item_ref(block_index);
+        float nominal_speed = block->override_speed(factor);
+
+        // the step ticker must not prepare the block while it is being updated
+        if (!block->prepared) {
+            block->locked = true;
+            if (!block->prepared) {
+                set_nominal_speed(block, nominal_speed);
+                if (block->cold()->max_junction_speed > 0.0F) {
+                    block->max_entry_speed = std::min(block->cold()->max_junction_speed, std::min(previous_nominal_speed, nominal_speed));
+                } else {
+                    block->max_entry_speed = minimum_planner_speed;
+                }
+            }
+            block->locked = false;
+        }
+
+        previous_nominal_speed = block->primary_axis ? nominal_speed : 0;
+    }
 }
 
+// finds the newest prepared block, the blocks after it are planned again from its exit speed
+// returns the index of the first block after it, and the index just past the newest block in end_i
+unsigned int Planner::first_unprepared(float &exit_speed, unsigned int &end_i)
+{
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
+
+    // the head block is included if it is waiting to be appended
+    end_i = queue.item_ref(queue.head_i)->is_ready ? queue.next(queue.head_i) : queue.head_i;
+    unsigned int block_index = queue.isr_tail_i;
+
+    exit_speed = 0.0F;
+    queue.planned_i = queue.tail_i;
+    while (block_index != end_i && queue.item_ref(block_index)->prepared) {
+        exit_speed = queue.item_ref(block_index)->exit_speed;
+        queue.planned_i = block_index;
+        block_index = queue.next(block_index);
+    }
+
+    return block_index;
+}
 
-// Calculates the maximum allowable speed at this point when you must be able to reach target_velocity using the
-// acceleration within the allotted distance.
-float Planner::max_allowable_speed(float acceleration, float target_velocity, float distance)
+/*
+ * Plan the blocks that have not been prepared yet again, after the nominal speeds have changed
+ *
+ * the newest prepared block finishes at a speed that can no longer change, if the nominal speeds have been lowered the
+ * blocks after it may not be able to slow down to them in time, so their nominal and max entry speeds are raised to
+ * the speed they can slow down to, before the queue is recalculated from there.
+ * exit_floor is the slowest the newest prepared block can finish at, if it is not its exit speed (the rest of it is being replanned)
+ */
+void Planner::replan(float exit_floor)
 {
-    // Was acceleration*60*60*distance, in case this breaks, but here we prefer to use seconds instead of minutes
-    return(sqrtf(target_velocity * target_velocity - 2.0F * acceleration * distance));
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
+
+    float speed;
+    unsigned int end_i;
+    unsigned int block_index = first_unprepared(speed, end_i);
+    if (exit_floor >= 0.0F) speed = exit_floor;
+
+    // the slowest each block after it can go is the speed it can slow down to from there
+    for (; block_index != end_i; block_index = queue.next(block_index)) {
+        Block *block = queue.item_ref(block_index);
+        if (speed > minimum_planner_speed) {
+            if (block->max_entry_speed < speed) block->max_entry_speed = speed;
+            if (block->nominal_speed < speed) set_nominal_speed(block, speed);
+            speed = Block::min_exit_speed(block->acceleration, speed, block->millimeters, block->jerk);
+        }
+        // the max entry speeds may have been lowered, so the reverse pass has to work every entry speed out again
+        block->entry_speed = 0.0F;
+    }
+
+    recalculate();
 }
 
+/*
+ * Plan the blocks that have not been prepared yet to slow down as fast as they can, for a feed hold
+ *
+ * from the exit speed of the newest prepared block (or exit_floor) each block gets the speed it can slow down to as its
+ * nominal and max entry speed, the block where that gets down to the minimum planner speed can not be entered any faster,
+ * so at the latest the stop is at the end of the block before it. Returns the index of that block.
+ * set_feed_override() puts the speeds back afterwards.
+ */
+unsigned int Planner::plan_stop(float exit_floor)
+{
+    Conveyor::Queue_t &queue = THECONVEYOR->queue;
+
+    float speed;
+    unsigned int end_i;
+    unsigned int block_index = first_unprepared(speed, end_i);
+    if (exit_floor >= 0.0F) speed = exit_floor;
+
+    for (; block_index != end_i; block_index = queue.next(block_index)) {
+        Block *block = queue.item_ref(block_index);
+        block->entry_speed = 0.0F;
+        if (speed <= minimum_planner_speed) {
+            block->max_entry_speed = minimum_planner_speed;
+            break;
+        }
+        block->max_entry_speed = speed;
+        set_nominal_speed(block, speed);
+        speed = Block::min_exit_speed(block->acceleration, speed, block->millimeters, block->jerk);
+    }
 
+    recalculate();
+    return block_index;
+}
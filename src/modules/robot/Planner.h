@@ -11,22 +11,49 @@
 #include "ActuatorCoordinates.h"
 class Block;
 
+// a G2/G3 on a cartesian machine that the step ticker interpolates itself as one block, see Robot::append_arc()
+struct planner_arc_t {
+    uint8_t axis[2];                      // the actuators of the plane the arc is in
+    float start[2];                       // from the centre to the start, in mm
+    float angle;                          // the angle it turns through, counter clockwise is positive
+    float length;                         // the length of the arc in the plane, in mm
+    float exit_unit_vec[N_PRIMARY_AXIS];  // the direction it finishes in, for the junction with the next move
+};
+
+// a line on a linear delta that the step ticker moves the towers along itself as one block, see Robot::append_kinematic_line()
+struct planner_kin_t {
+    float start[3];                       // where the line starts, in mm
+    float delta[3];                       // and how far it goes
+    float ratio[3];                       // the most each tower moves per mm along the line, between any two waypoints
+    uint32_t path_steps;                  // the steps along the line, no longer than a step of any tower
+    uint8_t n_intervals;                  // the waypoints the line is cut into, evenly spaced
+};
+
 class Planner
 {
 public:
     Planner();
-    float max_allowable_speed( float acceleration, float target_velocity, float distance);
+    float get_minimum_planner_speed() const { return minimum_planner_speed; }
+
+    // the feed override, see Conveyor::set_feed_override()
+    void set_feed_override(float factor);
+    void replan(float exit_floor= -1.0F);
+    // the feed hold, see Conveyor::plan_hold()
+    unsigned int plan_stop(float exit_floor= -1.0F);
 
-    friend class Robot; // for acceleration, junction deviation, minimum_planner_speed
+    friend class Robot; // for acceleration, junction deviation, minimum_planner_speed, jerk
 
 private:
-    bool append_block(ActuatorCoordinates &target, uint8_t n_motors, float rate_mm_s, float distance, float unit_vec[], float accleration, float s_value, bool g123);
+    bool append_block(ActuatorCoordinates &target, uint8_t n_motors, float rate_mm_s, float distance, float unit_vec[], float accleration, float s_value, bool g123, float programmed_speed, float speed_limit, bool feed_override, const planner_arc_t *arc= nullptr, const planner_kin_t *kin= nullptr);
     void recalculate();
+    void set_nominal_speed(Block *block, float speed);
+    unsigned int first_unprepared(float &exit_speed, unsigned int &end_i);
     void config_load();
     float previous_unit_vec[N_PRIMARY_AXIS];
     float junction_deviation;    // Setting
     float z_junction_deviation;  // Setting
     float minimum_planner_speed; // Setting
+    float jerk;                  // Setting, 0 is constant acceleration
 };
 
 
@@ -11,6 +11,7 @@
 #include "Robot.h"
 #include "Planner.h"
 #include "Conveyor.h"
+#include "Block.h"
 #include "Pin.h"
 #include "StepperMotor.h"
 #include "Gcode.h"
@@ -25,6 +26,7 @@
 #include "arm_solutions/CoreXZSolution.h"
 #include "arm_solutions/MorganSCARASolution.h"
 #include "StepTicker.h"
+#include "InputShaper.h"
 #include "checksumm.h"
 #include "utils.h"
 #include "ConfigValue.h"
@@ -48,7 +50,13 @@
 #define  delta_segments_per_second_checksum  CHECKSUM("delta_segments_per_second")
 #define  mm_per_arc_segment_checksum         CHECKSUM("mm_per_arc_segment")
 #define  mm_max_arc_error_checksum           CHECKSUM("mm_max_arc_error")
+#define  mm_max_line_error_checksum          CHECKSUM("mm_max_line_error")
 #define  arc_correction_checksum             CHECKSUM("arc_correction")
+#define  native_arcs_checksum                CHECKSUM("native_arcs")
+#define  kinematic_lines_checksum            CHECKSUM("kinematic_lines")
+#define  merge_segments_tolerance_checksum   CHECKSUM("merge_segments_tolerance")
+#define  merge_segments_angle_checksum       CHECKSUM("merge_segments_angle")
+#define  move_queue_size_checksum            CHECKSUM("move_queue_size")
 #define  x_axis_max_speed_checksum           CHECKSUM("x_axis_max_speed")
 #define  y_axis_max_speed_checksum           CHECKSUM("y_axis_max_speed")
 #define  z_axis_max_speed_checksum           CHECKSUM("z_axis_max_speed")
@@ -116,6 +124,13 @@ Robot::Robot()
     memset(this->compensated_machine_position, 0, sizeof compensated_machine_position);
     this->arm_solution = NULL;
     seconds_per_minute = 60.0F;
+    feed_override_move= false;
+    last_spline_control[0]= last_spline_control[1]= NAN;
+    merge.pending= false;
+    move_queue= nullptr;
+    move_queue_size= move_queue_head= move_queue_count= 0;
+    planning_queued_moves= false;
+    cut_when_full= move_cut_short= false;
     this->clearToolOffset();
     this->compensationTransform = nullptr;
     this->get_e_scale_fnc= nullptr;
@@ -131,6 +146,8 @@ Robot::Robot()
 void Robot::on_module_loaded()
 {
     this->register_for_event(ON_GCODE_RECEIVED);
+    this->register_for_event(ON_IDLE);
+    this->register_for_event(ON_HALT);
 
     // Configuration
     this->load_config();
@@ -142,7 +159,10 @@ void Robot::on_module_loaded()
     CHECKSUM(X "_en_pin"),          \
     CHECKSUM(X "_steps_per_mm"),    \
     CHECKSUM(X "_max_rate"),        \
-    CHECKSUM(X "_acceleration")     \
+    CHECKSUM(X "_acceleration"),    \
+    CHECKSUM(X "_input_shaper"),    \
+    CHECKSUM(X "_input_shaper_frequency"), \
+    CHECKSUM(X "_input_shaper_damping")    \
 }
 
 void Robot::load_config()
@@ -153,6 +173,7 @@ void Robot::load_config()
     // Here we read the config to find out which arm solution to use
     if (this->arm_solution) delete this->arm_solution;
     int solution_checksum = get_checksum(THEKERNEL->config->value(arm_solution_checksum)->by_default("cartesian")->as_string());
+    bool linear_delta= false;
     // Note checksums are not const expressions when in debug mode, so don't use switch
     if(solution_checksum == hbot_checksum || solution_checksum == corexy_checksum) {
         this->arm_solution = new HBotSolution(THEKERNEL->config);
@@ -162,6 +183,7 @@ void Robot::load_config()
 
     } else if(solution_checksum == rostock_checksum || solution_checksum == kossel_checksum || solution_checksum == delta_checksum || solution_checksum ==  linear_delta_checksum) {
         this->arm_solution = new LinearDeltaSolution(THEKERNEL->config);
+        linear_delta= true;
 
     } else if(solution_checksum == rotatable_cartesian_checksum) {
         this->arm_solution = new RotatableCartesianSolution(THEKERNEL->config);
@@ -177,6 +199,7 @@ void Robot::load_config()
 
     } else {
         this->arm_solution = new CartesianSolution(THEKERNEL->config);
+        solution_checksum = cartesian_checksum;
     }
 
     this->feed_rate           = THEKERNEL->config->value(default_feed_rate_checksum   )->by_default(  100.0F)->as_number();
@@ -185,7 +208,21 @@ void Robot::load_config()
     this->delta_segments_per_second = THEKERNEL->config->value(delta_segments_per_second_checksum )->by_default(0.0f   )->as_number();
     this->mm_per_arc_segment  = THEKERNEL->config->value(mm_per_arc_segment_checksum  )->by_default(    0.0f)->as_number();
     this->mm_max_arc_error    = THEKERNEL->config->value(mm_max_arc_error_checksum    )->by_default(   0.01f)->as_number();
+    this->mm_max_line_error   = THEKERNEL->config->value(mm_max_line_error_checksum   )->by_default(    0.0f)->as_number();
     this->arc_correction      = THEKERNEL->config->value(arc_correction_checksum      )->by_default(    5   )->as_number();
+    // the step ticker can only follow an arc itself when the actuators are the axes
+    this->native_arcs         = THEKERNEL->config->value(native_arcs_checksum         )->by_default(false)->as_bool() && solution_checksum == cartesian_checksum;
+    // the step ticker works out where the towers of a linear delta go along a line from waypoints, see append_kinematic_line()
+    this->kinematic_lines     = THEKERNEL->config->value(kinematic_lines_checksum     )->by_default(false)->as_bool() && linear_delta;
+    this->merge_tolerance     = THEKERNEL->config->value(merge_segments_tolerance_checksum)->by_default(0.0F)->as_number();
+    this->merge_cos_angle     = cosf(THEKERNEL->config->value(merge_segments_angle_checksum)->by_default(10.0F)->as_number() * PI / 180.0F);
+
+    // the G0/G1 that are parsed ahead of the planner, see queue_move()
+    int n= THEKERNEL->config->value(move_queue_size_checksum)->by_default(16)->as_int();
+    this->move_queue_size     = std::min(std::max(n, 0), 255);
+    delete [] this->move_queue;
+    this->move_queue          = (move_queue_size > 0) ? new queued_move_t[move_queue_size] : nullptr;
+    this->move_queue_head     = this->move_queue_count= 0;
 
     // in mm/sec but specified in config as mm/min
     this->max_speeds[X_AXIS]  = THEKERNEL->config->value(x_axis_max_speed_checksum    )->by_default(60000.0F)->as_number() / 60.0F;
@@ -209,7 +246,7 @@ void Robot::load_config()
     this->s_value             = THEKERNEL->config->value(laser_module_default_power_checksum)->by_default(0.8F)->as_number();
 
      // Make our Primary XYZ StepperMotors, and potentially A B C
-    uint16_t const motor_checksums[][6] = {
+    uint16_t const motor_checksums[][9] = {
         ACTUATOR_CHECKSUMS("alpha"), // X
         ACTUATOR_CHECKSUMS("beta"),  // Y
         ACTUATOR_CHECKSUMS("gamma"), // Z
@@ -236,7 +273,7 @@ void Robot::load_config()
 
         if(!pins[0].connected() || !pins[1].connected()) { // step and dir must be defined, but enable is optional
             if(a <= Z_AXIS) {
-                THEKERNEL->streams->printf("FATAL: motor %c is not defined in config\n", 'X'+a);
+                THEKERNEL->streams->printf("FATAL: motor %c is not defined in config\n", (char)('X'+a));
                 n_motors= a; // we only have this number of motors
                 return;
             }
@@ -248,13 +285,28 @@ void Robot::load_config()
         uint8_t n= register_motor(sm);
         if(n != a) {
             // this is a fatal error
-            THEKERNEL->streams->printf("FATAL: motor %d does not match index %d\n", n, a);
+            THEKERNEL->streams->printf("FATAL: motor %d does not match index %d\n", n, (int)a);
             return;
         }
 
         actuators[a]->change_steps_per_mm(THEKERNEL->config->value(motor_checksums[a][3])->by_default(a == 2 ? 2560.0F : 80.0F)->as_number());
         actuators[a]->set_max_rate(THEKERNEL->config->value(motor_checksums[a][4])->by_default(30000.0F)->as_number()/60.0F); // it is in mm/min and converted to mm/sec
         actuators[a]->set_acceleration(THEKERNEL->config->value(motor_checksums[a][5])->by_default(NAN)->as_number()); // mm/secs²
+
+        // optional input shaper to cancel the ringing of the axis at the given frequency
+        string shaper_type= THEKERNEL->config->value(motor_checksums[a][6])->by_default("none")->as_string();
+        if(shaper_type != "none") {
+            float freq= THEKERNEL->config->value(motor_checksums[a][7])->by_default(40.0F)->as_number(); // Hz
+            float damping= THEKERNEL->config->value(motor_checksums[a][8])->by_default(0.1F)->as_number();
+            InputShaper *shaper= InputShaper::create(shaper_type.c_str(), freq, damping, THEKERNEL->step_ticker->get_frequency());
+            if(shaper == nullptr) {
+                THEKERNEL->streams->printf("WARNING: motor %c input shaper %s is not valid\n", (char)('X'+a), shaper_type.c_str());
+
+            } else if(!THEKERNEL->step_ticker->set_input_shaper(n, shaper)) {
+                THEKERNEL->streams->printf("WARNING: motor %c input shaper can not be used with event_driven_stepping\n", (char)('X'+a));
+                delete shaper;
+            }
+        }
     }
 
     check_max_actuator_speeds(); // check the configs are sane
@@ -448,15 +500,17 @@ Robot::wcs_t Robot::wcs2mcs(const Robot::wcs_t& pos) const
 
 // this does a sanity check that actuator speeds do not exceed steps rate capability
 // we will override the actuator max_rate if the combination of max_rate and steps/sec exceeds base_stepping_frequency
+// times the step pulses a motor can be given in one tick
 void Robot::check_max_actuator_speeds()
 {
+    float max_step_freq = (float)THEKERNEL->base_stepping_frequency * THEKERNEL->step_ticker->get_multi_step();
     for (size_t i = 0; i < n_motors; i++) {
         if(actuators[i]->is_extruder()) continue; //extruders are not included in this check
 
         float step_freq = actuators[i]->get_max_rate() * actuators[i]->get_steps_per_mm();
-        if (step_freq > THEKERNEL->base_stepping_frequency) {
-            actuators[i]->set_max_rate(floorf(THEKERNEL->base_stepping_frequency / actuators[i]->get_steps_per_mm()));
-            THEKERNEL->streams->printf("WARNING: actuator %d rate exceeds base_stepping_frequency * ..._steps_per_mm: %f, setting to %f\n", i, step_freq, actuators[i]->get_max_rate());
+        if (step_freq > max_step_freq) {
+            actuators[i]->set_max_rate(floorf(max_step_freq / actuators[i]->get_steps_per_mm()));
+            THEKERNEL->streams->printf("WARNING: actuator %d rate exceeds base_stepping_frequency * ..._steps_per_mm: %f, setting to %f\n", (int)i, step_freq, actuators[i]->get_max_rate());
         }
     }
 }
@@ -467,6 +521,12 @@ void Robot::on_gcode_received(void *argument)
 {
     Gcode *gcode = static_cast<Gcode *>(argument);
 
+    // anything but another G0 or G1 gets the moves queued ahead of it planned first, so it happens in order
+    if(move_queue_count > 0 && !(gcode->has_g && gcode->g <= 1)) flush_queued_moves();
+
+    // anything but another G1 gets the merged move queued first, so it happens in order
+    if(merge.pending && !(gcode->has_g && gcode->g == 1)) flush_merged_move();
+
     enum MOTION_MODE_T motion_mode= NONE;
 
     if( gcode->has_g) {
@@ -475,6 +535,7 @@ void Robot::on_gcode_received(void *argument)
             case 1:  motion_mode = LINEAR;  break;
             case 2:  motion_mode = CW_ARC;  break;
             case 3:  motion_mode = CCW_ARC; break;
+            case 5:  motion_mode = gcode->subcode == 1 ? QUADRATIC_SPLINE : CUBIC_SPLINE; break;
             case 4: { // G4 Dwell
                 uint32_t delay_ms = 0;
                 if (gcode->has_letter('P')) {
@@ -693,7 +754,7 @@ void Robot::on_gcode_received(void *argument)
                     }
 
                     THEKERNEL->conveyor->wait_for_idle();
-                    THEKERNEL->call_event(ON_ENABLE, (void *)bm);
+                    THEKERNEL->call_event(ON_ENABLE, (void *)(uintptr_t)bm);
                     break;
                 }
                 // fall through
@@ -736,12 +797,12 @@ void Robot::on_gcode_received(void *argument)
             case 203: // M203 Set maximum feedrates in mm/sec, M203.1 set maximum actuator feedrates
                     if(gcode->get_num_args() == 0) {
                         for (size_t i = X_AXIS; i <= Z_AXIS; i++) {
-                            gcode->stream->printf(" %c: %g ", 'X' + i, gcode->subcode == 0 ? this->max_speeds[i] : actuators[i]->get_max_rate());
+                            gcode->stream->printf(" %c: %g ", (char)('X' + i), gcode->subcode == 0 ? this->max_speeds[i] : actuators[i]->get_max_rate());
                         }
                         if(gcode->subcode == 1) {
                             for (size_t i = A_AXIS; i < n_motors; i++) {
                                 if(actuators[i]->is_extruder()) continue; //extruders handle this themselves
-                                gcode->stream->printf(" %c: %g ", 'A' + i - A_AXIS, actuators[i]->get_max_rate());
+                                gcode->stream->printf(" %c: %g ", (char)('A' + i - A_AXIS), actuators[i]->get_max_rate());
                             }
                         }else{
                             gcode->stream->printf(" S: %g ", this->max_speed);
@@ -808,7 +869,7 @@ void Robot::on_gcode_received(void *argument)
                 }
                 break;
 
-            case 205: // M205 Xnnn - set junction deviation, Z - set Z junction deviation, Snnn - Set minimum planner speed
+            case 205: // M205 Xnnn - set junction deviation, Z - set Z junction deviation, Snnn - Set minimum planner speed, Jnnn - Set S-curve jerk
                 if (gcode->has_letter('X')) {
                     float jd = gcode->get_value('X');
                     // enforce minimum
@@ -830,6 +891,13 @@ void Robot::on_gcode_received(void *argument)
                         mps = 0.0F;
                     THEKERNEL->planner->minimum_planner_speed = mps;
                 }
+                if (gcode->has_letter('J')) {
+                    float jerk = gcode->get_value('J');
+                    // enforce minimum, 0 disables it
+                    if (jerk < 0.0F)
+                        jerk = 0.0F;
+                    THEKERNEL->planner->jerk = jerk;
+                }
                 break;
 
             case 211: // M211 Sn turns soft endstops on/off
@@ -854,15 +922,7 @@ void Robot::on_gcode_received(void *argument)
 
             case 220: // M220 - speed override percentage
                 if (gcode->has_letter('S')) {
-                    float factor = gcode->get_value('S');
-                    // enforce minimum 10% speed
-                    if (factor < 10.0F)
-                        factor = 10.0F;
-                    // enforce maximum 10x speed
-                    if (factor > 1000.0F)
-                        factor = 1000.0F;
-
-                    seconds_per_minute = 6000.0F / factor;
+                    set_speed_override(gcode->get_value('S'));
                 } else {
                     gcode->stream->printf("Speed factor at %6.2f %%\n", 6000.0F / seconds_per_minute);
                 }
@@ -891,7 +951,7 @@ void Robot::on_gcode_received(void *argument)
                 }
                 gcode->stream->printf("\n");
 
-                gcode->stream->printf(";X- Junction Deviation, Z- Z junction deviation, S - Minimum Planner speed mm/sec:\nM205 X%1.5f Z%1.5f S%1.5f\n", THEKERNEL->planner->junction_deviation, isnan(THEKERNEL->planner->z_junction_deviation)?-1:THEKERNEL->planner->z_junction_deviation, THEKERNEL->planner->minimum_planner_speed);
+                gcode->stream->printf(";X- Junction Deviation, Z- Z junction deviation, S - Minimum Planner speed mm/sec, J - S-curve jerk mm/sec^3:\nM205 X%1.5f Z%1.5f S%1.5f J%1.5f\n", THEKERNEL->planner->junction_deviation, isnan(THEKERNEL->planner->z_junction_deviation)?-1:THEKERNEL->planner->z_junction_deviation, THEKERNEL->planner->minimum_planner_speed, THEKERNEL->planner->jerk);
 
                 gcode->stream->printf(";Max cartesian feedrates in mm/sec:\nM203 X%1.5f Y%1.5f Z%1.5f S%1.5f\n", this->max_speeds[X_AXIS], this->max_speeds[Y_AXIS], this->max_speeds[Z_AXIS], this->max_speed);
 
@@ -981,6 +1041,7 @@ void Robot::on_gcode_received(void *argument)
 
     if( motion_mode != NONE) {
         is_g123= motion_mode != SEEK;
+        feed_override_move= true;
         process_move(gcode, motion_mode);
 
     }else{
@@ -990,6 +1051,20 @@ void Robot::on_gcode_received(void *argument)
     next_command_is_MCS = false; // must be on same line as G0 or G1
 }
 
+// sets the speed override percentage, it also applies to the moves already in the queue, and the one executing in the fixed tick mode
+void Robot::set_speed_override(float factor)
+{
+    // enforce minimum 10% speed
+    if (factor < 10.0F)
+        factor = 10.0F;
+    // enforce maximum 10x speed
+    if (factor > 1000.0F)
+        factor = 1000.0F;
+
+    seconds_per_minute = 6000.0F / factor;
+    THECONVEYOR->set_feed_override(factor / 100.0F);
+}
+
 int Robot::get_active_extruder() const
 {
     for (int i = E_AXIS; i < n_motors; ++i) {
@@ -1021,9 +1096,12 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
         }
     }
 
+    // the move starts where the last one queued ahead of the planner ends, if there are any
+    const float *start= (move_queue_count > 0) ? move_queue[(move_queue_head + move_queue_count - 1) % move_queue_size].target : machine_position;
+
     // calculate target in machine coordinates (less compensation transform which needs to be done after segmentation)
     float target[n_motors];
-    memcpy(target, machine_position, n_motors*sizeof(float));
+    memcpy(target, start, n_motors*sizeof(float));
 
     if(!next_command_is_MCS) {
         if(this->absolute_mode) {
@@ -1043,7 +1121,7 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
         }else{
             // they are deltas from the machine_position if specified
             for(int i= X_AXIS; i <= Z_AXIS; ++i) {
-                if(!isnan(param[i])) target[i] = param[i] + machine_position[i];
+                if(!isnan(param[i])) target[i] = param[i] + start[i];
             }
         }
 
@@ -1068,10 +1146,10 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
     if(selected_extruder > 0 && !isnan(param[E_AXIS])) {
         if(this->e_absolute_mode) {
             target[selected_extruder]= param[E_AXIS];
-            delta_e= target[selected_extruder] - machine_position[selected_extruder];
+            delta_e= target[selected_extruder] - start[selected_extruder];
         }else{
             delta_e= param[E_AXIS];
-            target[selected_extruder] = delta_e + machine_position[selected_extruder];
+            target[selected_extruder] = delta_e + start[selected_extruder];
         }
     }
 
@@ -1083,7 +1161,7 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
             if(this->absolute_mode) {
                 target[i]= p;
             }else{
-                target[i]= p + machine_position[i];
+                target[i]= p + start[i];
             }
         }
     }
@@ -1106,18 +1184,40 @@ void Robot::process_move(Gcode *gcode, enum MOTION_MODE_T motion_mode)
         case NONE: break;
 
         case SEEK:
-            moved= this->append_line(gcode, target, this->seek_rate / seconds_per_minute, delta_e );
-            break;
+        case LINEAR: {
+            float rate_mm_s= (motion_mode == SEEK ? this->seek_rate : this->feed_rate) / seconds_per_minute;
+            // catch negative or zero feed rates and return the same error as GRBL does
+            if(rate_mm_s <= 0.0F) {
+                gcode->is_error= true;
+                gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+                break;
+            }
 
-        case LINEAR:
-            moved= this->append_line(gcode, target, this->feed_rate / seconds_per_minute, delta_e );
+            bool has_xy= gcode->has_letter('X') || gcode->has_letter('Y');
+            if(move_queue_size > 0) {
+                // machine_position moves on when it is planned
+                queue_move(target, rate_mm_s, delta_e, motion_mode == LINEAR, has_xy);
+            } else {
+                moved= this->append_line(target, rate_mm_s, delta_e, motion_mode == LINEAR, has_xy);
+            }
             break;
+        }
 
         case CW_ARC:
         case CCW_ARC:
             // Note arcs are not currently supported by extruder based machines, as 3D slicers do not use arcs (G2/G3)
             moved= this->compute_arc(gcode, offset, target, motion_mode);
             break;
+
+        case CUBIC_SPLINE:
+        case QUADRATIC_SPLINE:
+            moved= this->compute_spline(gcode, offset, target, motion_mode);
+            break;
+    }
+
+    // a G5 without I and J carries on from the one before, any other move breaks that
+    if(motion_mode != CUBIC_SPLINE) {
+        last_spline_control[0]= last_spline_control[1]= NAN;
     }
 
     if(moved) {
@@ -1219,7 +1319,8 @@ void Robot::reset_position_from_current_actuator_position()
 // Convert target (in machine coordinates) to machine_position, then convert to actuator position and append this to the planner
 // target is in machine coordinates without the compensation transform, however we save a compensated_machine_position that includes
 // all transforms and is what we actually convert to actuator positions
-bool Robot::append_milestone(const float target[], float rate_mm_s)
+// target_actuator is the XYZ actuator position of target if it was already worked out, see append_line()
+bool Robot::append_milestone(const float target[], float rate_mm_s, const planner_arc_t *arc, const ActuatorCoordinates *target_actuator, const planner_kin_t *kin)
 {
     float deltas[n_motors];
     float transformed_target[n_motors]; // adjust target for bed compensation
@@ -1283,11 +1384,11 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
         }
     }
 
-    // nothing moved
-    if(!move) return false;
+    // nothing moved, a full circle arc does move though
+    if(!move && arc == nullptr) return false;
 
     // see if this is a primary axis move or not
-    bool auxilliary_move= true;
+    bool auxilliary_move= arc == nullptr;
     for (int i = 0; i < N_PRIMARY_AXIS; ++i) {
         if(fabsf(deltas[i]) >= 0.00001F) {
             auxilliary_move= false;
@@ -1296,12 +1397,18 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
     }
 
     // total movement, use XYZ if a primary axis otherwise we calculate distance for E after scaling to mm
-    float distance= auxilliary_move ? 0 : sqrtf(sos);
+    // an arc travels along the circle not the chord
+    float distance= auxilliary_move ? 0 : arc != nullptr ? hypotf(arc->length, deltas[plane_axis_2]) : sqrtf(sos);
 
     // it is unlikely but we need to protect against divide by zero, so ignore insanely small moves here
     // as the last milestone won't be updated we do not actually lose any moves as they will be accounted for in the next move
     if(!auxilliary_move && distance < 0.00001F) return false;
 
+    // the feed override rescales the requested rate of the moves in the queue, up to the fastest the limits below allow
+    // a feed hold slows the moves down, after it they go back to the requested rate
+    float programmed_speed= feed_override_move ? rate_mm_s * seconds_per_minute / 60.0F : rate_mm_s;
+    float speed_limit= INFINITY;
+
     if(!auxilliary_move) {
          for (size_t i = X_AXIS; i < N_PRIMARY_AXIS; i++) {
             // find distance unit vector for primary axis only
@@ -1309,22 +1416,38 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
 
             // Do not move faster than the configured cartesian limits for XYZ
             if ( i <= Z_AXIS && max_speeds[i] > 0 ) {
-                float axis_speed = fabsf(unit_vec[i] * rate_mm_s);
+                // an axis in the plane of an arc is at full speed somewhere on it
+                float axis_unit = (arc != nullptr && i != plane_axis_2) ? arc->length / distance : fabsf(unit_vec[i]);
+                float axis_speed = axis_unit * rate_mm_s;
 
                 if (axis_speed > max_speeds[i])
                     rate_mm_s *= ( max_speeds[i] / axis_speed );
+
+                if(axis_unit > 0) speed_limit= std::min(speed_limit, max_speeds[i] / axis_unit);
             }
         }
 
+        if(arc != nullptr) {
+            // the junction with the previous move is at the start of the arc, so it goes in along the tangent there
+            float tangent= (arc->angle > 0 ? 1 : -1) * fabsf(arc->angle) / distance;
+            unit_vec[plane_axis_0]= -arc->start[1] * tangent;
+            unit_vec[plane_axis_1]= arc->start[0] * tangent;
+        }
+
         if(this->max_speed > 0 && rate_mm_s > this->max_speed) {
             rate_mm_s= this->max_speed;
         }
+        if(this->max_speed > 0) speed_limit= std::min(speed_limit, this->max_speed);
     }
 
     // find actuator position given the machine position, use actual adjusted target
     ActuatorCoordinates actuator_pos;
     if(!disable_arm_solution) {
-        arm_solution->cartesian_to_actuator( transformed_target, actuator_pos );
+        if(target_actuator != nullptr) {
+            for (size_t i = X_AXIS; i <= Z_AXIS; i++) actuator_pos[i]= (*target_actuator)[i];
+        } else {
+            arm_solution->cartesian_to_actuator( transformed_target, actuator_pos );
+        }
         // some arm solutions can indicate a halt if the calcs go bad
         if(THEKERNEL->is_halted()) return false;
 
@@ -1368,6 +1491,8 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
     // check per-actuator speed limits
     for (size_t actuator = 0; actuator < n_motors; actuator++) {
         float d = fabsf(actuator_pos[actuator] - actuators[actuator]->get_last_milestone());
+        if(arc != nullptr && (actuator == plane_axis_0 || actuator == plane_axis_1)) d= arc->length; // at full speed somewhere on the arc
+        if(kin != nullptr && actuator <= GAMMA_STEPPER) d= kin->ratio[actuator] * distance; // a tower is fastest somewhere along the line
         if(d < 0.00001F || !actuators[actuator]->is_selected()) continue; // no realistic movement for this actuator
 
         float actuator_rate= d * isecs;
@@ -1376,6 +1501,7 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
             isecs = rate_mm_s / distance;
             DEBUG_PRINTF("new rate: %f - %d\n", rate_mm_s, actuator);
         }
+        speed_limit= std::min(speed_limit, actuators[actuator]->get_max_rate() * distance / d);
 
         DEBUG_PRINTF("act: %d, d: %f, distance: %f, actrate: %f, rate: %f, secs: %f, acc: %f\n", actuator, d, distance, actuator_rate, rate_mm_s, 1/isecs, acceleration);
 
@@ -1391,6 +1517,14 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
         }
     }
 
+    if(arc != nullptr) {
+        // keep the centripetal acceleration within the acceleration of the slowest axis of the arc
+        float radius= arc->length / fabsf(arc->angle);
+        float centripetal_limit= sqrtf(acceleration * radius) * distance / arc->length;
+        if(rate_mm_s > centripetal_limit) rate_mm_s= centripetal_limit;
+        speed_limit= std::min(speed_limit, centripetal_limit);
+    }
+
     // if we are in feed hold wait here until it is released, this means that even segmented lines will pause
     while(THEKERNEL->get_feed_hold()) {
         THEKERNEL->call_event(ON_IDLE, this);
@@ -1401,7 +1535,7 @@ bool Robot::append_milestone(const float target[], float rate_mm_s)
     // Append the block to the planner
     // NOTE that distance here should be either the distance travelled by the XYZ axis, or the E mm travel if a solo E move
     // NOTE this call will bock until there is room in the block queue, on_idle will continue to be called
-    if(THEKERNEL->planner->append_block( actuator_pos, n_motors, rate_mm_s, distance, auxilliary_move ? nullptr : unit_vec, acceleration, s_value, is_g123)) {
+    if(THEKERNEL->planner->append_block( actuator_pos, n_motors, rate_mm_s, distance, auxilliary_move ? nullptr : unit_vec, acceleration, s_value, is_g123, programmed_speed, speed_limit, feed_override_move, arc, kin)) {
         // this is the new compensated machine position
         memcpy(this->compensated_machine_position, transformed_target, n_motors*sizeof(float));
         return true;
@@ -1416,6 +1550,9 @@ bool Robot::delta_move(const float *delta, float rate_mm_s, uint8_t naxis)
 {
     if(THEKERNEL->is_halted()) return false;
 
+    // it moves from where the moves queued so far end
+    flush_queued_moves();
+
     // catch negative or zero feed rates
     if(rate_mm_s <= 0.0F) {
         return false;
@@ -1431,6 +1568,7 @@ bool Robot::delta_move(const float *delta, float rate_mm_s, uint8_t naxis)
     }
 
     is_g123= false; // we don't want the laser to fire
+    feed_override_move= false; // homing, probing etc must move at the rate they ask for
     // submit for planning and if moved update machine_position
     if(append_milestone(target, rate_mm_s)) {
          memcpy(machine_position, target, n_motors*sizeof(float));
@@ -1441,20 +1579,15 @@ bool Robot::delta_move(const float *delta, float rate_mm_s, uint8_t naxis)
 }
 
 // Append a move to the queue ( cutting it into segments if needed )
-bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, float delta_e)
+// is_g1 is false for a G0, has_xy is false if the gcode only gave Z (and E etc)
+bool Robot::append_line(const float target[], float rate_mm_s, float delta_e, bool is_g1, bool has_xy)
 {
-    // catch negative or zero feed rates and return the same error as GRBL does
-    if(rate_mm_s <= 0.0F) {
-        gcode->is_error= true;
-        gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
-        return false;
-    }
-
     // Find out the distance for this move in XYZ in MCS
     float millimeters_of_travel = sqrtf(powf( target[X_AXIS] - machine_position[X_AXIS], 2 ) +  powf( target[Y_AXIS] - machine_position[Y_AXIS], 2 ) +  powf( target[Z_AXIS] - machine_position[Z_AXIS], 2 ));
 
     if(millimeters_of_travel < 0.00001F) {
         // we have no movement in XYZ, probably E only extrude or retract
+        flush_merged_move();
         return this->append_milestone(target, rate_mm_s);
     }
 
@@ -1464,7 +1597,7 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
         We ask Extruder to do all the work but we need to pass in the relevant data.
         NOTE we need to do this before we segment the line (for deltas)
     */
-    if(!isnan(delta_e) && gcode->has_g && gcode->g == 1) {
+    if(!isnan(delta_e) && is_g1) {
         float data[2]= {delta_e, rate_mm_s / millimeters_of_travel};
         if(PublicData::set_value(extruder_checksum, target_checksum, data)) {
             rate_mm_s *= data[1]; // adjust the feedrate
@@ -1474,11 +1607,18 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
     // We cut the line into smaller segments. This is only needed on a cartesian robot for zgrid, but always necessary for robots with rotational axes like Deltas.
     // In delta robots either mm_per_line_segment can be used OR delta_segments_per_second
     // The latter is more efficient and avoids splitting fast long lines into very small segments, like initial z move to 0, it is what Johanns Marlin delta port does
+    // If mm_max_line_error is set the segments are cut as long as the actuators stay that close to moving in a straight line instead,
+    // so there are few where the arm solution is nearly linear and more where it curves, see append_curved_segments()
     uint16_t segments;
+    bool curved= false;
 
-    if(this->disable_segmentation || (!segment_z_moves && !gcode->has_letter('X') && !gcode->has_letter('Y'))) {
+    if(this->disable_segmentation || (!segment_z_moves && !has_xy)) {
         segments= 1;
 
+    } else if(this->mm_max_line_error > 0.0F) {
+        segments= 1;
+        curved= true;
+
     } else if(this->delta_segments_per_second > 1.0F) {
         // enabled if set to something > 1, it is set to 0.0 by default
         // segment based on current speed and requested segments per second
@@ -1496,8 +1636,23 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
         }
     }
 
+    if(segments == 1 && !curved && merge_tolerance > 0 && is_g1 && !compensationTransform) {
+        return merge_milestone(target, rate_mm_s);
+    }
+    flush_merged_move();
+
+    // instead of the segments a linear delta can be moved along the line by the step ticker, as few blocks as the waypoints fit in
+    bool kinematic= kinematic_lines && (curved || segments > 1) && !compensationTransform && !soft_endstop_enabled && !disable_arm_solution &&
+                    !THEKERNEL->step_ticker->is_event_driven();
+
     bool moved= false;
-    if (segments > 1) {
+    if(kinematic) {
+        moved= append_kinematic_line(target, rate_mm_s, millimeters_of_travel);
+
+    } else if(curved) {
+        moved= append_curved_segments(target, rate_mm_s, millimeters_of_travel);
+
+    } else if (segments > 1) {
         // A vector to keep track of the endpoint of each segment
         float segment_delta[n_motors];
         float segment_end[n_motors];
@@ -1509,20 +1664,39 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
 
         // segment 0 is already done - it's the end point of the previous move so we start at segment 1
         // We always add another point after this loop so we stop at segments-1, ie i < segments
-        for (int i = 1; i < segments; i++) {
-            if(THEKERNEL->is_halted()) return false; // don't queue any more segments
-            for (int j = 0; j < n_motors; j++)
-                segment_end[j] += segment_delta[j];
+        // The segment ends go to the arm solution a batch at a time, unless a compensation transform has to move them first
+        const int batch_size= 8;
+        float batch[batch_size][n_motors];
+        ActuatorCoordinates batch_actuator[batch_size];
+        bool batched= !compensationTransform && !disable_arm_solution;
+        float reached[n_motors];
+        memcpy(reached, machine_position, n_motors*sizeof(float));
+        for (int i = 1, n; i < segments; i += n) {
+            n= std::min(batch_size, segments - i);
+            // no more than will fit if it is to be cut short, see cut_short()
+            if(cut_when_full) n= std::min(n, std::max((int)THECONVEYOR->get_free_blocks() - 1, 1));
+            for (int k = 0; k < n; k++) {
+                for (int j = 0; j < n_motors; j++)
+                    segment_end[j] += segment_delta[j];
+                memcpy(batch[k], segment_end, n_motors*sizeof(float));
+            }
+            if(batched) arm_solution->cartesian_to_actuators(batch[0], n_motors, batch_actuator, n);
 
-            // Append the end of this segment to the queue
-            // this can block waiting for free block queue or if in feed hold
-            bool b= this->append_milestone(segment_end, rate_mm_s);
-            moved= moved || b;
+            for (int k = 0; k < n; k++) {
+                if(THEKERNEL->is_halted()) return false; // don't queue any more segments
+                if(cut_short(reached)) return moved;
+
+                // Append the end of this segment to the queue
+                // this can block waiting for free block queue or if in feed hold
+                bool b= this->append_milestone(batch[k], rate_mm_s, nullptr, batched ? &batch_actuator[k] : nullptr);
+                moved= moved || b;
+                memcpy(reached, batch[k], n_motors*sizeof(float));
+            }
         }
     }
 
     // Append the end of this full move to the queue
-    if(this->append_milestone(target, rate_mm_s)) moved= true;
+    if(!kinematic && this->append_milestone(target, rate_mm_s)) moved= true;
 
     this->next_command_is_MCS = false; // always reset this
 
@@ -1530,6 +1704,393 @@ bool Robot::append_line(Gcode *gcode, const float target[], float rate_mm_s, flo
 }
 
 
+// Append the segments of a line up to but not including the target, each as long as the actuators stay within mm_max_line_error of
+// moving in a straight line. The most an actuator strays over a segment of length ds is ds²/8 * its curvature, which is checked at
+// both ends of the segment. Segments are never shorter than 0.1mm, so a move near the edge of what the arm can reach is not cut up endlessly.
+bool Robot::append_curved_segments(const float target[], float rate_mm_s, float length)
+{
+    float unit_vec[N_PRIMARY_AXIS];
+    for (int i = X_AXIS; i <= Z_AXIS; ++i) unit_vec[i]= (target[i] - machine_position[i]) / length;
+
+    float start[n_motors], segment_end[n_motors], reached[n_motors];
+    memcpy(start, machine_position, n_motors*sizeof(float));
+    memcpy(reached, machine_position, n_motors*sizeof(float));
+
+    bool moved= false;
+    float s= 0;
+    float curvature= arm_solution->actuator_curvature(start, unit_vec);
+    while(true) {
+        if(THEKERNEL->is_halted()) return false; // don't queue any more segments
+
+        float ds= (curvature > 0) ? std::max(sqrtf(8.0F * mm_max_line_error / curvature), 0.1F) : length;
+        ds= std::min(ds, length - s);
+        for (int i = 0; i < n_motors; ++i) segment_end[i]= start[i] + (target[i] - start[i]) * (s + ds) / length;
+
+        // it may curve more at the other end
+        float curvature_end= arm_solution->actuator_curvature(segment_end, unit_vec);
+        if(curvature_end > curvature) {
+            ds= std::max(sqrtf(8.0F * mm_max_line_error / curvature_end), 0.1F);
+            if(s + ds < length) {
+                for (int i = 0; i < n_motors; ++i) segment_end[i]= start[i] + (target[i] - start[i]) * (s + ds) / length;
+                curvature_end= arm_solution->actuator_curvature(segment_end, unit_vec);
+            }
+        }
+
+        s += ds;
+        if(s >= length) break;
+        if(cut_short(reached)) return moved;
+
+        // Append the end of this segment to the queue
+        bool b= this->append_milestone(segment_end, rate_mm_s);
+        moved= moved || b;
+        memcpy(reached, segment_end, n_motors*sizeof(float));
+        curvature= curvature_end;
+    }
+
+    return moved;
+}
+
+// Append a line on a linear delta as kinematic lines, see StepTicker::kin_path_step(), the towers are moved between waypoints on
+// it that are spaced as append_curved_segments() spaces the segments, within mm_max_line_error of the line, or 0.01mm if that
+// is not set. As many as fit go into each block, evenly spaced as close together as any of them needs to be.
+bool Robot::append_kinematic_line(const float target[], float rate_mm_s, float length)
+{
+    float tolerance= (mm_max_line_error > 0.0F) ? mm_max_line_error : 0.01F;
+    float unit_vec[N_PRIMARY_AXIS];
+    for (int i = X_AXIS; i <= Z_AXIS; ++i) unit_vec[i]= (target[i] - machine_position[i]) / length;
+
+    float point[n_motors];
+    auto point_at= [&](float s) {
+        for (int i = 0; i < n_motors; ++i) point[i]= machine_position[i] + (target[i] - machine_position[i]) * s / length;
+    };
+    auto spacing= [&](float curvature) {
+        return (curvature > 0) ? std::max(sqrtf(8.0F * tolerance / curvature), 0.1F) : length;
+    };
+
+    bool moved= false;
+    float from= 0;         // where the block being filled starts
+    float to= 0;           // how far its waypoints go so far
+    float closest= length; // the closest any of them need to be
+    float curvature= arm_solution->actuator_curvature(machine_position, unit_vec);
+    while(to < length) {
+        if(THEKERNEL->is_halted()) return false; // don't queue any more blocks
+
+        float ds= std::min(spacing(curvature), length - to);
+        point_at(to + ds);
+        // it may curve more at the other end
+        float curvature_end= arm_solution->actuator_curvature(point, unit_vec);
+        if(curvature_end > curvature) {
+            ds= std::min(spacing(curvature_end), length - to);
+            point_at(to + ds);
+            curvature_end= arm_solution->actuator_curvature(point, unit_vec);
+        }
+
+        if(to > from && ceilf((to + ds - from) / std::min(closest, ds)) > Block::k_max_waypoints) {
+            // it does not fit in this block, so it starts the next one
+            point_at(from);
+            if(cut_short(point)) return moved;
+            point_at(to);
+            bool b= append_kinematic_block(point, std::min((int)ceilf((to - from) / closest), (int)Block::k_max_waypoints), rate_mm_s);
+            moved= moved || b;
+            from= to;
+            closest= ds;
+        } else {
+            closest= std::min(closest, ds);
+        }
+
+        to += ds;
+        curvature= curvature_end;
+    }
+
+    bool b= append_kinematic_block(target, std::min((int)ceilf((length - from) / closest), (int)Block::k_max_waypoints), rate_mm_s);
+    return moved || b;
+}
+
+// Append a kinematic line from the last milestone to end, the towers have to move no more than a step per step along it between
+// any two of its waypoints, the same ones Block::prepare_waypoints() works out
+bool Robot::append_kinematic_block(const float end[], uint8_t n_intervals, float rate_mm_s)
+{
+    planner_kin_t kin;
+    float sos= 0;
+    for (int i = X_AXIS; i <= Z_AXIS; ++i) {
+        kin.start[i]= compensated_machine_position[i];
+        kin.delta[i]= end[i] - kin.start[i];
+        sos += kin.delta[i] * kin.delta[i];
+    }
+    float length= sqrtf(sos);
+    kin.n_intervals= std::max(n_intervals, (uint8_t)1);
+
+    float points[Block::k_max_waypoints + 1][3];
+    ActuatorCoordinates actuator[Block::k_max_waypoints + 1];
+    for (int k = 0; k < kin.n_intervals; ++k) {
+        for (int i = X_AXIS; i <= Z_AXIS; ++i) points[k][i]= kin.start[i] + kin.delta[i] * k / kin.n_intervals;
+    }
+    memcpy(points[kin.n_intervals], end, sizeof(points[0]));
+    arm_solution->cartesian_to_actuators(points[0], 3, actuator, kin.n_intervals + 1);
+    if(THEKERNEL->is_halted()) return false;
+
+    float path_steps_per_mm= 0;
+    for (int m = ALPHA_STEPPER; m <= GAMMA_STEPPER; ++m) {
+        float most= 0;
+        for (int k = 1; k <= kin.n_intervals; ++k) most= std::max(most, fabsf(actuator[k][m] - actuator[k - 1][m]));
+        kin.ratio[m]= (length > 0.00001F) ? most * kin.n_intervals / length : 0;
+        path_steps_per_mm= std::max(path_steps_per_mm, kin.ratio[m] * actuators[m]->get_steps_per_mm());
+    }
+    kin.path_steps= std::max((uint32_t)ceilf(length * path_steps_per_mm), (uint32_t)kin.n_intervals);
+
+    // a line longer than a block holds is two, each with half the waypoints
+    if(!fits_in_block(end, kin.path_steps, (1 << ALPHA_STEPPER) | (1 << BETA_STEPPER) | (1 << GAMMA_STEPPER))) {
+        float middle[n_motors];
+        for (int i = 0; i < n_motors; ++i) middle[i]= (compensated_machine_position[i] + end[i]) / 2.0F;
+        uint8_t half= (kin.n_intervals + 1) / 2;
+        bool moved= append_kinematic_block(middle, half, rate_mm_s);
+        return append_kinematic_block(end, half, rate_mm_s) || moved;
+    }
+
+    return append_milestone(end, rate_mm_s, nullptr, &actuator[kin.n_intervals], &kin);
+}
+
+// a native arc or kinematic line is a single block, the steps along its path and of the actuators not on the path, the ones
+// not in path_mask, have to fit in one, see Planner::append_block()
+bool Robot::fits_in_block(const float target[], float path_steps, uint8_t path_mask) const
+{
+    if(path_steps >= Block::k_max_steps) return false;
+    for (size_t i = 0; i < n_motors; i++) {
+        if(path_mask & (1 << i)) continue;
+        float pos= target[i];
+        if(i > Z_AXIS && actuators[i]->is_extruder() && get_e_scale_fnc) pos *= get_e_scale_fnc();
+        if(fabsf(pos - actuators[i]->get_last_milestone()) * actuators[i]->get_steps_per_mm() >= Block::k_max_steps) return false;
+    }
+    return true;
+}
+
+/*
+    Merging G1
+
+    A G1 is held back instead of being queued, and while the G1 after it carry on in nearly the same direction they are
+    merged into it, as long as each end merged away stays within merge_segments_tolerance of the merged move, and the
+    other axis (E etc) move in the same proportion to it so they can be spread along it. The merged move is queued when
+    a G1 does not fit, any other command comes in, or the queue is running low.
+*/
+bool Robot::merge_milestone(const float target[], float rate_mm_s)
+{
+    float delta[n_motors];
+    float sos= 0;
+    for (int i = 0; i < n_motors; ++i) {
+        delta[i]= target[i] - machine_position[i];
+        if(i < N_PRIMARY_AXIS) sos += delta[i] * delta[i];
+    }
+    float length= sqrtf(sos);
+
+    if(merge.pending && merge.n_points < MAX_MERGED_SEGMENTS && rate_mm_s == merge.rate_mm_s && s_value == merge.s_value) {
+        bool fits= true;
+
+        // it must not turn by more than the angle
+        float dot= 0;
+        for (int i = 0; i < N_PRIMARY_AXIS; ++i) dot += merge.unit_vec[i] * delta[i] / length;
+        if(dot < merge_cos_angle) fits= false;
+
+        // the ends merged away, and the end of the held move, must be close to the line from the start to the new end
+        float chord[N_PRIMARY_AXIS];
+        float chord_sos= 0;
+        for (int i = 0; i < N_PRIMARY_AXIS; ++i) {
+            chord[i]= target[i] - merge.start[i];
+            chord_sos += chord[i] * chord[i];
+        }
+        float chord_length= sqrtf(chord_sos);
+        for (int p = 0; fits && p <= merge.n_points; ++p) {
+            const float *point= (p < merge.n_points) ? merge.point[p] : merge.end;
+            float along= 0, off_sos= 0;
+            for (int i = 0; i < N_PRIMARY_AXIS; ++i) along += (point[i] - merge.start[i]) * chord[i] / chord_length;
+            for (int i = 0; i < N_PRIMARY_AXIS; ++i) off_sos += powf(point[i] - merge.start[i] - chord[i] * along / chord_length, 2);
+            if(along < 0 || along > chord_length || off_sos > merge_tolerance * merge_tolerance) fits= false;
+        }
+
+        // E and ABC must move at the same rate along it, within 1%
+        float held_length= 0;
+        for (int i = 0; i < N_PRIMARY_AXIS; ++i) held_length += powf(merge.end[i] - merge.start[i], 2);
+        held_length= sqrtf(held_length);
+        for (int i = N_PRIMARY_AXIS; fits && i < n_motors; ++i) {
+            float held_rate= (merge.end[i] - merge.start[i]) / held_length;
+            float new_rate= delta[i] / length;
+            if(fabsf(new_rate - held_rate) > 0.01F * std::max(fabsf(new_rate), fabsf(held_rate))) fits= false;
+        }
+
+        if(fits) {
+            memcpy(merge.point[merge.n_points++], merge.end, sizeof(merge.point[0]));
+            memcpy(merge.end, target, n_motors*sizeof(float));
+            for (int i = 0; i < N_PRIMARY_AXIS; ++i) merge.unit_vec[i]= delta[i] / length;
+            return true;
+        }
+    }
+
+    flush_merged_move();
+
+    // hold this one back to see if the next one can be merged into it
+    memcpy(merge.start, machine_position, n_motors*sizeof(float));
+    memcpy(merge.end, target, n_motors*sizeof(float));
+    for (int i = 0; i < N_PRIMARY_AXIS; ++i) merge.unit_vec[i]= delta[i] / length;
+    merge.rate_mm_s= rate_mm_s;
+    merge.s_value= s_value;
+    merge.n_points= 0;
+    merge.pending= true;
+    return true;
+}
+
+// queue the move being merged if there is one
+void Robot::flush_merged_move()
+{
+    if(!merge.pending) return;
+    merge.pending= false;
+    if(THEKERNEL->is_halted()) return;
+
+    // it is queued as the G1 it came from, whatever came in since
+    float s= s_value;
+    bool g123= is_g123, override_move= feed_override_move;
+    s_value= merge.s_value;
+    is_g123= true;
+    feed_override_move= true;
+    append_milestone(merge.end, merge.rate_mm_s);
+    s_value= s;
+    is_g123= g123;
+    feed_override_move= override_move;
+}
+
+/*
+    Lookahead of the G0/G1 ahead of the planner
+
+    Without it a G0/G1 is cut into blocks as it is received, and when the block queue is full Conveyor::queue_head_block()
+    calls on_idle until there is room, so no more lines are read until then. Instead the move is worked out into machine
+    coordinates, with the WCS, units, relative moves and E done, and queued here, then it is cut into blocks from on_idle
+    as there is room in the block queue. The consoles and the player do not send a line while this queue is full, so
+    they go back to the main loop instead of waiting inside on_gcode_received. The compensation transform is still done
+    when the move is planned, as it is applied to each segment.
+
+    machine_position only moves on when a move is planned, anything other than a G0/G1 gets the queued moves planned
+    first, as do wait_for_idle() and delta_move(), so they see the position they did before.
+
+    From on_idle a move is only planned as far as there is room in the block queue, a line that is cut into more segments
+    than that stops at the end of one and the rest of it stays at the head of the queue, see cut_short(). So the block
+    queue is never waited on from on_idle.
+*/
+void Robot::queue_move(const float target[], float rate_mm_s, float delta_e, bool is_g1, bool has_xy)
+{
+    if(move_queue_count >= move_queue_size) {
+        // only a line with more than one move on it, or gcode that does not come from a console, finds it full. The oldest
+        // one is planned to make room, which waits for the block queue the same as a move that is not queued does
+        plan_queued_moves(true, 1);
+    }
+    if(THEKERNEL->is_halted()) return;
+
+    queued_move_t& m= move_queue[(move_queue_head + move_queue_count) % move_queue_size];
+    memcpy(m.target, target, n_motors*sizeof(float));
+    m.rate_mm_s= rate_mm_s;
+    m.delta_e= delta_e;
+    m.s_value= s_value;
+    m.is_g1= is_g1;
+    m.has_xy= has_xy;
+    ++move_queue_count;
+
+    // the block queue may have room now
+    plan_queued_moves(false);
+}
+
+// plan the first n queued moves, as far as there is room in the block queue for them, or waiting for room in it
+void Robot::plan_queued_moves(bool wait, uint8_t n)
+{
+    // planning a move can wait for room in the block queue, which calls on_idle again
+    if(planning_queued_moves) return;
+    // the block queue does not need any more while it is held, the hold is planned on the blocks it has
+    if(!wait && THEKERNEL->get_feed_hold()) return;
+    planning_queued_moves= true;
+    cut_when_full= !wait;
+
+    // a move is started when there is room for a segment and the block kept for the end of it, and for a merged move that is still pending
+    while(n-- > 0 && move_queue_count > 0 && (wait || THECONVEYOR->get_free_blocks() > (merge.pending ? 2U : 1U)) && !THEKERNEL->is_halted()) {
+        // taken off first, a halt while it is planned empties the queue
+        queued_move_t m= move_queue[move_queue_head];
+        move_queue_head= (move_queue_head + 1) % move_queue_size;
+        --move_queue_count;
+
+        // it is planned as the G0/G1 it came from, whatever came in since
+        float s= s_value;
+        bool g123= is_g123, override_move= feed_override_move;
+        s_value= m.s_value;
+        is_g123= m.is_g1;
+        feed_override_move= true;
+        move_cut_short= false;
+        bool moved= append_line(m.target, m.rate_mm_s, m.delta_e, m.is_g1, m.has_xy);
+        s_value= s;
+        is_g123= g123;
+        feed_override_move= override_move;
+
+        if(move_cut_short) {
+            if(THEKERNEL->is_halted()) break;
+            // the rest of it goes back at the head of the queue, to be planned from where it got to
+            if(!isnan(m.delta_e)) {
+                float left= 0, all= 0;
+                for (int i = X_AXIS; i <= Z_AXIS; ++i) {
+                    left += powf(m.target[i] - cut_short_at[i], 2);
+                    all += powf(m.target[i] - machine_position[i], 2);
+                }
+                m.delta_e *= sqrtf(left / all);
+            }
+            memcpy(machine_position, cut_short_at, n_motors*sizeof(float));
+            move_queue_head= (move_queue_head + move_queue_size - 1) % move_queue_size;
+            move_queue[move_queue_head]= m;
+            ++move_queue_count;
+            break;
+        }
+
+        if(moved) {
+            memcpy(machine_position, m.target, n_motors*sizeof(float));
+        }
+    }
+
+    cut_when_full= false;
+    planning_queued_moves= false;
+}
+
+// called before each segment of a line but the last, while the queued moves are planned from on_idle the line stops at the
+// position it has got to when the block queue is down to the block kept for the end of the line
+bool Robot::cut_short(const float position[])
+{
+    if(!cut_when_full || THECONVEYOR->get_free_blocks() > 1) return false;
+
+    memcpy(cut_short_at, position, n_motors*sizeof(float));
+    move_cut_short= true;
+    return true;
+}
+
+// plan all the queued moves, and the merged move if there is one
+void Robot::flush_queued_moves()
+{
+    if(move_queue_count > 0) {
+        if(planning_queued_moves) {
+            // called from on_idle while one is planned, the rest are planned when that returns
+            return;
+        }
+        plan_queued_moves(true);
+    }
+    flush_merged_move();
+}
+
+void Robot::on_halt(void *argument)
+{
+    if(argument == nullptr) {
+        // the moves queued ahead of the planner are dropped, as the block queue is
+        move_queue_count= 0;
+    }
+}
+
+void Robot::on_idle(void *argument)
+{
+    if(move_queue_count > 0) plan_queued_moves(false);
+
+    // do not let the step ticker run out of moves while one is held back
+    if(merge.pending && THECONVEYOR->get_queued_blocks() < 3) flush_merged_move();
+}
+
 // Append an arc to the queue ( cutting it into segments as needed )
 // TODO does not support any E parameters so cannot be used for 3D printing.
 bool Robot::append_arc(Gcode * gcode, const float target[], const float offset[], float radius, bool is_clockwise )
@@ -1579,6 +2140,26 @@ bool Robot::append_arc(Gcode * gcode, const float target[], const float offset[]
         return false;
     }
 
+    // the step ticker can follow the arc itself as one block, but only where the steps of the actuators are the axes
+    // bed leveling and soft endstops need the points along the arc, and event driven stepping has no ticks to turn it on
+    if(native_arcs && !compensationTransform && !soft_endstop_enabled && !THEKERNEL->step_ticker->is_event_driven()) {
+        planner_arc_t arc{};
+        arc.axis[0]= plane_axis_0;
+        arc.axis[1]= plane_axis_1;
+        arc.start[0]= r_axis0;
+        arc.start[1]= r_axis1;
+        arc.angle= angular_travel;
+        arc.length= fabsf(angular_travel) * radius;
+        // the tangent it leaves along, for the junction with the next move
+        float tangent= (angular_travel > 0 ? 1 : -1) / hypotf(rt_axis0, rt_axis1) * arc.length / millimeters_of_travel;
+        arc.exit_unit_vec[plane_axis_0]= -rt_axis1 * tangent;
+        arc.exit_unit_vec[plane_axis_1]= rt_axis0 * tangent;
+        arc.exit_unit_vec[plane_axis_2]= linear_travel / millimeters_of_travel;
+        // an arc longer than a block holds is cut into segments instead
+        float path_steps= arc.length * std::max(actuators[plane_axis_0]->get_steps_per_mm(), actuators[plane_axis_1]->get_steps_per_mm());
+        if(fits_in_block(target, path_steps, (1 << plane_axis_0) | (1 << plane_axis_1))) return append_milestone(target, rate_mm_s, &arc);
+    }
+
     // limit segments by maximum arc error
     float arc_segment = this->mm_per_arc_segment;
     if ((this->mm_max_arc_error > 0) && (2 * radius > this->mm_max_arc_error)) {
@@ -1696,6 +2277,130 @@ bool Robot::compute_arc(Gcode * gcode, const float offset[], const float target[
     return this->append_arc(gcode, target, offset,  radius, is_clockwise );
 }
 
+// G5 X Y I J P Q is a cubic Bezier from the current position to X Y, I J is the first control point from the start and P Q the second from the end,
+// I J can be left out to carry on smoothly from the G5 before it. G5.1 X Y I J is a quadratic one with I J its control point from the start
+bool Robot::compute_spline(Gcode * gcode, const float offset[], const float target[], enum MOTION_MODE_T motion_mode)
+{
+    if(plane_axis_0 != X_AXIS || plane_axis_1 != Y_AXIS) {
+        gcode->is_error= true;
+        gcode->txt_after_ok= "G5 only works in the XY plane (G17)";
+        return false;
+    }
+
+    bool has_ij= gcode->has_letter('I') || gcode->has_letter('J');
+    float control1[2], control2[2];
+
+    if(motion_mode == QUADRATIC_SPLINE) {
+        if(!has_ij) {
+            gcode->is_error= true;
+            gcode->txt_after_ok= "G5.1 needs I and J";
+            return false;
+        }
+        // raise the quadratic to a cubic, the control points are two thirds of the way to its control point from each end
+        for (int i = 0; i < 2; ++i) {
+            float control= machine_position[i] + offset[i];
+            control1[i]= machine_position[i] + (control - machine_position[i]) * 2.0F / 3.0F;
+            control2[i]= target[i] + (control - target[i]) * 2.0F / 3.0F;
+        }
+
+    } else {
+        if(!gcode->has_letter('P') || !gcode->has_letter('Q') || (!has_ij && isnan(last_spline_control[0]))) {
+            gcode->is_error= true;
+            gcode->txt_after_ok= "G5 needs P and Q, and I and J unless it follows a G5";
+            return false;
+        }
+        float pq[2]= {to_millimeters(gcode->get_value('P')), to_millimeters(gcode->get_value('Q'))};
+        for (int i = 0; i < 2; ++i) {
+            // without I J the first control point is the last one of the previous G5 mirrored through the start
+            control1[i]= machine_position[i] + (has_ij ? offset[i] : -last_spline_control[i]);
+            control2[i]= target[i] + pq[i];
+        }
+        last_spline_control[0]= pq[0];
+        last_spline_control[1]= pq[1];
+    }
+
+    return append_spline(gcode, target, control1, control2);
+}
+
+// Append a cubic Bezier in XY to the queue, flattened into lines that are no further than mm_max_arc_error from the curve
+// The other axis move in proportion to the length along it, so the extrusion per mm is the same all along the curve
+bool Robot::append_spline(Gcode * gcode, const float target[], const float control1[], const float control2[])
+{
+    float rate_mm_s= this->feed_rate / seconds_per_minute;
+    // catch negative or zero feed rates and return the same error as GRBL does
+    if(rate_mm_s <= 0.0F) {
+        gcode->is_error= true;
+        gcode->txt_after_ok= (rate_mm_s == 0 ? "Undefined feed rate" : "feed rate < 0");
+        return false;
+    }
+
+    float tolerance= this->mm_max_arc_error > 0 ? this->mm_max_arc_error : 0.01F;
+    float start[n_motors];
+    memcpy(start, machine_position, n_motors*sizeof(float));
+
+    // the second derivative of the curve is a straight line from dd0 at the start to dd1 at the end
+    float dd0[2], dd1[2];
+    for (int i = 0; i < 2; ++i) {
+        dd0[i]= 6.0F * (start[i] - 2.0F * control1[i] + control2[i]);
+        dd1[i]= 6.0F * (control1[i] - 2.0F * control2[i] + target[i]);
+    }
+    auto second_derivative= [&dd0, &dd1](float t) { return hypotf(dd0[0] + (dd1[0] - dd0[0]) * t, dd0[1] + (dd1[1] - dd0[1]) * t); };
+
+    /*
+        A line from B(t) to B(t+dt) is no further than dt²/8 * max|B''| from the curve between them, and as B'' is a
+        straight line the max is at one of the ends, so the step that keeps within the tolerance is worked out directly,
+        long lines where it is flat and short ones where it bends, with no recursion or trial subdivision.
+    */
+    auto next_t= [&second_derivative, tolerance](float t) {
+        float dd= second_derivative(t);
+        float dt= dd > 0 ? std::min(sqrtf(8.0F * tolerance / dd), 1.0F - t) : 1.0F - t;
+        float dd_end= second_derivative(t + dt);
+        if(dd_end > dd) dt= sqrtf(8.0F * tolerance / dd_end);
+        return t + dt;
+    };
+    const float *from= start;
+    auto curve_point= [from, control1, control2, target](float t, float p[2]) {
+        float mt= 1.0F - t;
+        float b0= mt * mt * mt, b1= 3.0F * mt * mt * t, b2= 3.0F * mt * t * t, b3= t * t * t;
+        for (int i = X_AXIS; i <= Y_AXIS; ++i) p[i]= b0 * from[i] + b1 * control1[i] + b2 * control2[i] + b3 * target[i];
+    };
+
+    // the speed along the curve changes with t, so the lines are measured first, the same ones are then appended
+    float length= 0;
+    float last[2]= {start[X_AXIS], start[Y_AXIS]};
+    for (float t= next_t(0); ; t= next_t(t)) {
+        float p[2];
+        if(t < 1.0F) curve_point(t, p);
+        else memcpy(p, target, sizeof(p));
+        length += hypotf(p[X_AXIS] - last[X_AXIS], p[Y_AXIS] - last[Y_AXIS]);
+        memcpy(last, p, sizeof(last));
+        if(t >= 1.0F) break;
+    }
+
+    bool moved= false;
+    float segment_end[n_motors];
+    float s= 0;
+    memcpy(last, start, sizeof(last));
+    for (float t= next_t(0); t < 1.0F; t= next_t(t)) {
+        if(THEKERNEL->is_halted()) return false; // don't queue any more segments
+
+        curve_point(t, segment_end);
+        s += hypotf(segment_end[X_AXIS] - last[X_AXIS], segment_end[Y_AXIS] - last[Y_AXIS]);
+        memcpy(last, segment_end, sizeof(last));
+        float fraction= length > 0 ? s / length : t;
+        for (int i = Z_AXIS; i < n_motors; ++i) segment_end[i]= start[i] + (target[i] - start[i]) * fraction;
+
+        // Append this segment to the queue
+        bool b= this->append_milestone(segment_end, rate_mm_s);
+        moved= moved || b;
+    }
+
+    // Ensure last segment arrives at target location.
+    if(this->append_milestone(target, rate_mm_s)) moved= true;
+
+    return moved;
+}
+
 
 float Robot::theta(float x, float y)
 {
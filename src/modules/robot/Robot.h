@@ -22,22 +22,31 @@ using std::string;
 class Gcode;
 class BaseSolution;
 class StepperMotor;
+struct planner_arc_t;
+struct planner_kin_t;
 
 // 9 WCS offsets
 #define MAX_WCS 9UL
 
+// the most G1 that are merged into one move
+#define MAX_MERGED_SEGMENTS 8
+
 class Robot : public Module {
     public:
         using wcs_t= std::tuple<float, float, float>;
         Robot();
         void on_module_loaded();
         void on_gcode_received(void* argument);
+        void on_idle(void* argument);
+        void on_halt(void* argument);
 
         void reset_axis_position(float position, int axis);
         void reset_axis_position(float x, float y, float z);
         void reset_actuator_position(const ActuatorCoordinates &ac);
         void reset_position_from_current_actuator_position();
         float get_seconds_per_minute() const { return seconds_per_minute; }
+        float get_speed_override() const { return 6000.0F / seconds_per_minute; }
+        void set_speed_override(float factor);
         float get_z_maxfeedrate() const { return this->max_speeds[Z_AXIS]; }
         float get_default_acceleration() const { return default_acceleration; }
         void setToolOffset(const float offset[N_PRIMARY_AXIS]);
@@ -59,6 +68,10 @@ class Robot : public Module {
         std::tuple<float, float, float, uint8_t> get_last_probe_position() const { return last_probe_position; }
         void set_last_probe_position(std::tuple<float, float, float, uint8_t> p) { last_probe_position = p; }
         bool delta_move(const float delta[], float rate_mm_s, uint8_t naxis);
+        void flush_merged_move();
+        void flush_queued_moves();
+        // the consoles and the player hold back the next line while this is full, so parsing runs ahead of the planner
+        bool is_move_queue_full() const { return move_queue_size > 0 && move_queue_count >= move_queue_size; }
         uint8_t register_motor(StepperMotor*);
         uint8_t get_number_registered_motors() const {return n_motors; }
 
@@ -89,8 +102,11 @@ class Robot : public Module {
             bool save_g92:1;                                  // save g92 on M500 if set
             bool save_g54:1;                                  // save WCS on M500 if set
             bool is_g123:1;
+            bool feed_override_move:1;                        // the move is a G0-G3 the speed override applies to
             bool soft_endstop_enabled:1;
             bool soft_endstop_halt:1;
+            bool native_arcs:1;                               // the step ticker follows G2/G3 instead of them being cut into segments
+            bool kinematic_lines:1;                           // the step ticker moves the delta towers along a line instead of it being cut into segments
             uint8_t plane_axis_0:2;                           // Current plane ( XY, XZ, YZ )
             uint8_t plane_axis_1:2;
             uint8_t plane_axis_2:2;
@@ -102,15 +118,27 @@ class Robot : public Module {
             SEEK, // G0
             LINEAR, // G1
             CW_ARC, // G2
-            CCW_ARC // G3
+            CCW_ARC, // G3
+            CUBIC_SPLINE, // G5
+            QUADRATIC_SPLINE // G5.1
         };
 
         void load_config();
-        bool append_milestone(const float target[], float rate_mm_s);
-        bool append_line( Gcode* gcode, const float target[], float rate_mm_s, float delta_e);
+        bool append_milestone(const float target[], float rate_mm_s, const planner_arc_t *arc= nullptr, const ActuatorCoordinates *target_actuator= nullptr, const planner_kin_t *kin= nullptr);
+        bool append_line(const float target[], float rate_mm_s, float delta_e, bool is_g1, bool has_xy);
+        bool merge_milestone(const float target[], float rate_mm_s);
+        bool append_curved_segments(const float target[], float rate_mm_s, float length);
+        bool append_kinematic_line(const float target[], float rate_mm_s, float length);
+        bool append_kinematic_block(const float end[], uint8_t n_intervals, float rate_mm_s);
+        bool fits_in_block(const float target[], float path_steps, uint8_t path_mask) const;
         bool append_arc( Gcode* gcode, const float target[], const float offset[], float radius, bool is_clockwise );
         bool compute_arc(Gcode* gcode, const float offset[], const float target[], enum MOTION_MODE_T motion_mode);
+        bool append_spline(Gcode* gcode, const float target[], const float control1[], const float control2[]);
+        bool compute_spline(Gcode* gcode, const float offset[], const float target[], enum MOTION_MODE_T motion_mode);
         void process_move(Gcode *gcode, enum MOTION_MODE_T);
+        void queue_move(const float target[], float rate_mm_s, float delta_e, bool is_g1, bool has_xy);
+        void plan_queued_moves(bool wait, uint8_t n= 255);
+        bool cut_short(const float position[]);
         bool is_homed(uint8_t i) const;
 
         float theta(float x, float y);
@@ -135,10 +163,12 @@ class Robot : public Module {
         float mm_per_line_segment;                           // Setting : Used to split lines into segments
         float mm_per_arc_segment;                            // Setting : Used to split arcs into segments
         float mm_max_arc_error;                              // Setting : Used to limit total arc segments to max error
+        float mm_max_line_error;                             // Setting : Used to split lines into segments where the actuators stray from a straight line by more than this
         float delta_segments_per_second;                     // Setting : Used to split lines into segments for delta based on speed
         float seconds_per_minute;                            // for realtime speed change
         float default_acceleration;                          // the defualt accleration if not set for each axis
         float s_value;                                       // modal S value
+        float last_spline_control[2];                        // second control point of the last G5 from its end, NAN if the last move was not a G5
 
         // Number of arc generation iterations by small angle approximation before exact arc trajectory
         // correction. This parameter may be decreased if there are issues with the accuracy of the arc
@@ -151,6 +181,39 @@ class Robot : public Module {
 
         float soft_endstop_min[3], soft_endstop_max[3];
 
+        // consecutive G1 that are close enough to a straight line are merged into one move before they are planned
+        float merge_tolerance;                               // Setting : how far a point merged away can be from the merged move, 0 disables it
+        float merge_cos_angle;                               // Setting : cosine of the largest turn between merged G1
+        struct {
+            float start[k_max_actuators];                    // where the merged move starts
+            float end[k_max_actuators];                      // and where it ends so far
+            float point[MAX_MERGED_SEGMENTS][N_PRIMARY_AXIS]; // the ends of the G1 merged into it
+            float unit_vec[N_PRIMARY_AXIS];                  // direction of the last G1
+            float rate_mm_s;
+            float s_value;
+            uint8_t n_points;
+            bool pending;
+        } merge;
+
+        // G0/G1 worked out into machine coordinates, waiting for room in the block queue, see queue_move()
+        struct queued_move_t {
+            float target[k_max_actuators];
+            float rate_mm_s;
+            float delta_e;
+            float s_value;
+            bool is_g1;
+            bool has_xy;
+        };
+        queued_move_t *move_queue;
+        uint8_t move_queue_size;                             // Setting : how many moves can be queued ahead of the planner, 0 to plan them as they come
+        uint8_t move_queue_head;
+        uint8_t move_queue_count;
+        bool planning_queued_moves;
+        // a queued move is cut short when the block queue fills up, the rest of it is planned from cut_short_at, see cut_short()
+        bool cut_when_full;
+        bool move_cut_short;
+        float cut_short_at[k_max_actuators];
+
         uint8_t n_motors;                                    //count of the motors/axis registered
 
         // Used by Planner
@@ -0,0 +1,37 @@
+#include "BaseSolution.h"
+#include "ActuatorCoordinates.h"
+#include "libs/nuts_bolts.h"
+
+#include <math.h>
+
+// one at a time, for the solutions that have nothing to share between the points
+void BaseSolution::cartesian_to_actuators(const float cartesian_mm[], size_t stride, ActuatorCoordinates actuator_mm[], size_t n) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        cartesian_to_actuator(&cartesian_mm[i * stride], actuator_mm[i]);
+    }
+}
+
+// the second difference of the actuator positions over a millimeter either side, for the solutions that do not work it out directly
+float BaseSolution::actuator_curvature(const float position[], const float unit_vec[]) const
+{
+    const float h= 1.0F;
+    float before[3], after[3];
+    for (int i = X_AXIS; i <= Z_AXIS; ++i) {
+        before[i]= position[i] - unit_vec[i] * h;
+        after[i]= position[i] + unit_vec[i] * h;
+    }
+
+    ActuatorCoordinates a, b, c;
+    cartesian_to_actuator(before, a);
+    cartesian_to_actuator(position, b);
+    cartesian_to_actuator(after, c);
+
+    float curvature= 0;
+    for (int i = ALPHA_STEPPER; i <= GAMMA_STEPPER; ++i) {
+        float d= fabsf(a[i] - 2.0F * b[i] + c[i]) / (h * h);
+        if(isnan(d)) return INFINITY; // off the edge of what it can reach
+        if(d > curvature) curvature= d;
+    }
+    return curvature;
+}
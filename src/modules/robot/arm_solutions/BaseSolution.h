@@ -3,6 +3,7 @@
 #define BASESOLUTION_H
 
 #include <map>
+#include <stddef.h>
 #include "ActuatorCoordinates.h"
 
 class Config;
@@ -14,6 +15,11 @@ class BaseSolution {
         virtual ~BaseSolution() {};
         virtual void cartesian_to_actuator(const float[], ActuatorCoordinates &) const = 0;
         virtual void actuator_to_cartesian(const ActuatorCoordinates &, float[]) const = 0;
+        // cartesian_to_actuator() for n points at once, point i starts at cartesian_mm[i * stride]
+        virtual void cartesian_to_actuators(const float cartesian_mm[], size_t stride, ActuatorCoordinates actuator_mm[], size_t n) const;
+        // how sharply the actuators curve away from moving in a straight line when moving along unit_vec from position,
+        // the largest second derivative of an actuator position with respect to the distance moved, 0 if they do not curve
+        virtual float actuator_curvature(const float position[], const float unit_vec[]) const;
         typedef std::map<char, float> arm_options_t;
         virtual bool set_optional(const arm_options_t& options) { return false; };
         virtual bool get_optional(arm_options_t& options, bool force_all= false) const { return false; };
@@ -8,6 +8,14 @@ void CartesianSolution::cartesian_to_actuator( const float cartesian_mm[], Actua
     actuator_mm[GAMMA_STEPPER] = cartesian_mm[Z_AXIS];
 }
 
+void CartesianSolution::cartesian_to_actuators(const float cartesian_mm[], size_t stride, ActuatorCoordinates actuator_mm[], size_t n) const {
+    for (size_t i = 0; i < n; ++i, cartesian_mm += stride) {
+        actuator_mm[i][ALPHA_STEPPER] = cartesian_mm[X_AXIS];
+        actuator_mm[i][BETA_STEPPER ] = cartesian_mm[Y_AXIS];
+        actuator_mm[i][GAMMA_STEPPER] = cartesian_mm[Z_AXIS];
+    }
+}
+
 void CartesianSolution::actuator_to_cartesian( const ActuatorCoordinates &actuator_mm, float cartesian_mm[] ) const {
     cartesian_mm[X_AXIS] = actuator_mm[ALPHA_STEPPER];
     cartesian_mm[Y_AXIS ] = actuator_mm[BETA_STEPPER];
@@ -13,4 +13,6 @@ class CartesianSolution : public BaseSolution {
         CartesianSolution(Config*){};
         void cartesian_to_actuator( const float millimeters[], ActuatorCoordinates &steps ) const override;
         void actuator_to_cartesian( const ActuatorCoordinates &steps, float millimeters[] ) const override;
+        void cartesian_to_actuators(const float cartesian_mm[], size_t stride, ActuatorCoordinates actuator_mm[], size_t n) const override;
+        float actuator_curvature(const float[], const float[]) const override { return 0; } // the actuators move in straight lines
 };
@@ -12,6 +12,7 @@ class CoreXZSolution : public BaseSolution {
         CoreXZSolution(Config*);
         void cartesian_to_actuator(const float[], ActuatorCoordinates & ) const override;
         void actuator_to_cartesian(const ActuatorCoordinates &, float[] ) const override;
+        float actuator_curvature(const float[], const float[]) const override { return 0; } // the actuators move in straight lines
 
     private:
         float x_reduction;
@@ -73,6 +73,43 @@ void LinearDeltaSolution::cartesian_to_actuator(const float cartesian_mm[], Actu
                                       ) + cartesian_mm[Z_AXIS];
 }
 
+// the same sums as cartesian_to_actuator() a tower at a time, so the inner loop over the points has no branches or calls
+// apart from the square root, and the tower position stays in registers. The host build can vectorize it
+void LinearDeltaSolution::cartesian_to_actuators(const float cartesian_mm[], size_t stride, ActuatorCoordinates actuator_mm[], size_t n) const
+{
+    const float tower[3][2]= {{delta_tower1_x, delta_tower1_y}, {delta_tower2_x, delta_tower2_y}, {delta_tower3_x, delta_tower3_y}};
+    for (int t = ALPHA_STEPPER; t <= GAMMA_STEPPER; ++t) {
+        const float tx= tower[t][0], ty= tower[t][1];
+        const float *p= cartesian_mm;
+        for (size_t i = 0; i < n; ++i, p += stride) {
+            float dx= tx - p[X_AXIS];
+            float dy= ty - p[Y_AXIS];
+            actuator_mm[i][t]= sqrtf(this->arm_length_squared - dx * dx - dy * dy) + p[Z_AXIS];
+        }
+    }
+}
+
+// each carriage is at sqrt(q) + z, where q = arm_length² - the horizontal distance to the tower squared, so moving along
+// unit_vec its second derivative is -(|v|² * q + (r.v)²) / q^3/2, with v the horizontal part of unit_vec and r from the tower
+float LinearDeltaSolution::actuator_curvature(const float position[], const float unit_vec[]) const
+{
+    float v2= SQ(unit_vec[X_AXIS]) + SQ(unit_vec[Y_AXIS]);
+    if(v2 == 0) return 0; // straight up and down
+
+    const float tower[3][2]= {{delta_tower1_x, delta_tower1_y}, {delta_tower2_x, delta_tower2_y}, {delta_tower3_x, delta_tower3_y}};
+    float curvature= 0;
+    for (int i = 0; i < 3; ++i) {
+        float rx= position[X_AXIS] - tower[i][0];
+        float ry= position[Y_AXIS] - tower[i][1];
+        float q= arm_length_squared - SQ(rx) - SQ(ry);
+        if(q <= 0) return INFINITY; // off the edge of what it can reach
+        float rv= rx * unit_vec[X_AXIS] + ry * unit_vec[Y_AXIS];
+        float c= (v2 * q + SQ(rv)) / (q * sqrtf(q));
+        if(c > curvature) curvature= c;
+    }
+    return curvature;
+}
+
 void LinearDeltaSolution::actuator_to_cartesian(const ActuatorCoordinates &actuator_mm, float cartesian_mm[] ) const
 {
     // from http://en.wikipedia.org/wiki/Circumscribed_circle#Barycentric_coordinates_from_cross-_and_dot-products
@@ -14,6 +14,7 @@ class RotatableCartesianSolution : public BaseSolution {
         RotatableCartesianSolution(Config*);
         void cartesian_to_actuator(const float[], ActuatorCoordinates &) const override;
         void actuator_to_cartesian(const ActuatorCoordinates &, float[] ) const override;
+        float actuator_curvature(const float[], const float[]) const override { return 0; } // the actuators move in straight lines
 
     private:
         void rotate(const float in[], float out[], float sin, float cos) const;
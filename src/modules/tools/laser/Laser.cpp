@@ -211,8 +211,8 @@ float Laser::current_speed_ratio(const Block *block) const
     uint32_t max_steps = 0;
     for (size_t i = 0; i < THEROBOT->get_number_registered_motors(); i++) {
         // find the motor with the most steps
-        if(block->steps[i] > max_steps) {
-            max_steps = block->steps[i];
+        if(block->ticked_steps(i) > max_steps) {
+            max_steps = block->ticked_steps(i);
             pm = i;
         }
     }
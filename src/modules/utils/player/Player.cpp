@@ -423,7 +423,7 @@ void Player::on_main_loop(void *argument)
     }
 
     if( this->playing_file ) {
-        if(THEKERNEL->is_halted()) {
+        if(THEKERNEL->is_halted() || THEROBOT->is_move_queue_full()) {
             return;
         }
 
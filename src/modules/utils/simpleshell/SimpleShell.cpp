@@ -621,7 +621,15 @@ void SimpleShell::mem_command( string parameters, StreamOutput *stream)
         AHB1.debug(stream);
     }
 
-    stream->printf("Block size: %u bytes, Tickinfo size: %u bytes\n", sizeof(Block), sizeof(Block::tickinfo_t) * Block::n_actuators);
+    // each block is in AHB0, with its cold data on the heap
+    size_t cold_size= sizeof(Block::cold_t) + (Block::has_paths ? sizeof(Block::path_t) : 0);
+    stream->printf("Block size: %u bytes + %u bytes cold, Tickinfo size: %u bytes\n", sizeof(Block), cold_size, sizeof(Block::tickinfo_t) * Block::n_actuators);
+    stream->printf("Planner queue: %u blocks, %u bytes in AHB0, %u bytes on the heap, shared tick info: %u bytes\n", THECONVEYOR->get_queue_size(),
+                   sizeof(Block) * THECONVEYOR->get_queue_size(), cold_size * THECONVEYOR->get_queue_size(), Block::tick_info_arena_size());
+
+    Gcode::alloc_stats_t gs= Gcode::get_alloc_stats();
+    stream->printf("Gcode pool: %u of %u in use, %lu from pool, %lu from heap, %lu long lines on heap\n", gs.pool_used, gs.pool_size,
+                   gs.from_pool, gs.from_heap, gs.long_lines);
 }
 
 static uint32_t getDeviceType()
@@ -895,7 +903,7 @@ void SimpleShell::get_command( string parameters, StreamOutput *stream)
 
     } else if (what == "status") {
         // also ? on serial and usb
-        stream->printf("%s\n", THEKERNEL->get_query_string().c_str());
+        stream->printf("%s\n", THEKERNEL->get_query_string(stream).c_str());
 
     } else {
         stream->printf("error:unknown option %s\n", what.c_str());
@@ -0,0 +1,337 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    The arm solution microbenchmarks for smoothie-sim -b
+
+    Each arm solution is made from the loaded config, so the ones it does not set up use their defaults, and the same points
+    are converted one call at a time, as append_milestone() does, then in batches of 8 as append_line() does, then all at once.
+    The batches must give exactly the same actuator positions as the single calls.
+
+    The gcode parser benchmark reads a gcode file, strips the comments as GcodeDispatch does, then makes a Gcode of each line
+    and looks up the words the way Robot and the other modules do. The same is done with a copy of the parser Gcode used
+    to have, which strdup()ed the line and scanned it again for every letter, so the two can be compared.
+*/
+
+#include "libs/Kernel.h"
+#include "libs/Config.h"
+#include "modules/robot/arm_solutions/BaseSolution.h"
+#include "modules/robot/arm_solutions/CartesianSolution.h"
+#include "modules/robot/arm_solutions/RotatableCartesianSolution.h"
+#include "modules/robot/arm_solutions/HBotSolution.h"
+#include "modules/robot/arm_solutions/CoreXZSolution.h"
+#include "modules/robot/arm_solutions/LinearDeltaSolution.h"
+#include "modules/robot/arm_solutions/RotaryDeltaSolution.h"
+#include "modules/robot/arm_solutions/MorganSCARASolution.h"
+#include "modules/communication/utils/Gcode.h"
+#include "modules/communication/BinaryMotion.h"
+
+#include "HostBench.h"
+#include "HostBinary.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+#define BENCH_POINTS 4096
+#define BENCH_ROUNDS 200
+
+// ns per point of convert() over all the points, BENCH_ROUNDS times
+template<typename F>
+static double time_points(F convert)
+{
+    auto start= std::chrono::steady_clock::now();
+    for (int r = 0; r < BENCH_ROUNDS; ++r) convert();
+    auto end= std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ((double)BENCH_ROUNDS * BENCH_POINTS);
+}
+
+static bool bench_solution(const char *name, BaseSolution *solution, const std::vector<float>& points)
+{
+    std::vector<ActuatorCoordinates> single(BENCH_POINTS), batch(BENCH_POINTS), all(BENCH_POINTS);
+
+    double t_single= time_points([&]() {
+        for (int i = 0; i < BENCH_POINTS; ++i) solution->cartesian_to_actuator(&points[i * 3], single[i]);
+    });
+    double t_batch= time_points([&]() {
+        for (int i = 0; i < BENCH_POINTS; i += 8) solution->cartesian_to_actuators(&points[i * 3], 3, &batch[i], 8);
+    });
+    double t_all= time_points([&]() {
+        solution->cartesian_to_actuators(&points[0], 3, &all[0], BENCH_POINTS);
+    });
+
+    bool same= true;
+    for (int i = 0; i < BENCH_POINTS; ++i) {
+        for (int a = ALPHA_STEPPER; a <= GAMMA_STEPPER; ++a) {
+            if(memcmp(&single[i][a], &batch[i][a], sizeof(float)) != 0 || memcmp(&single[i][a], &all[i][a], sizeof(float)) != 0) same= false;
+        }
+    }
+
+    printf("%-28s single %7.1f ns, batches of 8 %7.1f ns, all at once %7.1f ns per point%s\n", name, t_single, t_batch, t_all,
+           same ? "" : " MISMATCH");
+    return same;
+}
+
+int run_ik_bench()
+{
+    // a spiral out to 50mm from the middle, rising 10mm
+    std::vector<float> points(BENCH_POINTS * 3);
+    for (int i = 0; i < BENCH_POINTS; ++i) {
+        float f= (float)i / BENCH_POINTS;
+        float a= f * 40.0F * 3.14159265F;
+        points[i * 3 + X_AXIS]= 50.0F * f * cosf(a);
+        points[i * 3 + Y_AXIS]= 50.0F * f * sinf(a);
+        points[i * 3 + Z_AXIS]= 10.0F * f;
+    }
+
+    Config *config= THEKERNEL->config;
+    struct { const char *name; BaseSolution *solution; } solutions[]= {
+        {"CartesianSolution", new CartesianSolution(config)},
+        {"RotatableCartesianSolution", new RotatableCartesianSolution(config)},
+        {"HBotSolution", new HBotSolution(config)},
+        {"CoreXZSolution", new CoreXZSolution(config)},
+        {"LinearDeltaSolution", new LinearDeltaSolution(config)},
+        {"RotaryDeltaSolution", new RotaryDeltaSolution(config)},
+        {"MorganSCARASolution", new MorganSCARASolution(config)},
+    };
+
+    int ret= 0;
+    for(auto& s : solutions) {
+        if(!bench_solution(s.name, s.solution, points)) ret= 1;
+        delete s.solution;
+    }
+    return ret;
+}
+
+#define GCODE_BENCH_ROUNDS 50
+
+// the letters looked up for each line, most modules look at a few of these for every gcode they get
+static const char gcode_bench_letters[]= "XYZEFIJKPS";
+
+// Gcode as it was before the words were parsed once, the line is strdup()ed and every lookup scans it
+class ScanGcode {
+    public:
+        ScanGcode(const std::string& line, StreamOutput*)
+        {
+            command= strdup(line.c_str());
+            char *p= nullptr;
+            has_g= has_letter('G');
+            if(has_g) g= get_int('G', &p);
+            has_m= has_letter('M');
+            if(has_m) m= get_int('M', &p);
+            if(p != nullptr) {
+                char *n= strdup(p);
+                free(command);
+                command= n;
+            }
+        }
+        ~ScanGcode() { free(command); }
+
+        bool has_letter(char letter) const
+        {
+            for (size_t i = 0; i < strlen(command); ++i) {
+                if(command[i] == letter) return true;
+            }
+            return false;
+        }
+
+        float get_value(char letter) const
+        {
+            char *cn= NULL;
+            for (const char *cs = command; *cs; cs++) {
+                if(letter == *cs) {
+                    cs++;
+                    float r= strtof(cs, &cn);
+                    if(cn > cs) return r;
+                }
+            }
+            return 0;
+        }
+
+        int get_int(char letter, char **ptr) const
+        {
+            char *cn= NULL;
+            for (const char *cs = command; *cs; cs++) {
+                if(letter == *cs) {
+                    cs++;
+                    int r= strtol(cs, &cn, 10);
+                    if(ptr != nullptr) *ptr= cn;
+                    if(cn > cs) return r;
+                }
+            }
+            if(ptr != nullptr) *ptr= nullptr;
+            return 0;
+        }
+
+        int get_num_args() const
+        {
+            int count= 0;
+            for(size_t i = 0; i < strlen(command); i++) {
+                if(command[i] >= 'A' && command[i] <= 'Z' && command[i] != 'T') count++;
+            }
+            return count;
+        }
+
+        unsigned int m= 0, g= 0;
+        bool has_m, has_g;
+
+    private:
+        char *command;
+};
+
+// look up the words of one line, the sum stops the compiler dropping the lookups
+template<typename G>
+static float probe_gcode(const G& gcode)
+{
+    float sum= gcode.get_num_args();
+    if(gcode.has_g) sum += gcode.g;
+    if(gcode.has_m) sum += gcode.m;
+    for(const char *l = gcode_bench_letters; *l; ++l) {
+        if(gcode.has_letter(*l)) sum += gcode.get_value(*l);
+    }
+    return sum;
+}
+
+// lines per second of making then probing a G of each line, GCODE_BENCH_ROUNDS times
+template<typename G>
+static double time_lines(const std::vector<std::string>& lines, float& sum)
+{
+    auto start= std::chrono::steady_clock::now();
+    for (int r = 0; r < GCODE_BENCH_ROUNDS; ++r) {
+        for(auto& l : lines) {
+            G gcode(l, nullptr);
+            sum += probe_gcode(gcode);
+        }
+    }
+    auto end= std::chrono::steady_clock::now();
+    return (double)GCODE_BENCH_ROUNDS * lines.size() / std::chrono::duration<double>(end - start).count();
+}
+
+int run_gcode_bench(const char *file)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == NULL) {
+        fprintf(stderr, "cannot open gcode file %s\n", file);
+        return 2;
+    }
+
+    // keep the commands without their comments, as GcodeDispatch passes them on
+    std::vector<std::string> lines;
+    char buf[256];
+    while(fgets(buf, sizeof(buf), fp) != NULL) {
+        std::string l(buf);
+        size_t c= l.find_first_of(";\r\n");
+        if(c != std::string::npos) l= l.substr(0, c);
+        if(l.find_first_not_of(' ') == std::string::npos) continue;
+        lines.push_back(l);
+    }
+    fclose(fp);
+
+    int ret= 0;
+    for(auto& l : lines) {
+        ScanGcode scan(l, nullptr);
+        Gcode gcode(l, nullptr);
+        if(probe_gcode(scan) != probe_gcode(gcode) || scan.has_g != gcode.has_g || scan.has_m != gcode.has_m) {
+            printf("parsed differently: %s\n", l.c_str());
+            ret= 1;
+        }
+    }
+
+    float scan_sum= 0, sum= 0;
+    double scan_lps= time_lines<ScanGcode>(lines, scan_sum);
+    double lps= time_lines<Gcode>(lines, sum);
+    printf("%s: %u lines, strdup and scan %.0f lines/s, word table %.0f lines/s, %.2fx%s\n", file, (unsigned)lines.size(),
+           scan_lps, lps, lps / scan_lps, scan_sum == sum ? "" : " MISMATCH");
+    return (ret != 0 || scan_sum != sum) ? 1 : 0;
+}
+
+// the moves of the frames made into Gcodes, and probed, as they are when USBSerial receives them
+static void decode_moves(const std::vector<std::vector<uint8_t>>& frames, std::vector<float> *sums, float& sum)
+{
+    BinaryMotion decoder;
+    for(auto& f : frames) {
+        const uint8_t *p= f.data() + 3, *end= f.data() + f.size() - 2;
+        while(p < end && *p++ == 0x01) {
+            Gcode gcode(1, nullptr);
+            p= decoder.read_move(p, end, gcode);
+            if(p == nullptr) return;
+            float s= probe_gcode(gcode);
+            sum += s;
+            if(sums != nullptr) sums->push_back(s);
+        }
+    }
+}
+
+int run_binary_bench(const char *file)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == NULL) {
+        fprintf(stderr, "cannot open gcode file %s\n", file);
+        return 2;
+    }
+
+    // only the lines that go as move records, the rest would be sent as text either way
+    std::vector<std::string> lines;
+    BinaryEncoder encoder;
+    size_t text_bytes= 0;
+    char buf[256];
+    while(fgets(buf, sizeof(buf), fp) != NULL) {
+        size_t moves= encoder.moves;
+        encoder.add_line(buf);
+        if(encoder.moves == moves) continue;
+
+        std::string l(buf);
+        size_t c= l.find_first_of(";\r\n");
+        if(c != std::string::npos) l= l.substr(0, c);
+        lines.push_back(l);
+        text_bytes += l.size() + 1;
+    }
+    fclose(fp);
+
+    BinaryEncoder move_encoder;
+    for(auto& l : lines) move_encoder.add_line(l.c_str());
+    move_encoder.flush();
+    std::vector<std::vector<uint8_t>> frames;
+    while(move_encoder.has_frame()) frames.push_back(move_encoder.take_frame());
+
+    // each move has to have the same words as the line it came from
+    int ret= 0;
+    std::vector<float> sums;
+    float sum= 0;
+    decode_moves(frames, &sums, sum);
+    if(sums.size() != lines.size()) {
+        printf("decoded %u moves from %u lines\n", (unsigned)sums.size(), (unsigned)lines.size());
+        ret= 1;
+    } else {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            Gcode gcode(lines[i], nullptr);
+            if(probe_gcode(gcode) != sums[i]) {
+                printf("decoded differently: %s\n", lines[i].c_str());
+                ret= 1;
+            }
+        }
+    }
+
+    float text_sum= 0, binary_sum= 0;
+    double text_mps= time_lines<Gcode>(lines, text_sum);
+    auto start= std::chrono::steady_clock::now();
+    for (int r = 0; r < GCODE_BENCH_ROUNDS; ++r) {
+        decode_moves(frames, nullptr, binary_sum);
+    }
+    auto end= std::chrono::steady_clock::now();
+    double binary_mps= (double)GCODE_BENCH_ROUNDS * lines.size() / std::chrono::duration<double>(end - start).count();
+
+    size_t n= lines.empty() ? 1 : lines.size();
+    printf("%s: %u moves, text %.1f bytes %.0f moves/s, binary %.1f bytes %.0f moves/s, %.2fx the moves over the same link%s\n",
+           file, (unsigned)lines.size(), (double)text_bytes / n, text_mps, (double)move_encoder.bytes / n, binary_mps,
+           (double)text_bytes / move_encoder.bytes, text_sum == binary_sum ? "" : " MISMATCH");
+    return (ret != 0 || text_sum != binary_sum) ? 1 : 0;
+}
@@ -0,0 +1,19 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// times each arm solution converting the same points singly and in batches, returns non zero if the batches come out different
+int run_ik_bench();
+
+// times parsing each line of a gcode file into a Gcode and looking up its words, against the old strdup and scan
+// parser, returns non zero if they read any word differently
+int run_gcode_bench(const char *file);
+
+// times making the G0/G1 of a gcode file into Gcodes from binary motion frames against parsing them from the text, and
+// compares the bytes each takes, returns non zero if any move comes out with different words than its line
+int run_binary_bench(const char *file);
@@ -0,0 +1,201 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "HostBinary.h"
+
+#include "modules/communication/BinaryMotion.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+BinaryEncoder::BinaryEncoder()
+{
+    moves= texts= frame_count= bytes= 0;
+    seq= 0;
+    modal_g= 1;
+    memset(last, 0, sizeof(last));
+}
+
+static void put_u32(std::vector<uint8_t> &v, uint32_t u)
+{
+    for (int i = 0; i < 4; ++i) v.push_back(u >> (i * 8));
+}
+
+static void put_float(std::vector<uint8_t> &v, float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    put_u32(v, u);
+}
+
+// a G0/G1 with XYZ values of no more than 3 decimals and E of no more than 5, and F and S, as a move record
+bool BinaryEncoder::add_move(const char *line)
+{
+    static const char axes[]= "XYZE";
+    static const int decimals[]= {3, 3, 3, 5};
+
+    int g= -1;
+    bool has[4]{false, false, false, false};
+    int64_t value[4];
+    bool has_f= false, has_s= false;
+    float f= 0, s= 0;
+
+    const char *p= line;
+    while(*p) {
+        if(*p == ' ' || *p == '\t') {
+            ++p;
+            continue;
+        }
+
+        char letter= *p++;
+        const char *start= p;
+        bool negative= (*p == '-');
+        if(*p == '-' || *p == '+') ++p;
+        int64_t n= 0;
+        int digits= 0, places= -1;
+        for (; (*p >= '0' && *p <= '9') || *p == '.'; ++p) {
+            if(*p == '.') {
+                if(places >= 0) return false;
+                places= 0;
+                continue;
+            }
+            if(digits++ > 12) return false;
+            n= n * 10 + (*p - '0');
+            if(places >= 0) ++places;
+        }
+        if(digits == 0) return false;
+        if(places < 0) places= 0;
+
+        if(g < 0) {
+            // the first word is the G0/G1, or the line carries on from the last one
+            if(letter == 'G') {
+                if(negative || places > 0 || n > 1) return false;
+                g= n;
+                continue;
+            }
+            if(modal_g > 1) return false;
+            g= modal_g;
+        }
+
+        const char *a= strchr(axes, letter);
+        if(a != nullptr) {
+            int i= a - axes;
+            if(has[i] || places > decimals[i]) return false;
+            for (; places < decimals[i]; ++places) n *= 10;
+            value[i]= negative ? -n : n;
+            if(value[i] > INT32_MAX || value[i] < INT32_MIN) return false;
+            has[i]= true;
+
+        } else if(letter == 'F' && !has_f) {
+            f= strtof(start, nullptr);
+            has_f= true;
+
+        } else if(letter == 'S' && !has_s) {
+            s= strtof(start, nullptr);
+            has_s= true;
+
+        } else {
+            return false;
+        }
+    }
+    if(g < 0) return false;
+
+    uint8_t flags= (g == 0) ? 0x80 : 0;
+    for (int i = 0; i < 4; ++i) {
+        if(!has[i]) continue;
+        flags |= 1 << i;
+        int64_t d= value[i] - last[i];
+        if(d > INT16_MAX || d < INT16_MIN) flags |= 0x40;
+    }
+    if(has_f) flags |= 0x10;
+    if(has_s) flags |= 0x20;
+
+    std::vector<uint8_t> r{0x01, flags};
+    for (int i = 0; i < 4; ++i) {
+        if(!has[i]) continue;
+        if(flags & 0x40) {
+            put_u32(r, (uint32_t)(int32_t)value[i]);
+        } else {
+            int16_t d= value[i] - last[i];
+            r.push_back(d);
+            r.push_back((uint16_t)d >> 8);
+        }
+        last[i]= value[i];
+    }
+    if(has_f) put_float(r, f);
+    if(has_s) put_float(r, s);
+
+    add_record(r.data(), r.size());
+    modal_g= g;
+    ++moves;
+    return true;
+}
+
+bool BinaryEncoder::add_line(const char *line)
+{
+    std::string l(line);
+    size_t n= l.find(';');
+    if(n != std::string::npos) l.erase(n);
+    while(!l.empty() && isspace(l.back())) l.pop_back();
+    while(!l.empty() && isspace(l.front())) l.erase(0, 1);
+    if(l.empty()) return true;
+
+    if(l.find('(') == std::string::npos && add_move(l.c_str())) return true;
+
+    if(l.size() > BinaryMotion::k_max_payload - 2) return false;
+
+    // the last G0-G3 on it is what a line without a G carries on from
+    for (const char *p= strchr(l.c_str(), 'G'); p != nullptr; p= strchr(p + 1, 'G')) {
+        char *e;
+        long g= strtol(p + 1, &e, 10);
+        if(e > p + 1 && *e != '.' && g >= 0 && g <= 3) modal_g= g;
+    }
+
+    std::vector<uint8_t> r{0x02, (uint8_t)l.size()};
+    r.insert(r.end(), l.begin(), l.end());
+    add_record(r.data(), r.size());
+    ++texts;
+    return true;
+}
+
+void BinaryEncoder::end()
+{
+    uint8_t r= 0x03;
+    add_record(&r, 1);
+    flush();
+}
+
+void BinaryEncoder::add_record(const uint8_t *r, size_t n)
+{
+    if(payload.size() + n > BinaryMotion::k_max_payload) flush();
+    payload.insert(payload.end(), r, r + n);
+}
+
+void BinaryEncoder::flush()
+{
+    if(payload.empty()) return;
+
+    std::vector<uint8_t> frame{BinaryMotion::k_sync, (uint8_t)payload.size(), seq++};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    uint16_t crc= BinaryMotion::crc16(frame.data() + 1, frame.size() - 1);
+    frame.push_back(crc);
+    frame.push_back(crc >> 8);
+
+    ++frame_count;
+    bytes += frame.size();
+    frames.push_back(std::move(frame));
+    payload.clear();
+}
+
+std::vector<uint8_t> BinaryEncoder::take_frame()
+{
+    std::vector<uint8_t> f= std::move(frames.front());
+    frames.pop_front();
+    return f;
+}
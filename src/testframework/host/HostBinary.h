@@ -0,0 +1,42 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <deque>
+#include <vector>
+
+// Encodes gcode lines into BinaryMotion frames, the same way fast-stream.py -b does. A G0/G1 that only has XYZEFS
+// words with values a move record can carry exactly becomes a move record, anything else is sent as a text record.
+class BinaryEncoder {
+    public:
+        BinaryEncoder();
+
+        // returns false if the line is too long for a text record
+        bool add_line(const char *line);
+        // adds the end record, and finishes the frame
+        void end();
+        // finishes the frame so it is ready to send
+        void flush();
+
+        bool has_frame() const { return !frames.empty(); }
+        std::vector<uint8_t> take_frame();
+
+        size_t moves, texts, frame_count, bytes;
+
+    private:
+        bool add_move(const char *line);
+        void add_record(const uint8_t *r, size_t n);
+
+        std::vector<uint8_t> payload;
+        std::deque<std::vector<uint8_t>> frames;
+        uint8_t seq;
+        int modal_g;
+        int64_t last[4];
+};
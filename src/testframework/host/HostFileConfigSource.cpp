@@ -0,0 +1,23 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    libs/ConfigSources/FileConfigSource.cpp for the host build
+
+    It takes the length of a line as the difference of two fpos_t, which is a plain offset in newlib but a struct in glibc,
+    so here fpos_t is the offset ftell() and fseek() use.
+*/
+
+#include <cstdio>
+#include <stdio.h>
+#include <string>
+
+#define fpos_t long
+#define fgetpos(fp, pos) (*(pos)= ftell(fp), 0)
+#define fsetpos(fp, pos) fseek(fp, *(pos), SEEK_SET)
+
+#include "libs/ConfigSources/FileConfigSource.cpp"
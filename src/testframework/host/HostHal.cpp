@@ -0,0 +1,229 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Mock LPC17xx HAL for the host build.
+
+    The GPIO ports, TIMER0 and TIMER1 are emulated closely enough to run StepTicker unmodified.
+    Time only advances when the firmware waits (ON_IDLE, wait_us etc) so the main loop is effectively
+    infinitely fast unless the simulator charges time for it explicitly.
+    Interrupts run to completion in zero time at the exact count the match happened on.
+*/
+
+#include "HostHal.h"
+
+#include "LPC17xx.h"
+#include "system_LPC17xx.h"
+#include "mri.h"
+#include "wait_api.h"
+#include "us_ticker_api.h"
+#include "MRI_Hooks.h"
+#include "platform_memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+uint32_t SystemCoreClock= 100000000;
+
+LPC_GPIO_TypeDef host_gpio[5]{{0}, {1}, {2}, {3}, {4}};
+LPC_TIM_TypeDef host_tim[4]{{0}, {1}, {2}, {3}};
+LPC_SC_TypeDef host_sc;
+LPC_PINCON_TypeDef host_pincon;
+LPC_WDT_TypeDef host_wdt;
+SCB_Type host_scb;
+
+extern "C" void TIMER0_IRQHandler(void);
+extern "C" void TIMER1_IRQHandler(void);
+extern "C" void PendSV_Handler(void);
+
+static uint64_t now= 0;
+static host_gpio_hook_t gpio_hook;
+static host_stats_t stats;
+static bool irq_enabled[2];
+static bool pendsv_pending;
+
+// the state we need to emulate a match register 0 timer
+static struct {
+    bool running;
+    uint64_t base; // the time TC was last zero
+    uint32_t stopped_tc; // what TC reads while it is stopped
+} timer_state[2];
+
+// 16K each, same as the AHB SRAM banks on the LPC1768
+static uint8_t ahb0_ram[16384] __attribute__((aligned(8)));
+static uint8_t ahb1_ram[16384] __attribute__((aligned(8)));
+
+void host_hal_init()
+{
+    _AHB0= new MemoryPool(ahb0_ram, sizeof(ahb0_ram));
+    _AHB1= new MemoryPool(ahb1_ram, sizeof(ahb1_ram));
+}
+
+uint64_t host_now() { return now; }
+uint32_t host_pclk() { return SystemCoreClock / 4; }
+const host_stats_t& host_get_stats() { return stats; }
+void host_set_gpio_hook(host_gpio_hook_t fnc) { gpio_hook= fnc; }
+
+void host_gpio_write(uint8_t port, uint32_t mask, bool set)
+{
+    if(set) host_gpio[port].FIOPIN |= mask;
+    else host_gpio[port].FIOPIN &= ~mask;
+    if(gpio_hook) gpio_hook(port, mask, set, now);
+}
+
+// the count since the timer was last zero, the counter is 32 bits so a free running timer wraps
+static uint64_t elapsed(int timer)
+{
+    if(now <= timer_state[timer].base) return 0;
+    uint64_t tc= now - timer_state[timer].base;
+    timer_state[timer].base += (tc >> 32) << 32;
+    return tc & 0xFFFFFFFFULL;
+}
+
+uint32_t host_timer_read(uint8_t timer)
+{
+    if(timer > 1 || !timer_state[timer].running) return timer_state[timer].stopped_tc;
+    return elapsed(timer);
+}
+
+void host_timer_write(uint8_t timer, uint32_t tc)
+{
+    if(timer > 1) return;
+    timer_state[timer].stopped_tc= tc;
+    timer_state[timer].base= now - tc;
+}
+
+void host_timer_control(uint8_t timer, uint32_t tcr)
+{
+    if(timer > 1) return; // only TIMER0 and TIMER1 are emulated
+
+    uint32_t tc= host_timer_read(timer);
+    if(tcr & 2) tc= 0; // counter reset
+    timer_state[timer].running= (tcr & 3) == 1;
+    host_timer_write(timer, tc);
+}
+
+// time of the next match on MR0, the counter wraps if MR0 has been set behind it
+static uint64_t next_match(int timer)
+{
+    LPC_TIM_TypeDef *tim= &host_tim[timer];
+    uint64_t tc= elapsed(timer);
+    uint64_t match= timer_state[timer].base + tim->MR0;
+    if(tim->MR0 < tc) match += (1ULL << 32);
+    return match;
+}
+
+static int next_timer(uint64_t& when)
+{
+    int t= -1;
+    // TIMER1 has the higher priority so it wins any tie
+    for (int i = 1; i >= 0; --i) {
+        if(!timer_state[i].running || !irq_enabled[i]) continue;
+        uint64_t m= next_match(i);
+        if(t == -1 || m < when) {
+            when= m;
+            t= i;
+        }
+    }
+    return t;
+}
+
+bool host_run_next_interrupt()
+{
+    uint64_t when;
+    int t= next_timer(when);
+    if(t < 0) return false;
+
+    now= when;
+    LPC_TIM_TypeDef *tim= &host_tim[t];
+    tim->IR |= 1;
+    if(tim->MCR & 2) {
+        // reset on match, the counter is zero on the count after the match
+        timer_state[t].base= now + 1;
+        timer_state[t].stopped_tc= 0;
+    }
+    if(tim->MCR & 4) {
+        // stop on match
+        timer_state[t].stopped_tc= (tim->MCR & 2) ? 0 : tim->MR0;
+        timer_state[t].running= false;
+        tim->TCR= 0;
+    }
+
+    if(t == 0) {
+        ++stats.timer0_irqs;
+        TIMER0_IRQHandler();
+    } else {
+        ++stats.timer1_irqs;
+        TIMER1_IRQHandler();
+    }
+
+    // PendSV has the lowest priority of the three, it runs after the timer interrupt that set it pending
+    if(pendsv_pending) {
+        pendsv_pending= false;
+        ++stats.pendsv_irqs;
+        PendSV_Handler();
+    }
+    return true;
+}
+
+void host_pend_sv() { pendsv_pending= true; }
+
+void host_run_until(uint64_t time)
+{
+    uint64_t when;
+    while(next_timer(when) >= 0 && when <= time) {
+        host_run_next_interrupt();
+    }
+    if(time > now) now= time;
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    if(irq == TIMER0_IRQn) irq_enabled[0]= true;
+    else if(irq == TIMER1_IRQn) irq_enabled[1]= true;
+}
+
+void NVIC_DisableIRQ(IRQn_Type irq)
+{
+    if(irq == TIMER0_IRQn) irq_enabled[0]= false;
+    else if(irq == TIMER1_IRQn) irq_enabled[1]= false;
+}
+
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) {}
+uint32_t NVIC_GetPriority(IRQn_Type irq) { return 0; }
+void NVIC_SetPriorityGrouping(uint32_t group) {}
+void NVIC_SetPendingIRQ(IRQn_Type irq) {}
+
+void NVIC_SystemReset(void)
+{
+    fprintf(stderr, "system reset requested\n");
+    exit(1);
+}
+
+extern "C" void __debugbreak(void)
+{
+    fprintf(stderr, "__debugbreak() hit\n");
+    abort();
+}
+
+extern "C" int __mriPlatform_CommUartIndex(void) { return 0; }
+extern "C" void set_high_on_debug(int port, int pin) {}
+extern "C" void set_low_on_debug(int port, int pin) {}
+
+extern "C" uint32_t us_ticker_read(void)
+{
+    return (uint32_t)(now * 1000000ULL / host_pclk());
+}
+
+extern "C" void wait_us(int us)
+{
+    // interrupts keep running while we spin
+    host_run_until(now + (uint64_t)us * host_pclk() / 1000000ULL);
+}
+
+extern "C" void wait_ms(int ms) { wait_us(ms * 1000); }
+extern "C" void wait(float s) { wait_us(s * 1000000.0F); }
@@ -0,0 +1,34 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+// Simulated time is kept in timer counts (PCLK = SystemCoreClock/4), the same units the LPC timers count in.
+uint64_t host_now();
+uint32_t host_pclk();
+
+// Runs the emulated TIMER0/TIMER1 until the next interrupt has been serviced, returns false if no timer can fire
+bool host_run_next_interrupt();
+// Runs all interrupts that are due up to the given time, then advances the clock to it
+void host_run_until(uint64_t time);
+
+// Called for every GPIO set/clear register write, with the simulated time of the write
+using host_gpio_hook_t= std::function<void(uint8_t port, uint32_t mask, bool set, uint64_t time)>;
+void host_set_gpio_hook(host_gpio_hook_t fnc);
+
+struct host_stats_t {
+    uint64_t timer0_irqs;
+    uint64_t timer1_irqs;
+    uint64_t pendsv_irqs;
+};
+const host_stats_t& host_get_stats();
+
+// sets up the memory pools that stand in for the AHB0/AHB1 SRAM banks, must be called before the Kernel is created
+void host_hal_init();
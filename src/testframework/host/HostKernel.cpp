@@ -0,0 +1,99 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Host stand-ins for what libs/Kernel.cpp needs from the board
+
+    The host build compiles the unmodified Kernel.cpp. The modules it creates that are not part of the motion core
+    are replaced here: the serial console writes to stdout, and the slow ticker, adc and shell do nothing.
+    Config.cpp reads /sd/config, which is mapped to the config file given to host_kernel_create(), or config.default,
+    and the builtin firm config is linked in empty so the two are not merged.
+    On the board the step interrupts keep running while the main loop idles, here they are run on ON_IDLE.
+*/
+
+#include "libs/Kernel.h"
+#include "libs/Module.h"
+#include "libs/SlowTicker.h"
+#include "libs/Adc.h"
+#include "libs/StreamOutputPool.h"
+#include "modules/communication/SerialConsole.h"
+#include "SimpleShell.h"
+
+#include "HostHal.h"
+#include "HostKernel.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+// all output from the firmware goes to stdout
+SerialConsole::SerialConsole(int ch)
+{
+    uartn= ch;
+    query_flag= false;
+    halt_flag= false;
+    last_char_was_cr= false;
+    lf_count= 0;
+    feed_override_command= 0;
+}
+
+SerialConsole::~SerialConsole() {}
+void SerialConsole::init_uart(int baud_rate) {}
+void SerialConsole::on_module_loaded() { THEKERNEL->streams->append_stream(this); }
+void SerialConsole::on_main_loop(void *argument) {}
+void SerialConsole::on_idle(void *argument) {}
+int SerialConsole::_putc(int c) { return fputc(c, stdout); }
+int SerialConsole::_getc() { return -1; }
+bool SerialConsole::ready() { return false; }
+int SerialConsole::puts(const char *str) { return fputs(str, stdout) < 0 ? 0 : strlen(str); }
+
+SlowTicker::SlowTicker() {}
+void SlowTicker::on_module_loaded() {}
+void SlowTicker::on_idle(void *argument) {}
+void SlowTicker::set_frequency(int frequency) {}
+
+Adc::Adc() {}
+
+// the host build does not have the shell, GcodeDispatch hands it everything it does not understand
+void SimpleShell::on_module_loaded() {}
+void SimpleShell::on_console_line_received(void *argument) {}
+void SimpleShell::on_gcode_received(void *argument) {}
+void SimpleShell::on_second_tick(void *argument) {}
+
+bool SimpleShell::parse_command(const char *cmd, string args, StreamOutput *stream)
+{
+    return false;
+}
+
+static const char *host_config_file= HOST_CONFIG_DEFAULT;
+
+extern "C" FILE *__real_fopen(const char *path, const char *mode);
+
+// the link wraps fopen() with this, see the Makefile
+extern "C" FILE *__wrap_fopen(const char *path, const char *mode)
+{
+    if(strcmp(path, "/sd/config") == 0) path= host_config_file;
+    return __real_fopen(path, mode);
+}
+
+// runs the step interrupts that are due, after the modules have had their ON_IDLE
+class HostInterrupts : public Module {
+    public:
+        void on_module_loaded() { register_for_event(ON_IDLE); }
+        void on_idle(void *argument) { if(!host_run_next_interrupt()) host_run_until(host_now() + host_pclk() / 1000); }
+};
+
+Kernel *host_kernel_create(const char *config_file)
+{
+    if(config_file != nullptr) host_config_file= config_file;
+
+    Kernel *kernel= new Kernel();
+    // main.cpp and the version command would have read the chip
+    kernel->set_bad_mcu(false);
+    kernel->add_module(new HostInterrupts());
+    return kernel;
+}
@@ -0,0 +1,302 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    smoothie-sim: runs a gcode file through the real GcodeDispatch -> Robot -> Planner -> Conveyor -> StepTicker
+    chain on the host, and writes a trace of every step pulse the firmware would have generated.
+
+    usage: smoothie-sim -c config [-o trace] [-v] [-b] [-B] [-s ms] [file.gcode]
+
+    Each line of the trace is: time_in_us motor direction
+    where direction is 1 or -1. The gcode is read from stdin if no file is given.
+    A line that starts with ! is a feed hold and ~ resumes, as on the serial console, the resume waits for the
+    motors to stop, and 100ms more, before it is released. The moves after the ! have to come after the ~.
+    At the end a summary is printed and the exit code is non zero if any motor did not end up at the
+    position the planner expected.
+    With -B the gcode is sent as binary motion frames after an M800, encoded the way fast-stream.py -b does it,
+    see HostBinary.cpp, it should make the same steps as it does sent as text.
+    With -s the main loop stalls for that many ms after each line, as it would on a slow SD card read, the step interrupts
+    keep running and take the blocks the main loop has not prepared yet, the moves should still end up in position.
+    With -b it runs the arm solution microbenchmarks instead, and the gcode parser and binary motion benchmarks on the file
+    if one is given,
+    see HostBench.cpp.
+*/
+
+#include "libs/Kernel.h"
+#include "libs/Config.h"
+#include "libs/ConfigValue.h"
+#include "libs/StepTicker.h"
+#include "libs/StepperMotor.h"
+#include "libs/SerialMessage.h"
+#include "libs/StreamOutput.h"
+#include "libs/utils.h"
+#include "modules/robot/Robot.h"
+#include "modules/robot/Conveyor.h"
+#include "modules/communication/utils/Gcode.h"
+#include "modules/communication/BinaryMotion.h"
+
+#include "HostHal.h"
+#include "HostKernel.h"
+#include "HostBench.h"
+#include "HostBinary.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+// replies go to stdout, the ok per line and the ack per frame are dropped unless verbose
+class SimStreamOutput : public StreamOutput {
+    public:
+        SimStreamOutput(bool verbose) : verbose(verbose), binary(false) {}
+        int puts(const char *str)
+        {
+            if(!verbose && strcmp(str, "ok\r\n") == 0) return strlen(str);
+            if(!verbose && strcmp(str, "ok\n") == 0) return strlen(str);
+            if(!verbose && strncmp(str, "ack ", 4) == 0) return strlen(str);
+            return fputs(str, stdout) < 0 ? 0 : strlen(str);
+        }
+        bool set_binary_mode(bool on) { binary= on; return true; }
+
+        bool verbose;
+        bool binary;
+};
+
+struct sim_motor_t {
+    Pin step_pin;
+    bool last_state;
+    uint64_t steps;
+};
+
+static const char *motor_names[]= {"alpha", "beta", "gamma", "delta", "epsilon", "zeta"};
+
+static bool motors_moving()
+{
+    for(auto a : THEROBOT->actuators) {
+        if(a->is_moving()) return true;
+    }
+    return false;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s -c config [-o trace] [-v] [-b] [-B] [-s ms] [file.gcode]\n", prog);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *config_file= nullptr;
+    const char *trace_file= nullptr;
+    bool verbose= false;
+    bool bench= false;
+    bool binary= false;
+    float stall_ms= 0;
+
+    int c;
+    while((c= getopt(argc, argv, "c:o:vbBs:h")) != -1) {
+        switch(c) {
+            case 'c': config_file= optarg; break;
+            case 'o': trace_file= optarg; break;
+            case 'v': verbose= true; break;
+            case 'b': bench= true; break;
+            case 'B': binary= true; break;
+            case 's': stall_ms= atof(optarg); break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+
+    if(config_file == nullptr) {
+        // config.default does not define any motors, so a config file is always needed
+        usage(argv[0]);
+        return 2;
+    }
+
+    FILE *gfp= stdin;
+    if(optind < argc) {
+        gfp= fopen(argv[optind], "r");
+        if(gfp == NULL) {
+            fprintf(stderr, "cannot open gcode file %s\n", argv[optind]);
+            return 2;
+        }
+    }
+
+    FILE *cfp= fopen(config_file, "r");
+    if(cfp == NULL) {
+        fprintf(stderr, "cannot open config file %s\n", config_file);
+        return 2;
+    }
+    fclose(cfp);
+
+    FILE *tfp= nullptr;
+    if(trace_file != nullptr) {
+        tfp= fopen(trace_file, "w");
+        if(tfp == NULL) {
+            fprintf(stderr, "cannot create trace file %s\n", trace_file);
+            return 2;
+        }
+    }
+
+    host_hal_init();
+    Kernel *kernel= host_kernel_create(config_file);
+
+    uint8_t n_motors= THEROBOT->get_number_registered_motors();
+    if(n_motors < 3) {
+        fprintf(stderr, "config does not define the XYZ motors\n");
+        return 2;
+    }
+
+    if(bench) {
+        int ret= run_ik_bench();
+        if(optind < argc && run_gcode_bench(argv[optind]) != 0) ret= 1;
+        if(optind < argc && run_binary_bench(argv[optind]) != 0) ret= 1;
+        return ret;
+    }
+
+    // map the step pins back to the motors so we can see the step pulses
+    std::vector<sim_motor_t> motors(n_motors);
+    for (int i = 0; i < n_motors; ++i) {
+        std::string key= std::string(motor_names[i]) + "_step_pin";
+        motors[i].step_pin.from_string(kernel->config->value(get_checksum(key))->by_default("nc")->as_string());
+        motors[i].last_state= motors[i].step_pin.get();
+        motors[i].steps= 0;
+    }
+
+    host_set_gpio_hook([&motors, tfp, n_motors](uint8_t port, uint32_t mask, bool set, uint64_t time) {
+        for (int i = 0; i < n_motors; ++i) {
+            sim_motor_t& m= motors[i];
+            if(m.step_pin.port_number != port || (mask & (1 << m.step_pin.pin)) == 0) continue;
+            bool state= m.step_pin.get();
+            if(state && !m.last_state) {
+                ++m.steps;
+                if(tfp != nullptr) {
+                    fprintf(tfp, "%1.2f %d %d\n", time * 1000000.0 / host_pclk(), i, THEROBOT->actuators[i]->which_direction() ? -1 : 1);
+                }
+            }
+            m.last_state= state;
+        }
+    });
+
+    // same as main.cpp once all modules are loaded
+    kernel->conveyor->start(n_motors);
+    kernel->step_ticker->start();
+
+    SimStreamOutput stream(verbose);
+
+    BinaryMotion decoder;
+    BinaryEncoder encoder;
+    size_t text_bytes= 0;
+    if(binary) {
+        struct SerialMessage message= {&stream, "M800"};
+        kernel->call_event(ON_CONSOLE_LINE_RECEIVED, &message);
+        if(!stream.binary) {
+            fprintf(stderr, "M800 did not switch to binary\n");
+            return 2;
+        }
+    }
+
+    // the frames go in one each time round the main loop, as USBSerial takes them
+    auto send_frames= [&]() {
+        while(encoder.has_frame() && !kernel->is_halted()) {
+            while(THEROBOT->is_move_queue_full() && !kernel->is_halted()) {
+                kernel->call_event(ON_MAIN_LOOP);
+                kernel->call_event(ON_IDLE);
+            }
+            for(uint8_t b : encoder.take_frame()) decoder.receive(b, &stream);
+            if(decoder.is_ended()) stream.set_binary_mode(false);
+            kernel->call_event(ON_MAIN_LOOP);
+            kernel->call_event(ON_IDLE);
+        }
+    };
+
+    char buf[256];
+    while(fgets(buf, sizeof(buf), gfp) != NULL) {
+        if(binary && buf[0] != '!' && buf[0] != '~') {
+            text_bytes += strlen(buf);
+            if(!encoder.add_line(buf)) {
+                fprintf(stderr, "line is too long to send in a frame: %s", buf);
+                return 2;
+            }
+            send_frames();
+            if(kernel->is_halted()) break;
+            continue;
+        }
+
+        if(binary) {
+            // what is still in the frame goes before the hold or resume
+            encoder.flush();
+            send_frames();
+        }
+
+        // the realtime feed hold and resume, the serial consoles act on these as they are received
+        if(buf[0] == '!') {
+            kernel->set_feed_hold(true);
+            continue;
+        }
+        if(buf[0] == '~') {
+            // the hold has to stop the motors first, then it stays stopped a while so it shows in the trace
+            while(motors_moving()) kernel->call_event(ON_IDLE);
+            uint64_t resume= host_now() + host_pclk() / 10;
+            while(host_now() < resume) kernel->call_event(ON_IDLE);
+            kernel->set_feed_hold(false);
+            continue;
+        }
+
+        // the consoles hold the next line back until the Robot has room for another move
+        while(THEROBOT->is_move_queue_full() && !kernel->is_halted()) {
+            kernel->call_event(ON_MAIN_LOOP);
+            kernel->call_event(ON_IDLE);
+        }
+
+        struct SerialMessage message= {&stream, buf};
+        kernel->call_event(ON_CONSOLE_LINE_RECEIVED, &message);
+        kernel->call_event(ON_MAIN_LOOP);
+        kernel->call_event(ON_IDLE);
+        if(stall_ms > 0) host_run_until(host_now() + (uint64_t)(stall_ms * host_pclk() / 1000));
+        if(kernel->is_halted()) break;
+    }
+    if(gfp != stdin) fclose(gfp);
+
+    if(binary) {
+        encoder.end();
+        send_frames();
+        if(stream.binary) printf("binary mode did not end\n");
+        printf("binary: %lu moves and %lu text lines in %lu frames, %lu bytes, %lu bytes as text\n", (unsigned long)encoder.moves,
+               (unsigned long)encoder.texts, (unsigned long)encoder.frame_count, (unsigned long)encoder.bytes, (unsigned long)text_bytes);
+    }
+
+    // let everything that was queued run out
+    kernel->conveyor->wait_for_idle();
+    // and the rest of the step pulses of the last tick, the unstep timer gives them to the motors after it
+    host_run_until(host_now() + host_pclk() / 1000);
+
+    if(tfp != nullptr) fclose(tfp);
+
+    const host_stats_t& stats= host_get_stats();
+    printf("simulated time: %1.6f s, step ticks: %llu, unstep ticks: %llu\n", (double)host_now() / host_pclk(),
+           (unsigned long long)stats.timer0_irqs, (unsigned long long)stats.timer1_irqs);
+    printf("blocks the main loop was late to prepare: %llu\n", (unsigned long long)stats.pendsv_irqs);
+    Gcode::alloc_stats_t gs= Gcode::get_alloc_stats();
+    printf("gcodes: %lu from pool, %lu from heap, %lu long lines on heap\n", (unsigned long)gs.from_pool, (unsigned long)gs.from_heap,
+           (unsigned long)gs.long_lines);
+
+    int ret= 0;
+    for (int i = 0; i < n_motors; ++i) {
+        StepperMotor *a= THEROBOT->actuators[i];
+        bool ok= a->get_current_step() == a->get_last_milestone_steps();
+        printf("motor %d: %llu steps, position %ld, expected %ld%s\n", i, (unsigned long long)motors[i].steps,
+               (long)a->get_current_step(), (long)a->get_last_milestone_steps(), ok ? "" : " MISMATCH");
+        if(!ok) ret= 1;
+    }
+
+    if(kernel->is_halted()) {
+        printf("system is halted\n");
+        ret= 1;
+    }
+
+    return ret;
+}
@@ -0,0 +1,1283 @@
+; the first four layers of a small round part, laid out and numbered the way Slic3r writes its gcode
+; it was written for the benchmark, no slicer was at hand, so it is not slicer output, run make bench BENCH_GCODE=file.gcode on a real one
+
+; external perimeters extrusion width = 0.45mm
+; perimeters extrusion width = 0.45mm
+; infill extrusion width = 0.45mm
+; solid infill extrusion width = 0.45mm
+; top infill extrusion width = 0.45mm
+
+M107
+M104 S205 ; set temperature
+G28 ; home all axes
+G1 Z5 F5000 ; lift nozzle
+
+M109 S205 ; wait for temperature to be reached
+G21 ; set units to millimeters
+G90 ; use absolute coordinates
+M82 ; use absolute distances for extrusion
+G92 E0
+G1 Z0.300 F7800.000
+G92 E0
+G1 E-2.00000 F2400.00000
+G1 X120.000 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.598 Y101.802 E0.06322
+G1 X120.903 Y103.686 E0.12677
+G1 X120.811 Y105.576 E0.18980
+G1 X120.275 Y107.379 E0.25244
+G1 X119.314 Y109.006 E0.31536
+G1 X118.013 Y110.400 E0.37884
+G1 X116.497 Y111.552 E0.44224
+G1 X114.902 Y112.504 E0.50412
+G1 X113.342 Y113.342 E0.56307
+G1 X111.889 Y114.169 E0.61874
+G1 X110.557 Y115.077 E0.67243
+G1 X109.307 Y116.121 E0.72665
+G1 X108.065 Y117.294 E0.78357
+G1 X106.745 Y118.533 E0.84382
+G1 X105.284 Y119.719 E0.90650
+G1 X103.652 Y120.709 E0.97007
+G1 X101.869 Y121.368 E1.03335
+G1 X100.000 Y121.600 E1.09608
+G1 X98.131 Y121.368 E1.15881
+G1 X96.348 Y120.709 E1.22208
+G1 X94.716 Y119.719 E1.28565
+G1 X93.255 Y118.533 E1.34833
+G1 X91.935 Y117.294 E1.40858
+G1 X90.693 Y116.121 E1.46551
+G1 X89.443 Y115.077 E1.51973
+G1 X88.111 Y114.169 E1.57341
+G1 X86.658 Y113.342 E1.62908
+G1 X85.098 Y112.504 E1.68804
+G1 X83.503 Y111.552 E1.74992
+G1 X81.987 Y110.400 E1.81332
+G1 X80.686 Y109.006 E1.87680
+G1 X79.725 Y107.379 E1.93971
+G1 X79.189 Y105.576 E2.00235
+G1 X79.097 Y103.686 E2.06539
+G1 X79.402 Y101.802 E2.12893
+G1 X80.000 Y100.000 E2.19216
+G1 X80.750 Y98.316 E2.25354
+G1 X81.511 Y96.740 E2.31182
+G1 X82.174 Y95.224 E2.36694
+G1 X82.687 Y93.699 E2.42051
+G1 X83.062 Y92.102 E2.47514
+G1 X83.372 Y90.400 E2.53274
+G1 X83.731 Y88.608 E2.59358
+G1 X84.260 Y86.792 E2.65656
+G1 X85.058 Y85.058 E2.72014
+G1 X86.178 Y83.527 E2.78330
+G1 X87.614 Y82.311 E2.84597
+G1 X89.307 Y81.479 E2.90878
+G1 X91.160 Y81.042 E2.97217
+G1 X93.065 Y80.945 E3.03568
+G1 X94.931 Y81.081 E3.09799
+G1 X96.706 Y81.317 E3.15761
+G1 X98.383 Y81.521 E3.21389
+G1 X100.000 Y81.600 E3.26779
+G1 X101.617 Y81.521 E3.32169
+G1 X103.294 Y81.317 E3.37797
+G1 X105.069 Y81.081 E3.43759
+G1 X106.935 Y80.945 E3.49990
+G1 X108.840 Y81.042 E3.56341
+G1 X110.693 Y81.479 E3.62680
+G1 X112.386 Y82.311 E3.68961
+G1 X113.822 Y83.527 E3.75228
+G1 X114.942 Y85.058 E3.81544
+G1 X115.740 Y86.792 E3.87902
+G1 X116.269 Y88.608 E3.94200
+G1 X116.628 Y90.400 E4.00284
+G1 X116.938 Y92.102 E4.06044
+G1 X117.313 Y93.699 E4.11507
+G1 X117.826 Y95.224 E4.16864
+G1 X118.489 Y96.740 E4.22376
+G1 X119.250 Y98.316 E4.28204
+G1 X120.000 Y100.000 E4.34343
+G1 E2.34343 F2400.00000
+G92 E0
+G1 X119.550 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.134 Y101.762 E0.06180
+G1 X120.433 Y103.603 E0.12392
+G1 X120.343 Y105.451 E0.18553
+G1 X119.818 Y107.213 E0.24676
+G1 X118.879 Y108.804 E0.30826
+G1 X117.608 Y110.166 E0.37032
+G1 X116.126 Y111.292 E0.43229
+G1 X114.566 Y112.223 E0.49277
+G1 X113.042 Y113.042 E0.55040
+G1 X111.622 Y113.850 E0.60482
+G1 X110.320 Y114.738 E0.65730
+G1 X109.098 Y115.758 E0.71030
+G1 X107.883 Y116.905 E0.76594
+G1 X106.594 Y118.116 E0.82484
+G1 X105.165 Y119.275 E0.88610
+G1 X103.569 Y120.243 E0.94825
+G1 X101.827 Y120.888 E1.01010
+G1 X100.000 Y121.114 E1.07142
+G1 X98.173 Y120.888 E1.13273
+G1 X96.431 Y120.243 E1.19459
+G1 X94.835 Y119.275 E1.25673
+G1 X93.406 Y118.116 E1.31800
+G1 X92.117 Y116.905 E1.37689
+G1 X90.902 Y115.758 E1.43254
+G1 X89.680 Y114.738 E1.48553
+G1 X88.378 Y113.850 E1.53801
+G1 X86.958 Y113.042 E1.59243
+G1 X85.434 Y112.223 E1.65006
+G1 X83.874 Y111.292 E1.71055
+G1 X82.392 Y110.166 E1.77252
+G1 X81.121 Y108.804 E1.83457
+G1 X80.182 Y107.213 E1.89607
+G1 X79.657 Y105.451 E1.95730
+G1 X79.567 Y103.603 E2.01891
+G1 X79.866 Y101.762 E2.08103
+G1 X80.450 Y100.000 E2.14283
+G1 X81.183 Y98.354 E2.20284
+G1 X81.927 Y96.813 E2.25981
+G1 X82.575 Y95.331 E2.31368
+G1 X83.076 Y93.840 E2.36605
+G1 X83.443 Y92.279 E2.41945
+G1 X83.746 Y90.616 E2.47575
+G1 X84.097 Y88.865 E2.53522
+G1 X84.614 Y87.090 E2.59679
+G1 X85.394 Y85.394 E2.65894
+G1 X86.489 Y83.898 E2.72067
+G1 X87.893 Y82.709 E2.78194
+G1 X89.548 Y81.896 E2.84333
+G1 X91.359 Y81.469 E2.90530
+G1 X93.221 Y81.374 E2.96738
+G1 X95.045 Y81.507 E3.02829
+G1 X96.780 Y81.737 E3.08657
+G1 X98.420 Y81.936 E3.14158
+G1 X100.000 Y82.014 E3.19427
+G1 X101.580 Y81.936 E3.24695
+G1 X103.220 Y81.737 E3.30197
+G1 X104.955 Y81.507 E3.36024
+G1 X106.779 Y81.374 E3.42115
+G1 X108.641 Y81.469 E3.48323
+G1 X110.452 Y81.896 E3.54520
+G1 X112.107 Y82.709 E3.60659
+G1 X113.511 Y83.898 E3.66786
+G1 X114.606 Y85.394 E3.72959
+G1 X115.386 Y87.090 E3.79174
+G1 X115.903 Y88.865 E3.85331
+G1 X116.254 Y90.616 E3.91278
+G1 X116.557 Y92.279 E3.96908
+G1 X116.924 Y93.840 E4.02248
+G1 X117.425 Y95.331 E4.07485
+G1 X118.073 Y96.813 E4.12872
+G1 X118.817 Y98.354 E4.18569
+G1 X119.550 Y100.000 E4.24570
+G1 E2.24570 F2400.00000
+G92 E0
+G1 X119.100 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X119.671 Y101.721 E0.06038
+G1 X119.963 Y103.520 E0.12107
+G1 X119.875 Y105.325 E0.18126
+G1 X119.362 Y107.047 E0.24108
+G1 X118.445 Y108.601 E0.30117
+G1 X117.203 Y109.932 E0.36179
+G1 X115.755 Y111.032 E0.42234
+G1 X114.231 Y111.941 E0.48143
+G1 X112.742 Y112.742 E0.53774
+G1 X111.354 Y113.532 E0.59090
+G1 X110.082 Y114.399 E0.64217
+G1 X108.888 Y115.395 E0.69395
+G1 X107.702 Y116.516 E0.74831
+G1 X106.442 Y117.699 E0.80585
+G1 X105.046 Y118.831 E0.86571
+G1 X103.487 Y119.777 E0.92642
+G1 X101.785 Y120.407 E0.98685
+G1 X100.000 Y120.628 E1.04675
+G1 X98.215 Y120.407 E1.10666
+G1 X96.513 Y119.777 E1.16709
+G1 X94.954 Y118.831 E1.22780
+G1 X93.558 Y117.699 E1.28766
+G1 X92.298 Y116.516 E1.34520
+G1 X91.112 Y115.395 E1.39956
+G1 X89.918 Y114.399 E1.45134
+G1 X88.646 Y113.532 E1.50261
+G1 X87.258 Y112.742 E1.55577
+G1 X85.769 Y111.941 E1.61208
+G1 X84.245 Y111.032 E1.67117
+G1 X82.797 Y109.932 E1.73172
+G1 X81.555 Y108.601 E1.79234
+G1 X80.638 Y107.047 E1.85242
+G1 X80.125 Y105.325 E1.91225
+G1 X80.037 Y103.520 E1.97244
+G1 X80.329 Y101.721 E2.03313
+G1 X80.900 Y100.000 E2.09351
+G1 X81.616 Y98.392 E2.15214
+G1 X82.343 Y96.887 E2.20779
+G1 X82.976 Y95.439 E2.26042
+G1 X83.466 Y93.982 E2.31159
+G1 X83.824 Y92.457 E2.36376
+G1 X84.121 Y90.832 E2.41876
+G1 X84.463 Y89.121 E2.47687
+G1 X84.968 Y87.387 E2.53702
+G1 X85.730 Y85.730 E2.59774
+G1 X86.800 Y84.269 E2.65805
+G1 X88.172 Y83.107 E2.71790
+G1 X89.788 Y82.313 E2.77789
+G1 X91.558 Y81.895 E2.83842
+G1 X93.377 Y81.803 E2.89908
+G1 X95.159 Y81.933 E2.95858
+G1 X96.854 Y82.157 E3.01552
+G1 X98.456 Y82.352 E3.06926
+G1 X100.000 Y82.428 E3.12074
+G1 X101.544 Y82.352 E3.17222
+G1 X103.146 Y82.157 E3.22596
+G1 X104.841 Y81.933 E3.28290
+G1 X106.623 Y81.803 E3.34240
+G1 X108.442 Y81.895 E3.40306
+G1 X110.212 Y82.313 E3.46359
+G1 X111.828 Y83.107 E3.52358
+G1 X113.200 Y84.269 E3.58343
+G1 X114.270 Y85.730 E3.64374
+G1 X115.032 Y87.387 E3.70446
+G1 X115.537 Y89.121 E3.76461
+G1 X115.879 Y90.832 E3.82272
+G1 X116.176 Y92.457 E3.87772
+G1 X116.534 Y93.982 E3.92989
+G1 X117.024 Y95.439 E3.98105
+G1 X117.657 Y96.887 E4.03369
+G1 X118.384 Y98.392 E4.08934
+G1 X119.100 Y100.000 E4.14797
+G1 E2.14797 F2400.00000
+G92 E0
+G1 X83.000 Y83.000 F7800.000
+G1 E2.00000 F2400.00000
+G1 F3600
+G1 X83.000 Y83.000 E2.00000
+G1 X117.000 Y83.000 E3.13220
+G1 X117.000 Y83.900 E3.13220
+G1 X83.000 Y83.900 E4.26440
+G1 X83.000 Y84.800 E4.26440
+G1 X117.000 Y84.800 E5.39660
+G1 X117.000 Y85.700 E5.39660
+G1 X83.000 Y85.700 E6.52880
+G1 X83.000 Y86.600 E6.52880
+G1 X117.000 Y86.600 E7.66100
+G1 X117.000 Y87.500 E7.66100
+G1 X83.000 Y87.500 E8.79320
+G1 X83.000 Y88.400 E8.79320
+G1 X117.000 Y88.400 E9.92540
+G1 X117.000 Y89.300 E9.92540
+G1 X83.000 Y89.300 E11.05760
+G1 X83.000 Y90.200 E11.05760
+G1 X117.000 Y90.200 E12.18980
+G1 X117.000 Y91.100 E12.18980
+G1 X83.000 Y91.100 E13.32200
+G1 X83.000 Y92.000 E13.32200
+G1 X117.000 Y92.000 E14.45420
+G1 X117.000 Y92.900 E14.45420
+G1 X83.000 Y92.900 E15.58640
+G1 X83.000 Y93.800 E15.58640
+G1 X117.000 Y93.800 E16.71860
+G1 X117.000 Y94.700 E16.71860
+G1 X83.000 Y94.700 E17.85080
+G1 X83.000 Y95.600 E17.85080
+G1 X117.000 Y95.600 E18.98300
+G1 X117.000 Y96.500 E18.98300
+G1 X83.000 Y96.500 E20.11520
+G1 X83.000 Y97.400 E20.11520
+G1 X117.000 Y97.400 E21.24740
+G1 X117.000 Y98.300 E21.24740
+G1 X83.000 Y98.300 E22.37960
+G1 X83.000 Y99.200 E22.37960
+G1 X117.000 Y99.200 E23.51180
+G1 X117.000 Y100.100 E23.51180
+G1 X83.000 Y100.100 E24.64400
+G1 X83.000 Y101.000 E24.64400
+G1 X117.000 Y101.000 E25.77620
+G1 X117.000 Y101.900 E25.77620
+G1 X83.000 Y101.900 E26.90840
+G1 X83.000 Y102.800 E26.90840
+G1 X117.000 Y102.800 E28.04060
+G1 X117.000 Y103.700 E28.04060
+G1 X83.000 Y103.700 E29.17280
+G1 X83.000 Y104.600 E29.17280
+G1 X117.000 Y104.600 E30.30500
+G1 X117.000 Y105.500 E30.30500
+G1 X83.000 Y105.500 E31.43720
+G1 X83.000 Y106.400 E31.43720
+G1 X117.000 Y106.400 E32.56940
+G1 X117.000 Y107.300 E32.56940
+G1 X83.000 Y107.300 E33.70160
+G1 X83.000 Y108.200 E33.70160
+G1 X117.000 Y108.200 E34.83380
+G1 X117.000 Y109.100 E34.83380
+G1 X83.000 Y109.100 E35.96600
+G1 X83.000 Y110.000 E35.96600
+G1 X117.000 Y110.000 E37.09820
+G1 X117.000 Y110.900 E37.09820
+G1 X83.000 Y110.900 E38.23040
+G1 X83.000 Y111.800 E38.23040
+G1 X117.000 Y111.800 E39.36260
+G1 X117.000 Y112.700 E39.36260
+G1 X83.000 Y112.700 E40.49480
+G1 X83.000 Y113.600 E40.49480
+G1 X117.000 Y113.600 E41.62700
+G1 X117.000 Y114.500 E41.62700
+G1 X83.000 Y114.500 E42.75920
+G1 X83.000 Y115.400 E42.75920
+G1 X117.000 Y115.400 E43.89140
+G1 X117.000 Y116.300 E43.89140
+G1 X83.000 Y116.300 E45.02360
+G1 E43.02360 F2400.00000
+G92 E0
+G1 Z0.500 F7800.000
+M106 S255
+G92 E0
+G1 E-2.00000 F2400.00000
+G1 X120.000 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.598 Y101.802 E0.06322
+G1 X120.903 Y103.686 E0.12677
+G1 X120.811 Y105.576 E0.18980
+G1 X120.275 Y107.379 E0.25244
+G1 X119.314 Y109.006 E0.31536
+G1 X118.013 Y110.400 E0.37884
+G1 X116.497 Y111.552 E0.44224
+G1 X114.902 Y112.504 E0.50412
+G1 X113.342 Y113.342 E0.56307
+G1 X111.889 Y114.169 E0.61874
+G1 X110.557 Y115.077 E0.67243
+G1 X109.307 Y116.121 E0.72665
+G1 X108.065 Y117.294 E0.78357
+G1 X106.745 Y118.533 E0.84382
+G1 X105.284 Y119.719 E0.90650
+G1 X103.652 Y120.709 E0.97007
+G1 X101.869 Y121.368 E1.03335
+G1 X100.000 Y121.600 E1.09608
+G1 X98.131 Y121.368 E1.15881
+G1 X96.348 Y120.709 E1.22208
+G1 X94.716 Y119.719 E1.28565
+G1 X93.255 Y118.533 E1.34833
+G1 X91.935 Y117.294 E1.40858
+G1 X90.693 Y116.121 E1.46551
+G1 X89.443 Y115.077 E1.51973
+G1 X88.111 Y114.169 E1.57341
+G1 X86.658 Y113.342 E1.62908
+G1 X85.098 Y112.504 E1.68804
+G1 X83.503 Y111.552 E1.74992
+G1 X81.987 Y110.400 E1.81332
+G1 X80.686 Y109.006 E1.87680
+G1 X79.725 Y107.379 E1.93971
+G1 X79.189 Y105.576 E2.00235
+G1 X79.097 Y103.686 E2.06539
+G1 X79.402 Y101.802 E2.12893
+G1 X80.000 Y100.000 E2.19216
+G1 X80.750 Y98.316 E2.25354
+G1 X81.511 Y96.740 E2.31182
+G1 X82.174 Y95.224 E2.36694
+G1 X82.687 Y93.699 E2.42051
+G1 X83.062 Y92.102 E2.47514
+G1 X83.372 Y90.400 E2.53274
+G1 X83.731 Y88.608 E2.59358
+G1 X84.260 Y86.792 E2.65656
+G1 X85.058 Y85.058 E2.72014
+G1 X86.178 Y83.527 E2.78330
+G1 X87.614 Y82.311 E2.84597
+G1 X89.307 Y81.479 E2.90878
+G1 X91.160 Y81.042 E2.97217
+G1 X93.065 Y80.945 E3.03568
+G1 X94.931 Y81.081 E3.09799
+G1 X96.706 Y81.317 E3.15761
+G1 X98.383 Y81.521 E3.21389
+G1 X100.000 Y81.600 E3.26779
+G1 X101.617 Y81.521 E3.32169
+G1 X103.294 Y81.317 E3.37797
+G1 X105.069 Y81.081 E3.43759
+G1 X106.935 Y80.945 E3.49990
+G1 X108.840 Y81.042 E3.56341
+G1 X110.693 Y81.479 E3.62680
+G1 X112.386 Y82.311 E3.68961
+G1 X113.822 Y83.527 E3.75228
+G1 X114.942 Y85.058 E3.81544
+G1 X115.740 Y86.792 E3.87902
+G1 X116.269 Y88.608 E3.94200
+G1 X116.628 Y90.400 E4.00284
+G1 X116.938 Y92.102 E4.06044
+G1 X117.313 Y93.699 E4.11507
+G1 X117.826 Y95.224 E4.16864
+G1 X118.489 Y96.740 E4.22376
+G1 X119.250 Y98.316 E4.28204
+G1 X120.000 Y100.000 E4.34343
+G1 E2.34343 F2400.00000
+G92 E0
+G1 X119.550 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.134 Y101.762 E0.06180
+G1 X120.433 Y103.603 E0.12392
+G1 X120.343 Y105.451 E0.18553
+G1 X119.818 Y107.213 E0.24676
+G1 X118.879 Y108.804 E0.30826
+G1 X117.608 Y110.166 E0.37032
+G1 X116.126 Y111.292 E0.43229
+G1 X114.566 Y112.223 E0.49277
+G1 X113.042 Y113.042 E0.55040
+G1 X111.622 Y113.850 E0.60482
+G1 X110.320 Y114.738 E0.65730
+G1 X109.098 Y115.758 E0.71030
+G1 X107.883 Y116.905 E0.76594
+G1 X106.594 Y118.116 E0.82484
+G1 X105.165 Y119.275 E0.88610
+G1 X103.569 Y120.243 E0.94825
+G1 X101.827 Y120.888 E1.01010
+G1 X100.000 Y121.114 E1.07142
+G1 X98.173 Y120.888 E1.13273
+G1 X96.431 Y120.243 E1.19459
+G1 X94.835 Y119.275 E1.25673
+G1 X93.406 Y118.116 E1.31800
+G1 X92.117 Y116.905 E1.37689
+G1 X90.902 Y115.758 E1.43254
+G1 X89.680 Y114.738 E1.48553
+G1 X88.378 Y113.850 E1.53801
+G1 X86.958 Y113.042 E1.59243
+G1 X85.434 Y112.223 E1.65006
+G1 X83.874 Y111.292 E1.71055
+G1 X82.392 Y110.166 E1.77252
+G1 X81.121 Y108.804 E1.83457
+G1 X80.182 Y107.213 E1.89607
+G1 X79.657 Y105.451 E1.95730
+G1 X79.567 Y103.603 E2.01891
+G1 X79.866 Y101.762 E2.08103
+G1 X80.450 Y100.000 E2.14283
+G1 X81.183 Y98.354 E2.20284
+G1 X81.927 Y96.813 E2.25981
+G1 X82.575 Y95.331 E2.31368
+G1 X83.076 Y93.840 E2.36605
+G1 X83.443 Y92.279 E2.41945
+G1 X83.746 Y90.616 E2.47575
+G1 X84.097 Y88.865 E2.53522
+G1 X84.614 Y87.090 E2.59679
+G1 X85.394 Y85.394 E2.65894
+G1 X86.489 Y83.898 E2.72067
+G1 X87.893 Y82.709 E2.78194
+G1 X89.548 Y81.896 E2.84333
+G1 X91.359 Y81.469 E2.90530
+G1 X93.221 Y81.374 E2.96738
+G1 X95.045 Y81.507 E3.02829
+G1 X96.780 Y81.737 E3.08657
+G1 X98.420 Y81.936 E3.14158
+G1 X100.000 Y82.014 E3.19427
+G1 X101.580 Y81.936 E3.24695
+G1 X103.220 Y81.737 E3.30197
+G1 X104.955 Y81.507 E3.36024
+G1 X106.779 Y81.374 E3.42115
+G1 X108.641 Y81.469 E3.48323
+G1 X110.452 Y81.896 E3.54520
+G1 X112.107 Y82.709 E3.60659
+G1 X113.511 Y83.898 E3.66786
+G1 X114.606 Y85.394 E3.72959
+G1 X115.386 Y87.090 E3.79174
+G1 X115.903 Y88.865 E3.85331
+G1 X116.254 Y90.616 E3.91278
+G1 X116.557 Y92.279 E3.96908
+G1 X116.924 Y93.840 E4.02248
+G1 X117.425 Y95.331 E4.07485
+G1 X118.073 Y96.813 E4.12872
+G1 X118.817 Y98.354 E4.18569
+G1 X119.550 Y100.000 E4.24570
+G1 E2.24570 F2400.00000
+G92 E0
+G1 X119.100 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X119.671 Y101.721 E0.06038
+G1 X119.963 Y103.520 E0.12107
+G1 X119.875 Y105.325 E0.18126
+G1 X119.362 Y107.047 E0.24108
+G1 X118.445 Y108.601 E0.30117
+G1 X117.203 Y109.932 E0.36179
+G1 X115.755 Y111.032 E0.42234
+G1 X114.231 Y111.941 E0.48143
+G1 X112.742 Y112.742 E0.53774
+G1 X111.354 Y113.532 E0.59090
+G1 X110.082 Y114.399 E0.64217
+G1 X108.888 Y115.395 E0.69395
+G1 X107.702 Y116.516 E0.74831
+G1 X106.442 Y117.699 E0.80585
+G1 X105.046 Y118.831 E0.86571
+G1 X103.487 Y119.777 E0.92642
+G1 X101.785 Y120.407 E0.98685
+G1 X100.000 Y120.628 E1.04675
+G1 X98.215 Y120.407 E1.10666
+G1 X96.513 Y119.777 E1.16709
+G1 X94.954 Y118.831 E1.22780
+G1 X93.558 Y117.699 E1.28766
+G1 X92.298 Y116.516 E1.34520
+G1 X91.112 Y115.395 E1.39956
+G1 X89.918 Y114.399 E1.45134
+G1 X88.646 Y113.532 E1.50261
+G1 X87.258 Y112.742 E1.55577
+G1 X85.769 Y111.941 E1.61208
+G1 X84.245 Y111.032 E1.67117
+G1 X82.797 Y109.932 E1.73172
+G1 X81.555 Y108.601 E1.79234
+G1 X80.638 Y107.047 E1.85242
+G1 X80.125 Y105.325 E1.91225
+G1 X80.037 Y103.520 E1.97244
+G1 X80.329 Y101.721 E2.03313
+G1 X80.900 Y100.000 E2.09351
+G1 X81.616 Y98.392 E2.15214
+G1 X82.343 Y96.887 E2.20779
+G1 X82.976 Y95.439 E2.26042
+G1 X83.466 Y93.982 E2.31159
+G1 X83.824 Y92.457 E2.36376
+G1 X84.121 Y90.832 E2.41876
+G1 X84.463 Y89.121 E2.47687
+G1 X84.968 Y87.387 E2.53702
+G1 X85.730 Y85.730 E2.59774
+G1 X86.800 Y84.269 E2.65805
+G1 X88.172 Y83.107 E2.71790
+G1 X89.788 Y82.313 E2.77789
+G1 X91.558 Y81.895 E2.83842
+G1 X93.377 Y81.803 E2.89908
+G1 X95.159 Y81.933 E2.95858
+G1 X96.854 Y82.157 E3.01552
+G1 X98.456 Y82.352 E3.06926
+G1 X100.000 Y82.428 E3.12074
+G1 X101.544 Y82.352 E3.17222
+G1 X103.146 Y82.157 E3.22596
+G1 X104.841 Y81.933 E3.28290
+G1 X106.623 Y81.803 E3.34240
+G1 X108.442 Y81.895 E3.40306
+G1 X110.212 Y82.313 E3.46359
+G1 X111.828 Y83.107 E3.52358
+G1 X113.200 Y84.269 E3.58343
+G1 X114.270 Y85.730 E3.64374
+G1 X115.032 Y87.387 E3.70446
+G1 X115.537 Y89.121 E3.76461
+G1 X115.879 Y90.832 E3.82272
+G1 X116.176 Y92.457 E3.87772
+G1 X116.534 Y93.982 E3.92989
+G1 X117.024 Y95.439 E3.98105
+G1 X117.657 Y96.887 E4.03369
+G1 X118.384 Y98.392 E4.08934
+G1 X119.100 Y100.000 E4.14797
+G1 E2.14797 F2400.00000
+G92 E0
+G1 X83.000 Y83.000 F7800.000
+G1 E2.00000 F2400.00000
+G1 F3600
+G1 X83.000 Y83.000 E2.00000
+G1 X117.000 Y83.000 E3.13220
+G1 X117.000 Y83.900 E3.13220
+G1 X83.000 Y83.900 E4.26440
+G1 X83.000 Y84.800 E4.26440
+G1 X117.000 Y84.800 E5.39660
+G1 X117.000 Y85.700 E5.39660
+G1 X83.000 Y85.700 E6.52880
+G1 X83.000 Y86.600 E6.52880
+G1 X117.000 Y86.600 E7.66100
+G1 X117.000 Y87.500 E7.66100
+G1 X83.000 Y87.500 E8.79320
+G1 X83.000 Y88.400 E8.79320
+G1 X117.000 Y88.400 E9.92540
+G1 X117.000 Y89.300 E9.92540
+G1 X83.000 Y89.300 E11.05760
+G1 X83.000 Y90.200 E11.05760
+G1 X117.000 Y90.200 E12.18980
+G1 X117.000 Y91.100 E12.18980
+G1 X83.000 Y91.100 E13.32200
+G1 X83.000 Y92.000 E13.32200
+G1 X117.000 Y92.000 E14.45420
+G1 X117.000 Y92.900 E14.45420
+G1 X83.000 Y92.900 E15.58640
+G1 X83.000 Y93.800 E15.58640
+G1 X117.000 Y93.800 E16.71860
+G1 X117.000 Y94.700 E16.71860
+G1 X83.000 Y94.700 E17.85080
+G1 X83.000 Y95.600 E17.85080
+G1 X117.000 Y95.600 E18.98300
+G1 X117.000 Y96.500 E18.98300
+G1 X83.000 Y96.500 E20.11520
+G1 X83.000 Y97.400 E20.11520
+G1 X117.000 Y97.400 E21.24740
+G1 X117.000 Y98.300 E21.24740
+G1 X83.000 Y98.300 E22.37960
+G1 X83.000 Y99.200 E22.37960
+G1 X117.000 Y99.200 E23.51180
+G1 X117.000 Y100.100 E23.51180
+G1 X83.000 Y100.100 E24.64400
+G1 X83.000 Y101.000 E24.64400
+G1 X117.000 Y101.000 E25.77620
+G1 X117.000 Y101.900 E25.77620
+G1 X83.000 Y101.900 E26.90840
+G1 X83.000 Y102.800 E26.90840
+G1 X117.000 Y102.800 E28.04060
+G1 X117.000 Y103.700 E28.04060
+G1 X83.000 Y103.700 E29.17280
+G1 X83.000 Y104.600 E29.17280
+G1 X117.000 Y104.600 E30.30500
+G1 X117.000 Y105.500 E30.30500
+G1 X83.000 Y105.500 E31.43720
+G1 X83.000 Y106.400 E31.43720
+G1 X117.000 Y106.400 E32.56940
+G1 X117.000 Y107.300 E32.56940
+G1 X83.000 Y107.300 E33.70160
+G1 X83.000 Y108.200 E33.70160
+G1 X117.000 Y108.200 E34.83380
+G1 X117.000 Y109.100 E34.83380
+G1 X83.000 Y109.100 E35.96600
+G1 X83.000 Y110.000 E35.96600
+G1 X117.000 Y110.000 E37.09820
+G1 X117.000 Y110.900 E37.09820
+G1 X83.000 Y110.900 E38.23040
+G1 X83.000 Y111.800 E38.23040
+G1 X117.000 Y111.800 E39.36260
+G1 X117.000 Y112.700 E39.36260
+G1 X83.000 Y112.700 E40.49480
+G1 X83.000 Y113.600 E40.49480
+G1 X117.000 Y113.600 E41.62700
+G1 X117.000 Y114.500 E41.62700
+G1 X83.000 Y114.500 E42.75920
+G1 X83.000 Y115.400 E42.75920
+G1 X117.000 Y115.400 E43.89140
+G1 X117.000 Y116.300 E43.89140
+G1 X83.000 Y116.300 E45.02360
+G1 E43.02360 F2400.00000
+G92 E0
+G1 Z0.700 F7800.000
+G92 E0
+G1 E-2.00000 F2400.00000
+G1 X120.000 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.598 Y101.802 E0.06322
+G1 X120.903 Y103.686 E0.12677
+G1 X120.811 Y105.576 E0.18980
+G1 X120.275 Y107.379 E0.25244
+G1 X119.314 Y109.006 E0.31536
+G1 X118.013 Y110.400 E0.37884
+G1 X116.497 Y111.552 E0.44224
+G1 X114.902 Y112.504 E0.50412
+G1 X113.342 Y113.342 E0.56307
+G1 X111.889 Y114.169 E0.61874
+G1 X110.557 Y115.077 E0.67243
+G1 X109.307 Y116.121 E0.72665
+G1 X108.065 Y117.294 E0.78357
+G1 X106.745 Y118.533 E0.84382
+G1 X105.284 Y119.719 E0.90650
+G1 X103.652 Y120.709 E0.97007
+G1 X101.869 Y121.368 E1.03335
+G1 X100.000 Y121.600 E1.09608
+G1 X98.131 Y121.368 E1.15881
+G1 X96.348 Y120.709 E1.22208
+G1 X94.716 Y119.719 E1.28565
+G1 X93.255 Y118.533 E1.34833
+G1 X91.935 Y117.294 E1.40858
+G1 X90.693 Y116.121 E1.46551
+G1 X89.443 Y115.077 E1.51973
+G1 X88.111 Y114.169 E1.57341
+G1 X86.658 Y113.342 E1.62908
+G1 X85.098 Y112.504 E1.68804
+G1 X83.503 Y111.552 E1.74992
+G1 X81.987 Y110.400 E1.81332
+G1 X80.686 Y109.006 E1.87680
+G1 X79.725 Y107.379 E1.93971
+G1 X79.189 Y105.576 E2.00235
+G1 X79.097 Y103.686 E2.06539
+G1 X79.402 Y101.802 E2.12893
+G1 X80.000 Y100.000 E2.19216
+G1 X80.750 Y98.316 E2.25354
+G1 X81.511 Y96.740 E2.31182
+G1 X82.174 Y95.224 E2.36694
+G1 X82.687 Y93.699 E2.42051
+G1 X83.062 Y92.102 E2.47514
+G1 X83.372 Y90.400 E2.53274
+G1 X83.731 Y88.608 E2.59358
+G1 X84.260 Y86.792 E2.65656
+G1 X85.058 Y85.058 E2.72014
+G1 X86.178 Y83.527 E2.78330
+G1 X87.614 Y82.311 E2.84597
+G1 X89.307 Y81.479 E2.90878
+G1 X91.160 Y81.042 E2.97217
+G1 X93.065 Y80.945 E3.03568
+G1 X94.931 Y81.081 E3.09799
+G1 X96.706 Y81.317 E3.15761
+G1 X98.383 Y81.521 E3.21389
+G1 X100.000 Y81.600 E3.26779
+G1 X101.617 Y81.521 E3.32169
+G1 X103.294 Y81.317 E3.37797
+G1 X105.069 Y81.081 E3.43759
+G1 X106.935 Y80.945 E3.49990
+G1 X108.840 Y81.042 E3.56341
+G1 X110.693 Y81.479 E3.62680
+G1 X112.386 Y82.311 E3.68961
+G1 X113.822 Y83.527 E3.75228
+G1 X114.942 Y85.058 E3.81544
+G1 X115.740 Y86.792 E3.87902
+G1 X116.269 Y88.608 E3.94200
+G1 X116.628 Y90.400 E4.00284
+G1 X116.938 Y92.102 E4.06044
+G1 X117.313 Y93.699 E4.11507
+G1 X117.826 Y95.224 E4.16864
+G1 X118.489 Y96.740 E4.22376
+G1 X119.250 Y98.316 E4.28204
+G1 X120.000 Y100.000 E4.34343
+G1 E2.34343 F2400.00000
+G92 E0
+G1 X119.550 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.134 Y101.762 E0.06180
+G1 X120.433 Y103.603 E0.12392
+G1 X120.343 Y105.451 E0.18553
+G1 X119.818 Y107.213 E0.24676
+G1 X118.879 Y108.804 E0.30826
+G1 X117.608 Y110.166 E0.37032
+G1 X116.126 Y111.292 E0.43229
+G1 X114.566 Y112.223 E0.49277
+G1 X113.042 Y113.042 E0.55040
+G1 X111.622 Y113.850 E0.60482
+G1 X110.320 Y114.738 E0.65730
+G1 X109.098 Y115.758 E0.71030
+G1 X107.883 Y116.905 E0.76594
+G1 X106.594 Y118.116 E0.82484
+G1 X105.165 Y119.275 E0.88610
+G1 X103.569 Y120.243 E0.94825
+G1 X101.827 Y120.888 E1.01010
+G1 X100.000 Y121.114 E1.07142
+G1 X98.173 Y120.888 E1.13273
+G1 X96.431 Y120.243 E1.19459
+G1 X94.835 Y119.275 E1.25673
+G1 X93.406 Y118.116 E1.31800
+G1 X92.117 Y116.905 E1.37689
+G1 X90.902 Y115.758 E1.43254
+G1 X89.680 Y114.738 E1.48553
+G1 X88.378 Y113.850 E1.53801
+G1 X86.958 Y113.042 E1.59243
+G1 X85.434 Y112.223 E1.65006
+G1 X83.874 Y111.292 E1.71055
+G1 X82.392 Y110.166 E1.77252
+G1 X81.121 Y108.804 E1.83457
+G1 X80.182 Y107.213 E1.89607
+G1 X79.657 Y105.451 E1.95730
+G1 X79.567 Y103.603 E2.01891
+G1 X79.866 Y101.762 E2.08103
+G1 X80.450 Y100.000 E2.14283
+G1 X81.183 Y98.354 E2.20284
+G1 X81.927 Y96.813 E2.25981
+G1 X82.575 Y95.331 E2.31368
+G1 X83.076 Y93.840 E2.36605
+G1 X83.443 Y92.279 E2.41945
+G1 X83.746 Y90.616 E2.47575
+G1 X84.097 Y88.865 E2.53522
+G1 X84.614 Y87.090 E2.59679
+G1 X85.394 Y85.394 E2.65894
+G1 X86.489 Y83.898 E2.72067
+G1 X87.893 Y82.709 E2.78194
+G1 X89.548 Y81.896 E2.84333
+G1 X91.359 Y81.469 E2.90530
+G1 X93.221 Y81.374 E2.96738
+G1 X95.045 Y81.507 E3.02829
+G1 X96.780 Y81.737 E3.08657
+G1 X98.420 Y81.936 E3.14158
+G1 X100.000 Y82.014 E3.19427
+G1 X101.580 Y81.936 E3.24695
+G1 X103.220 Y81.737 E3.30197
+G1 X104.955 Y81.507 E3.36024
+G1 X106.779 Y81.374 E3.42115
+G1 X108.641 Y81.469 E3.48323
+G1 X110.452 Y81.896 E3.54520
+G1 X112.107 Y82.709 E3.60659
+G1 X113.511 Y83.898 E3.66786
+G1 X114.606 Y85.394 E3.72959
+G1 X115.386 Y87.090 E3.79174
+G1 X115.903 Y88.865 E3.85331
+G1 X116.254 Y90.616 E3.91278
+G1 X116.557 Y92.279 E3.96908
+G1 X116.924 Y93.840 E4.02248
+G1 X117.425 Y95.331 E4.07485
+G1 X118.073 Y96.813 E4.12872
+G1 X118.817 Y98.354 E4.18569
+G1 X119.550 Y100.000 E4.24570
+G1 E2.24570 F2400.00000
+G92 E0
+G1 X119.100 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X119.671 Y101.721 E0.06038
+G1 X119.963 Y103.520 E0.12107
+G1 X119.875 Y105.325 E0.18126
+G1 X119.362 Y107.047 E0.24108
+G1 X118.445 Y108.601 E0.30117
+G1 X117.203 Y109.932 E0.36179
+G1 X115.755 Y111.032 E0.42234
+G1 X114.231 Y111.941 E0.48143
+G1 X112.742 Y112.742 E0.53774
+G1 X111.354 Y113.532 E0.59090
+G1 X110.082 Y114.399 E0.64217
+G1 X108.888 Y115.395 E0.69395
+G1 X107.702 Y116.516 E0.74831
+G1 X106.442 Y117.699 E0.80585
+G1 X105.046 Y118.831 E0.86571
+G1 X103.487 Y119.777 E0.92642
+G1 X101.785 Y120.407 E0.98685
+G1 X100.000 Y120.628 E1.04675
+G1 X98.215 Y120.407 E1.10666
+G1 X96.513 Y119.777 E1.16709
+G1 X94.954 Y118.831 E1.22780
+G1 X93.558 Y117.699 E1.28766
+G1 X92.298 Y116.516 E1.34520
+G1 X91.112 Y115.395 E1.39956
+G1 X89.918 Y114.399 E1.45134
+G1 X88.646 Y113.532 E1.50261
+G1 X87.258 Y112.742 E1.55577
+G1 X85.769 Y111.941 E1.61208
+G1 X84.245 Y111.032 E1.67117
+G1 X82.797 Y109.932 E1.73172
+G1 X81.555 Y108.601 E1.79234
+G1 X80.638 Y107.047 E1.85242
+G1 X80.125 Y105.325 E1.91225
+G1 X80.037 Y103.520 E1.97244
+G1 X80.329 Y101.721 E2.03313
+G1 X80.900 Y100.000 E2.09351
+G1 X81.616 Y98.392 E2.15214
+G1 X82.343 Y96.887 E2.20779
+G1 X82.976 Y95.439 E2.26042
+G1 X83.466 Y93.982 E2.31159
+G1 X83.824 Y92.457 E2.36376
+G1 X84.121 Y90.832 E2.41876
+G1 X84.463 Y89.121 E2.47687
+G1 X84.968 Y87.387 E2.53702
+G1 X85.730 Y85.730 E2.59774
+G1 X86.800 Y84.269 E2.65805
+G1 X88.172 Y83.107 E2.71790
+G1 X89.788 Y82.313 E2.77789
+G1 X91.558 Y81.895 E2.83842
+G1 X93.377 Y81.803 E2.89908
+G1 X95.159 Y81.933 E2.95858
+G1 X96.854 Y82.157 E3.01552
+G1 X98.456 Y82.352 E3.06926
+G1 X100.000 Y82.428 E3.12074
+G1 X101.544 Y82.352 E3.17222
+G1 X103.146 Y82.157 E3.22596
+G1 X104.841 Y81.933 E3.28290
+G1 X106.623 Y81.803 E3.34240
+G1 X108.442 Y81.895 E3.40306
+G1 X110.212 Y82.313 E3.46359
+G1 X111.828 Y83.107 E3.52358
+G1 X113.200 Y84.269 E3.58343
+G1 X114.270 Y85.730 E3.64374
+G1 X115.032 Y87.387 E3.70446
+G1 X115.537 Y89.121 E3.76461
+G1 X115.879 Y90.832 E3.82272
+G1 X116.176 Y92.457 E3.87772
+G1 X116.534 Y93.982 E3.92989
+G1 X117.024 Y95.439 E3.98105
+G1 X117.657 Y96.887 E4.03369
+G1 X118.384 Y98.392 E4.08934
+G1 X119.100 Y100.000 E4.14797
+G1 E2.14797 F2400.00000
+G92 E0
+G1 X83.000 Y83.000 F7800.000
+G1 E2.00000 F2400.00000
+G1 F3600
+G1 X83.000 Y83.000 E2.00000
+G1 X117.000 Y83.000 E3.13220
+G1 X117.000 Y83.900 E3.13220
+G1 X83.000 Y83.900 E4.26440
+G1 X83.000 Y84.800 E4.26440
+G1 X117.000 Y84.800 E5.39660
+G1 X117.000 Y85.700 E5.39660
+G1 X83.000 Y85.700 E6.52880
+G1 X83.000 Y86.600 E6.52880
+G1 X117.000 Y86.600 E7.66100
+G1 X117.000 Y87.500 E7.66100
+G1 X83.000 Y87.500 E8.79320
+G1 X83.000 Y88.400 E8.79320
+G1 X117.000 Y88.400 E9.92540
+G1 X117.000 Y89.300 E9.92540
+G1 X83.000 Y89.300 E11.05760
+G1 X83.000 Y90.200 E11.05760
+G1 X117.000 Y90.200 E12.18980
+G1 X117.000 Y91.100 E12.18980
+G1 X83.000 Y91.100 E13.32200
+G1 X83.000 Y92.000 E13.32200
+G1 X117.000 Y92.000 E14.45420
+G1 X117.000 Y92.900 E14.45420
+G1 X83.000 Y92.900 E15.58640
+G1 X83.000 Y93.800 E15.58640
+G1 X117.000 Y93.800 E16.71860
+G1 X117.000 Y94.700 E16.71860
+G1 X83.000 Y94.700 E17.85080
+G1 X83.000 Y95.600 E17.85080
+G1 X117.000 Y95.600 E18.98300
+G1 X117.000 Y96.500 E18.98300
+G1 X83.000 Y96.500 E20.11520
+G1 X83.000 Y97.400 E20.11520
+G1 X117.000 Y97.400 E21.24740
+G1 X117.000 Y98.300 E21.24740
+G1 X83.000 Y98.300 E22.37960
+G1 X83.000 Y99.200 E22.37960
+G1 X117.000 Y99.200 E23.51180
+G1 X117.000 Y100.100 E23.51180
+G1 X83.000 Y100.100 E24.64400
+G1 X83.000 Y101.000 E24.64400
+G1 X117.000 Y101.000 E25.77620
+G1 X117.000 Y101.900 E25.77620
+G1 X83.000 Y101.900 E26.90840
+G1 X83.000 Y102.800 E26.90840
+G1 X117.000 Y102.800 E28.04060
+G1 X117.000 Y103.700 E28.04060
+G1 X83.000 Y103.700 E29.17280
+G1 X83.000 Y104.600 E29.17280
+G1 X117.000 Y104.600 E30.30500
+G1 X117.000 Y105.500 E30.30500
+G1 X83.000 Y105.500 E31.43720
+G1 X83.000 Y106.400 E31.43720
+G1 X117.000 Y106.400 E32.56940
+G1 X117.000 Y107.300 E32.56940
+G1 X83.000 Y107.300 E33.70160
+G1 X83.000 Y108.200 E33.70160
+G1 X117.000 Y108.200 E34.83380
+G1 X117.000 Y109.100 E34.83380
+G1 X83.000 Y109.100 E35.96600
+G1 X83.000 Y110.000 E35.96600
+G1 X117.000 Y110.000 E37.09820
+G1 X117.000 Y110.900 E37.09820
+G1 X83.000 Y110.900 E38.23040
+G1 X83.000 Y111.800 E38.23040
+G1 X117.000 Y111.800 E39.36260
+G1 X117.000 Y112.700 E39.36260
+G1 X83.000 Y112.700 E40.49480
+G1 X83.000 Y113.600 E40.49480
+G1 X117.000 Y113.600 E41.62700
+G1 X117.000 Y114.500 E41.62700
+G1 X83.000 Y114.500 E42.75920
+G1 X83.000 Y115.400 E42.75920
+G1 X117.000 Y115.400 E43.89140
+G1 X117.000 Y116.300 E43.89140
+G1 X83.000 Y116.300 E45.02360
+G1 E43.02360 F2400.00000
+G92 E0
+G1 Z0.900 F7800.000
+G92 E0
+G1 E-2.00000 F2400.00000
+G1 X120.000 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.598 Y101.802 E0.06322
+G1 X120.903 Y103.686 E0.12677
+G1 X120.811 Y105.576 E0.18980
+G1 X120.275 Y107.379 E0.25244
+G1 X119.314 Y109.006 E0.31536
+G1 X118.013 Y110.400 E0.37884
+G1 X116.497 Y111.552 E0.44224
+G1 X114.902 Y112.504 E0.50412
+G1 X113.342 Y113.342 E0.56307
+G1 X111.889 Y114.169 E0.61874
+G1 X110.557 Y115.077 E0.67243
+G1 X109.307 Y116.121 E0.72665
+G1 X108.065 Y117.294 E0.78357
+G1 X106.745 Y118.533 E0.84382
+G1 X105.284 Y119.719 E0.90650
+G1 X103.652 Y120.709 E0.97007
+G1 X101.869 Y121.368 E1.03335
+G1 X100.000 Y121.600 E1.09608
+G1 X98.131 Y121.368 E1.15881
+G1 X96.348 Y120.709 E1.22208
+G1 X94.716 Y119.719 E1.28565
+G1 X93.255 Y118.533 E1.34833
+G1 X91.935 Y117.294 E1.40858
+G1 X90.693 Y116.121 E1.46551
+G1 X89.443 Y115.077 E1.51973
+G1 X88.111 Y114.169 E1.57341
+G1 X86.658 Y113.342 E1.62908
+G1 X85.098 Y112.504 E1.68804
+G1 X83.503 Y111.552 E1.74992
+G1 X81.987 Y110.400 E1.81332
+G1 X80.686 Y109.006 E1.87680
+G1 X79.725 Y107.379 E1.93971
+G1 X79.189 Y105.576 E2.00235
+G1 X79.097 Y103.686 E2.06539
+G1 X79.402 Y101.802 E2.12893
+G1 X80.000 Y100.000 E2.19216
+G1 X80.750 Y98.316 E2.25354
+G1 X81.511 Y96.740 E2.31182
+G1 X82.174 Y95.224 E2.36694
+G1 X82.687 Y93.699 E2.42051
+G1 X83.062 Y92.102 E2.47514
+G1 X83.372 Y90.400 E2.53274
+G1 X83.731 Y88.608 E2.59358
+G1 X84.260 Y86.792 E2.65656
+G1 X85.058 Y85.058 E2.72014
+G1 X86.178 Y83.527 E2.78330
+G1 X87.614 Y82.311 E2.84597
+G1 X89.307 Y81.479 E2.90878
+G1 X91.160 Y81.042 E2.97217
+G1 X93.065 Y80.945 E3.03568
+G1 X94.931 Y81.081 E3.09799
+G1 X96.706 Y81.317 E3.15761
+G1 X98.383 Y81.521 E3.21389
+G1 X100.000 Y81.600 E3.26779
+G1 X101.617 Y81.521 E3.32169
+G1 X103.294 Y81.317 E3.37797
+G1 X105.069 Y81.081 E3.43759
+G1 X106.935 Y80.945 E3.49990
+G1 X108.840 Y81.042 E3.56341
+G1 X110.693 Y81.479 E3.62680
+G1 X112.386 Y82.311 E3.68961
+G1 X113.822 Y83.527 E3.75228
+G1 X114.942 Y85.058 E3.81544
+G1 X115.740 Y86.792 E3.87902
+G1 X116.269 Y88.608 E3.94200
+G1 X116.628 Y90.400 E4.00284
+G1 X116.938 Y92.102 E4.06044
+G1 X117.313 Y93.699 E4.11507
+G1 X117.826 Y95.224 E4.16864
+G1 X118.489 Y96.740 E4.22376
+G1 X119.250 Y98.316 E4.28204
+G1 X120.000 Y100.000 E4.34343
+G1 E2.34343 F2400.00000
+G92 E0
+G1 X119.550 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X120.134 Y101.762 E0.06180
+G1 X120.433 Y103.603 E0.12392
+G1 X120.343 Y105.451 E0.18553
+G1 X119.818 Y107.213 E0.24676
+G1 X118.879 Y108.804 E0.30826
+G1 X117.608 Y110.166 E0.37032
+G1 X116.126 Y111.292 E0.43229
+G1 X114.566 Y112.223 E0.49277
+G1 X113.042 Y113.042 E0.55040
+G1 X111.622 Y113.850 E0.60482
+G1 X110.320 Y114.738 E0.65730
+G1 X109.098 Y115.758 E0.71030
+G1 X107.883 Y116.905 E0.76594
+G1 X106.594 Y118.116 E0.82484
+G1 X105.165 Y119.275 E0.88610
+G1 X103.569 Y120.243 E0.94825
+G1 X101.827 Y120.888 E1.01010
+G1 X100.000 Y121.114 E1.07142
+G1 X98.173 Y120.888 E1.13273
+G1 X96.431 Y120.243 E1.19459
+G1 X94.835 Y119.275 E1.25673
+G1 X93.406 Y118.116 E1.31800
+G1 X92.117 Y116.905 E1.37689
+G1 X90.902 Y115.758 E1.43254
+G1 X89.680 Y114.738 E1.48553
+G1 X88.378 Y113.850 E1.53801
+G1 X86.958 Y113.042 E1.59243
+G1 X85.434 Y112.223 E1.65006
+G1 X83.874 Y111.292 E1.71055
+G1 X82.392 Y110.166 E1.77252
+G1 X81.121 Y108.804 E1.83457
+G1 X80.182 Y107.213 E1.89607
+G1 X79.657 Y105.451 E1.95730
+G1 X79.567 Y103.603 E2.01891
+G1 X79.866 Y101.762 E2.08103
+G1 X80.450 Y100.000 E2.14283
+G1 X81.183 Y98.354 E2.20284
+G1 X81.927 Y96.813 E2.25981
+G1 X82.575 Y95.331 E2.31368
+G1 X83.076 Y93.840 E2.36605
+G1 X83.443 Y92.279 E2.41945
+G1 X83.746 Y90.616 E2.47575
+G1 X84.097 Y88.865 E2.53522
+G1 X84.614 Y87.090 E2.59679
+G1 X85.394 Y85.394 E2.65894
+G1 X86.489 Y83.898 E2.72067
+G1 X87.893 Y82.709 E2.78194
+G1 X89.548 Y81.896 E2.84333
+G1 X91.359 Y81.469 E2.90530
+G1 X93.221 Y81.374 E2.96738
+G1 X95.045 Y81.507 E3.02829
+G1 X96.780 Y81.737 E3.08657
+G1 X98.420 Y81.936 E3.14158
+G1 X100.000 Y82.014 E3.19427
+G1 X101.580 Y81.936 E3.24695
+G1 X103.220 Y81.737 E3.30197
+G1 X104.955 Y81.507 E3.36024
+G1 X106.779 Y81.374 E3.42115
+G1 X108.641 Y81.469 E3.48323
+G1 X110.452 Y81.896 E3.54520
+G1 X112.107 Y82.709 E3.60659
+G1 X113.511 Y83.898 E3.66786
+G1 X114.606 Y85.394 E3.72959
+G1 X115.386 Y87.090 E3.79174
+G1 X115.903 Y88.865 E3.85331
+G1 X116.254 Y90.616 E3.91278
+G1 X116.557 Y92.279 E3.96908
+G1 X116.924 Y93.840 E4.02248
+G1 X117.425 Y95.331 E4.07485
+G1 X118.073 Y96.813 E4.12872
+G1 X118.817 Y98.354 E4.18569
+G1 X119.550 Y100.000 E4.24570
+G1 E2.24570 F2400.00000
+G92 E0
+G1 X119.100 Y100.000 F7800.000
+G1 E0.00000 F2400.00000
+G1 F1800
+G1 X119.671 Y101.721 E0.06038
+G1 X119.963 Y103.520 E0.12107
+G1 X119.875 Y105.325 E0.18126
+G1 X119.362 Y107.047 E0.24108
+G1 X118.445 Y108.601 E0.30117
+G1 X117.203 Y109.932 E0.36179
+G1 X115.755 Y111.032 E0.42234
+G1 X114.231 Y111.941 E0.48143
+G1 X112.742 Y112.742 E0.53774
+G1 X111.354 Y113.532 E0.59090
+G1 X110.082 Y114.399 E0.64217
+G1 X108.888 Y115.395 E0.69395
+G1 X107.702 Y116.516 E0.74831
+G1 X106.442 Y117.699 E0.80585
+G1 X105.046 Y118.831 E0.86571
+G1 X103.487 Y119.777 E0.92642
+G1 X101.785 Y120.407 E0.98685
+G1 X100.000 Y120.628 E1.04675
+G1 X98.215 Y120.407 E1.10666
+G1 X96.513 Y119.777 E1.16709
+G1 X94.954 Y118.831 E1.22780
+G1 X93.558 Y117.699 E1.28766
+G1 X92.298 Y116.516 E1.34520
+G1 X91.112 Y115.395 E1.39956
+G1 X89.918 Y114.399 E1.45134
+G1 X88.646 Y113.532 E1.50261
+G1 X87.258 Y112.742 E1.55577
+G1 X85.769 Y111.941 E1.61208
+G1 X84.245 Y111.032 E1.67117
+G1 X82.797 Y109.932 E1.73172
+G1 X81.555 Y108.601 E1.79234
+G1 X80.638 Y107.047 E1.85242
+G1 X80.125 Y105.325 E1.91225
+G1 X80.037 Y103.520 E1.97244
+G1 X80.329 Y101.721 E2.03313
+G1 X80.900 Y100.000 E2.09351
+G1 X81.616 Y98.392 E2.15214
+G1 X82.343 Y96.887 E2.20779
+G1 X82.976 Y95.439 E2.26042
+G1 X83.466 Y93.982 E2.31159
+G1 X83.824 Y92.457 E2.36376
+G1 X84.121 Y90.832 E2.41876
+G1 X84.463 Y89.121 E2.47687
+G1 X84.968 Y87.387 E2.53702
+G1 X85.730 Y85.730 E2.59774
+G1 X86.800 Y84.269 E2.65805
+G1 X88.172 Y83.107 E2.71790
+G1 X89.788 Y82.313 E2.77789
+G1 X91.558 Y81.895 E2.83842
+G1 X93.377 Y81.803 E2.89908
+G1 X95.159 Y81.933 E2.95858
+G1 X96.854 Y82.157 E3.01552
+G1 X98.456 Y82.352 E3.06926
+G1 X100.000 Y82.428 E3.12074
+G1 X101.544 Y82.352 E3.17222
+G1 X103.146 Y82.157 E3.22596
+G1 X104.841 Y81.933 E3.28290
+G1 X106.623 Y81.803 E3.34240
+G1 X108.442 Y81.895 E3.40306
+G1 X110.212 Y82.313 E3.46359
+G1 X111.828 Y83.107 E3.52358
+G1 X113.200 Y84.269 E3.58343
+G1 X114.270 Y85.730 E3.64374
+G1 X115.032 Y87.387 E3.70446
+G1 X115.537 Y89.121 E3.76461
+G1 X115.879 Y90.832 E3.82272
+G1 X116.176 Y92.457 E3.87772
+G1 X116.534 Y93.982 E3.92989
+G1 X117.024 Y95.439 E3.98105
+G1 X117.657 Y96.887 E4.03369
+G1 X118.384 Y98.392 E4.08934
+G1 X119.100 Y100.000 E4.14797
+G1 E2.14797 F2400.00000
+G92 E0
+G1 X83.000 Y83.000 F7800.000
+G1 E2.00000 F2400.00000
+G1 F3600
+G1 X83.000 Y83.000 E2.00000
+G1 X117.000 Y83.000 E3.13220
+G1 X117.000 Y83.900 E3.13220
+G1 X83.000 Y83.900 E4.26440
+G1 X83.000 Y84.800 E4.26440
+G1 X117.000 Y84.800 E5.39660
+G1 X117.000 Y85.700 E5.39660
+G1 X83.000 Y85.700 E6.52880
+G1 X83.000 Y86.600 E6.52880
+G1 X117.000 Y86.600 E7.66100
+G1 X117.000 Y87.500 E7.66100
+G1 X83.000 Y87.500 E8.79320
+G1 X83.000 Y88.400 E8.79320
+G1 X117.000 Y88.400 E9.92540
+G1 X117.000 Y89.300 E9.92540
+G1 X83.000 Y89.300 E11.05760
+G1 X83.000 Y90.200 E11.05760
+G1 X117.000 Y90.200 E12.18980
+G1 X117.000 Y91.100 E12.18980
+G1 X83.000 Y91.100 E13.32200
+G1 X83.000 Y92.000 E13.32200
+G1 X117.000 Y92.000 E14.45420
+G1 X117.000 Y92.900 E14.45420
+G1 X83.000 Y92.900 E15.58640
+G1 X83.000 Y93.800 E15.58640
+G1 X117.000 Y93.800 E16.71860
+G1 X117.000 Y94.700 E16.71860
+G1 X83.000 Y94.700 E17.85080
+G1 X83.000 Y95.600 E17.85080
+G1 X117.000 Y95.600 E18.98300
+G1 X117.000 Y96.500 E18.98300
+G1 X83.000 Y96.500 E20.11520
+G1 X83.000 Y97.400 E20.11520
+G1 X117.000 Y97.400 E21.24740
+G1 X117.000 Y98.300 E21.24740
+G1 X83.000 Y98.300 E22.37960
+G1 X83.000 Y99.200 E22.37960
+G1 X117.000 Y99.200 E23.51180
+G1 X117.000 Y100.100 E23.51180
+G1 X83.000 Y100.100 E24.64400
+G1 X83.000 Y101.000 E24.64400
+G1 X117.000 Y101.000 E25.77620
+G1 X117.000 Y101.900 E25.77620
+G1 X83.000 Y101.900 E26.90840
+G1 X83.000 Y102.800 E26.90840
+G1 X117.000 Y102.800 E28.04060
+G1 X117.000 Y103.700 E28.04060
+G1 X83.000 Y103.700 E29.17280
+G1 X83.000 Y104.600 E29.17280
+G1 X117.000 Y104.600 E30.30500
+G1 X117.000 Y105.500 E30.30500
+G1 X83.000 Y105.500 E31.43720
+G1 X83.000 Y106.400 E31.43720
+G1 X117.000 Y106.400 E32.56940
+G1 X117.000 Y107.300 E32.56940
+G1 X83.000 Y107.300 E33.70160
+G1 X83.000 Y108.200 E33.70160
+G1 X117.000 Y108.200 E34.83380
+G1 X117.000 Y109.100 E34.83380
+G1 X83.000 Y109.100 E35.96600
+G1 X83.000 Y110.000 E35.96600
+G1 X117.000 Y110.000 E37.09820
+G1 X117.000 Y110.900 E37.09820
+G1 X83.000 Y110.900 E38.23040
+G1 X83.000 Y111.800 E38.23040
+G1 X117.000 Y111.800 E39.36260
+G1 X117.000 Y112.700 E39.36260
+G1 X83.000 Y112.700 E40.49480
+G1 X83.000 Y113.600 E40.49480
+G1 X117.000 Y113.600 E41.62700
+G1 X117.000 Y114.500 E41.62700
+G1 X83.000 Y114.500 E42.75920
+G1 X83.000 Y115.400 E42.75920
+G1 X117.000 Y115.400 E43.89140
+G1 X117.000 Y116.300 E43.89140
+G1 X83.000 Y116.300 E45.02360
+G1 E43.02360 F2400.00000
+G92 E0
+M104 S0 ; turn off temperature
+G28 X0  ; home X axis
+M84     ; disable motors
@@ -0,0 +1,12 @@
+// Host (simulator) replacement for the mbed InterruptIn.h, pin interrupts are not simulated
+#pragma once
+#include "PinNames.h"
+
+namespace mbed {
+class InterruptIn {
+    public:
+        InterruptIn(PinName pin) {}
+        template<typename T> void rise(T *tptr, void (T::*mptr)(void)) {}
+        template<typename T> void fall(T *tptr, void (T::*mptr)(void)) {}
+};
+}
@@ -0,0 +1,187 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    Host (Linux x86) mock of the parts of the LPC17xx peripheral map used by the motion core.
+    The peripherals are plain structs in host memory instead of fixed addresses, the GPIO set/clear
+    registers and the timer control registers are routed to the host HAL (HostHal.cpp) so the
+    simulator can emulate TIMER0/TIMER1 and see every step pin edge.
+*/
+
+#ifndef __LPC17xx_H__
+#define __LPC17xx_H__
+
+#include <stdint.h>
+#include "system_LPC17xx.h"
+
+#define __I  volatile const
+#define __O  volatile
+#define __IO volatile
+
+typedef enum IRQn {
+    NonMaskableInt_IRQn   = -14,
+    MemoryManagement_IRQn = -12,
+    BusFault_IRQn         = -11,
+    UsageFault_IRQn       = -10,
+    SVCall_IRQn           = -5,
+    DebugMonitor_IRQn     = -4,
+    PendSV_IRQn           = -2,
+    SysTick_IRQn          = -1,
+    WDT_IRQn              = 0,
+    TIMER0_IRQn           = 1,
+    TIMER1_IRQn           = 2,
+    TIMER2_IRQn           = 3,
+    TIMER3_IRQn           = 4,
+    UART0_IRQn            = 5,
+    UART1_IRQn            = 6,
+    UART2_IRQn            = 7,
+    UART3_IRQn            = 8,
+    ADC_IRQn              = 22,
+    USB_IRQn              = 24,
+} IRQn_Type;
+
+// called by the GPIO and timer register proxies below, implemented in HostHal.cpp
+void host_gpio_write(uint8_t port, uint32_t mask, bool set);
+void host_timer_control(uint8_t timer, uint32_t tcr);
+uint32_t host_timer_read(uint8_t timer);
+void host_timer_write(uint8_t timer, uint32_t tc);
+
+// write only FIOSET/FIOCLR register
+class HostGpioWriteReg {
+    public:
+        HostGpioWriteReg(uint8_t port, bool set) : port(port), set(set) {}
+        void operator=(uint32_t mask) { host_gpio_write(port, mask, set); }
+
+    private:
+        uint8_t port;
+        bool set;
+};
+
+typedef struct LPC_GPIO_TypeDef {
+    LPC_GPIO_TypeDef(uint8_t port) : FIODIR(0), FIOMASK(0), FIOPIN(0), FIOSET(port, true), FIOCLR(port, false) {}
+    __IO uint32_t FIODIR;
+    __IO uint32_t FIOMASK;
+    __IO uint32_t FIOPIN;
+    HostGpioWriteReg FIOSET;
+    HostGpioWriteReg FIOCLR;
+} LPC_GPIO_TypeDef;
+
+// timer control register, writes start/stop/reset the emulated timer
+class HostTimerControlReg {
+    public:
+        HostTimerControlReg(uint8_t timer) : timer(timer), value(0) {}
+        void operator=(uint32_t v) { value= v; host_timer_control(timer, v); }
+        operator uint32_t() const { return value; }
+
+    private:
+        uint8_t timer;
+        uint32_t value;
+};
+
+// timer counter, reads return the count at the current simulated time
+class HostTimerCounterReg {
+    public:
+        HostTimerCounterReg(uint8_t timer) : timer(timer) {}
+        void operator=(uint32_t v) { host_timer_write(timer, v); }
+        operator uint32_t() const { return host_timer_read(timer); }
+
+    private:
+        uint8_t timer;
+};
+
+typedef struct LPC_TIM_TypeDef {
+    LPC_TIM_TypeDef(uint8_t timer) : IR(0), TCR(timer), TC(timer), PR(0), PC(0), MCR(0), MR0(0), MR1(0), MR2(0), MR3(0) {}
+    __IO uint32_t IR;
+    HostTimerControlReg TCR;
+    HostTimerCounterReg TC;
+    __IO uint32_t PR;
+    __IO uint32_t PC;
+    __IO uint32_t MCR;
+    __IO uint32_t MR0;
+    __IO uint32_t MR1;
+    __IO uint32_t MR2;
+    __IO uint32_t MR3;
+} LPC_TIM_TypeDef;
+
+// interrupt control and state register, only setting PendSV pending is emulated, it runs when the timer interrupt returns
+#define SCB_ICSR_PENDSVSET_Msk (1UL << 28)
+void host_pend_sv();
+
+class HostIcsrReg {
+    public:
+        void operator=(uint32_t v) { if(v & SCB_ICSR_PENDSVSET_Msk) host_pend_sv(); }
+        operator uint32_t() const { return 0; }
+};
+
+typedef struct {
+    HostIcsrReg ICSR;
+} SCB_Type;
+
+typedef struct {
+    __IO uint32_t PCONP;
+} LPC_SC_TypeDef;
+
+typedef struct {
+    __IO uint32_t PINSEL[11];
+    __IO uint32_t PINMODE0;
+    __IO uint32_t PINMODE1;
+    __IO uint32_t PINMODE2;
+    __IO uint32_t PINMODE3;
+    __IO uint32_t PINMODE4;
+    __IO uint32_t PINMODE5;
+    __IO uint32_t PINMODE6;
+    __IO uint32_t PINMODE7;
+    __IO uint32_t PINMODE8;
+    __IO uint32_t PINMODE9;
+    __IO uint32_t PINMODE_OD0;
+    __IO uint32_t PINMODE_OD1;
+    __IO uint32_t PINMODE_OD2;
+    __IO uint32_t PINMODE_OD3;
+    __IO uint32_t PINMODE_OD4;
+} LPC_PINCON_TypeDef;
+
+typedef struct {
+    __IO uint32_t WDMOD;
+    __IO uint32_t WDTC;
+    __IO uint32_t WDFEED;
+    __IO uint32_t WDTV;
+    __IO uint32_t WDCLKSEL;
+} LPC_WDT_TypeDef;
+
+extern LPC_GPIO_TypeDef host_gpio[5];
+extern LPC_TIM_TypeDef host_tim[4];
+extern LPC_SC_TypeDef host_sc;
+extern LPC_PINCON_TypeDef host_pincon;
+extern LPC_WDT_TypeDef host_wdt;
+extern SCB_Type host_scb;
+
+#define LPC_GPIO0   (&host_gpio[0])
+#define LPC_GPIO1   (&host_gpio[1])
+#define LPC_GPIO2   (&host_gpio[2])
+#define LPC_GPIO3   (&host_gpio[3])
+#define LPC_GPIO4   (&host_gpio[4])
+#define LPC_TIM0    (&host_tim[0])
+#define LPC_TIM1    (&host_tim[1])
+#define LPC_TIM2    (&host_tim[2])
+#define LPC_TIM3    (&host_tim[3])
+#define LPC_SC      (&host_sc)
+#define LPC_PINCON  (&host_pincon)
+#define LPC_WDT     (&host_wdt)
+#define SCB         (&host_scb)
+
+// core functions, interrupts are emulated by HostHal.cpp so these only record state
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t priority);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+void NVIC_SetPriorityGrouping(uint32_t group);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_SystemReset(void);
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+
+#endif
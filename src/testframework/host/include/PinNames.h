@@ -0,0 +1,177 @@
+// Host (simulator) replacement for the mbed PinNames.h, pins are numbered port*32 + pin
+#pragma once
+
+typedef enum {
+    Port0 = 0,
+    Port1 = 1,
+    Port2 = 2,
+    Port3 = 3,
+    Port4 = 4
+} PortName;
+
+typedef enum {
+    P0_0 = 0,
+    P0_1 = 1,
+    P0_2 = 2,
+    P0_3 = 3,
+    P0_4 = 4,
+    P0_5 = 5,
+    P0_6 = 6,
+    P0_7 = 7,
+    P0_8 = 8,
+    P0_9 = 9,
+    P0_10 = 10,
+    P0_11 = 11,
+    P0_12 = 12,
+    P0_13 = 13,
+    P0_14 = 14,
+    P0_15 = 15,
+    P0_16 = 16,
+    P0_17 = 17,
+    P0_18 = 18,
+    P0_19 = 19,
+    P0_20 = 20,
+    P0_21 = 21,
+    P0_22 = 22,
+    P0_23 = 23,
+    P0_24 = 24,
+    P0_25 = 25,
+    P0_26 = 26,
+    P0_27 = 27,
+    P0_28 = 28,
+    P0_29 = 29,
+    P0_30 = 30,
+    P0_31 = 31,
+    P1_0 = 32,
+    P1_1 = 33,
+    P1_2 = 34,
+    P1_3 = 35,
+    P1_4 = 36,
+    P1_5 = 37,
+    P1_6 = 38,
+    P1_7 = 39,
+    P1_8 = 40,
+    P1_9 = 41,
+    P1_10 = 42,
+    P1_11 = 43,
+    P1_12 = 44,
+    P1_13 = 45,
+    P1_14 = 46,
+    P1_15 = 47,
+    P1_16 = 48,
+    P1_17 = 49,
+    P1_18 = 50,
+    P1_19 = 51,
+    P1_20 = 52,
+    P1_21 = 53,
+    P1_22 = 54,
+    P1_23 = 55,
+    P1_24 = 56,
+    P1_25 = 57,
+    P1_26 = 58,
+    P1_27 = 59,
+    P1_28 = 60,
+    P1_29 = 61,
+    P1_30 = 62,
+    P1_31 = 63,
+    P2_0 = 64,
+    P2_1 = 65,
+    P2_2 = 66,
+    P2_3 = 67,
+    P2_4 = 68,
+    P2_5 = 69,
+    P2_6 = 70,
+    P2_7 = 71,
+    P2_8 = 72,
+    P2_9 = 73,
+    P2_10 = 74,
+    P2_11 = 75,
+    P2_12 = 76,
+    P2_13 = 77,
+    P2_14 = 78,
+    P2_15 = 79,
+    P2_16 = 80,
+    P2_17 = 81,
+    P2_18 = 82,
+    P2_19 = 83,
+    P2_20 = 84,
+    P2_21 = 85,
+    P2_22 = 86,
+    P2_23 = 87,
+    P2_24 = 88,
+    P2_25 = 89,
+    P2_26 = 90,
+    P2_27 = 91,
+    P2_28 = 92,
+    P2_29 = 93,
+    P2_30 = 94,
+    P2_31 = 95,
+    P3_0 = 96,
+    P3_1 = 97,
+    P3_2 = 98,
+    P3_3 = 99,
+    P3_4 = 100,
+    P3_5 = 101,
+    P3_6 = 102,
+    P3_7 = 103,
+    P3_8 = 104,
+    P3_9 = 105,
+    P3_10 = 106,
+    P3_11 = 107,
+    P3_12 = 108,
+    P3_13 = 109,
+    P3_14 = 110,
+    P3_15 = 111,
+    P3_16 = 112,
+    P3_17 = 113,
+    P3_18 = 114,
+    P3_19 = 115,
+    P3_20 = 116,
+    P3_21 = 117,
+    P3_22 = 118,
+    P3_23 = 119,
+    P3_24 = 120,
+    P3_25 = 121,
+    P3_26 = 122,
+    P3_27 = 123,
+    P3_28 = 124,
+    P3_29 = 125,
+    P3_30 = 126,
+    P3_31 = 127,
+    P4_0 = 128,
+    P4_1 = 129,
+    P4_2 = 130,
+    P4_3 = 131,
+    P4_4 = 132,
+    P4_5 = 133,
+    P4_6 = 134,
+    P4_7 = 135,
+    P4_8 = 136,
+    P4_9 = 137,
+    P4_10 = 138,
+    P4_11 = 139,
+    P4_12 = 140,
+    P4_13 = 141,
+    P4_14 = 142,
+    P4_15 = 143,
+    P4_16 = 144,
+    P4_17 = 145,
+    P4_18 = 146,
+    P4_19 = 147,
+    P4_20 = 148,
+    P4_21 = 149,
+    P4_22 = 150,
+    P4_23 = 151,
+    P4_24 = 152,
+    P4_25 = 153,
+    P4_26 = 154,
+    P4_27 = 155,
+    P4_28 = 156,
+    P4_29 = 157,
+    P4_30 = 158,
+    P4_31 = 159,
+
+    USBTX = P0_2,
+    USBRX = P0_3,
+    NC = (int)0xFFFFFFFF
+} PinName;
@@ -0,0 +1,17 @@
+// Host (simulator) replacement for the mbed PwmOut.h, hardware PWM is not simulated
+#pragma once
+#include "PinNames.h"
+
+namespace mbed {
+class PwmOut {
+    public:
+        PwmOut(PinName pin) : duty(0) {}
+        void write(float value) { duty= value; }
+        float read() { return duty; }
+        void period_us(int us) {}
+        void pulsewidth_us(int us) {}
+
+    private:
+        float duty;
+};
+}
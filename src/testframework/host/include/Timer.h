@@ -0,0 +1,3 @@
+// Host (simulator) replacement for the mbed Timer.h
+#pragma once
+#include "us_ticker_api.h"
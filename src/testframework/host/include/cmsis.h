@@ -0,0 +1,3 @@
+// Host (simulator) replacement for the mbed cmsis.h
+#pragma once
+#include "LPC17xx.h"
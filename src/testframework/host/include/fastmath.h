@@ -0,0 +1,3 @@
+// Host (simulator) replacement for the newlib fastmath.h
+#pragma once
+#include <math.h>
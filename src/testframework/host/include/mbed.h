@@ -0,0 +1,16 @@
+// Host (simulator) replacement for the mbed.h umbrella header
+#pragma once
+
+#include <math.h>
+#include <time.h>
+
+#include "cmsis.h"
+#include "PinNames.h"
+#include "wait_api.h"
+#include "us_ticker_api.h"
+#include "PwmOut.h"
+#include "InterruptIn.h"
+
+// the real mbed.h pulls these in and the firmware relies on it
+using namespace mbed;
+using namespace std;
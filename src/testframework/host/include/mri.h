@@ -0,0 +1,14 @@
+// Host (simulator) replacement for the MRI debug monitor api
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// stops the simulation with a backtrace-able abort where the target would drop into the debugger
+void __debugbreak(void);
+int __mriPlatform_CommUartIndex(void);
+
+#ifdef __cplusplus
+}
+#endif
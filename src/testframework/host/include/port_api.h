@@ -0,0 +1,5 @@
+// Host (simulator) replacement for the mbed port_api.h
+#pragma once
+#include "PinNames.h"
+
+static inline PinName port_pin(PortName port, int pin_n) { return (PinName)((port << 5) + pin_n); }
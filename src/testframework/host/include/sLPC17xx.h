@@ -0,0 +1,2 @@
+// Host (simulator) redirect for src/libs/LPC17xx/sLPC17xx.h
+#include "LPC17xx.h"
@@ -0,0 +1,5 @@
+// Host (simulator) replacement for the mbed system_LPC17xx.h
+#pragma once
+#include <stdint.h>
+
+extern uint32_t SystemCoreClock;
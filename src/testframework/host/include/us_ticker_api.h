@@ -0,0 +1,13 @@
+// Host (simulator) replacement for the mbed us_ticker_api.h, returns simulated time in microseconds
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t us_ticker_read(void);
+
+#ifdef __cplusplus
+}
+#endif
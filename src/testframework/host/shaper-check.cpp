@@ -0,0 +1,178 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    shaper-check: checks a step trace made with input shaping against the analytic response of the shaper
+
+    usage: shaper-check config unshaped.trace shaped.trace
+
+    The config is the one the shaped trace was made with, the unshaped trace is the same gcode run without the shapers.
+    For each motor with a <motor>_input_shaper the position in the unshaped trace is convolved with the impulses of the shaper,
+    worked out here from the frequency and damping, and the shaped position must stay within MAX_ERROR steps of it at all times.
+    Motors without a shaper must step exactly the same in both traces.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// the shaper issues whole steps, and holds a step back a tick when the direction changes
+#define MAX_ERROR 2.0
+
+static const char *motor_names[]= {"alpha", "beta", "gamma", "delta", "epsilon", "zeta"};
+static const int n_motor_names= sizeof(motor_names) / sizeof(motor_names[0]);
+
+struct trace_t {
+    std::vector<double> time[n_motor_names]; // us
+    std::vector<int> position[n_motor_names]; // after the step at the same index
+};
+
+struct impulse_t {
+    double amplitude;
+    double delay; // us
+};
+
+static bool read_config(const char *file, std::map<std::string, std::string>& config)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == NULL) return false;
+
+    char buf[256];
+    while(fgets(buf, sizeof(buf), fp) != NULL) {
+        char *p= strchr(buf, '#');
+        if(p != NULL) *p= '\0';
+        char key[128], value[128];
+        if(sscanf(buf, "%127s %127s", key, value) == 2) config[key]= value;
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool read_trace(const char *file, trace_t& trace)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == NULL) return false;
+
+    double t;
+    int m, dir;
+    while(fscanf(fp, "%lf %d %d", &t, &m, &dir) == 3) {
+        if(m < 0 || m >= n_motor_names) continue;
+        int last= trace.position[m].empty() ? 0 : trace.position[m].back();
+        trace.time[m].push_back(t);
+        trace.position[m].push_back(last + dir);
+    }
+    fclose(fp);
+    return true;
+}
+
+// position of the motor at time t, including any step at exactly t
+static int position_at(const trace_t& trace, int m, double t)
+{
+    const std::vector<double>& times= trace.time[m];
+    size_t n= std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    return (n == 0) ? 0 : trace.position[m][n - 1];
+}
+
+// the standard ZV, MZV and EI shapers, K is the decay of the oscillation over half a period, td the damped period
+static bool make_impulses(const std::string& type, double frequency, double damping, std::vector<impulse_t>& impulses)
+{
+    double df= sqrt(1.0 - damping * damping);
+    double td= 1000000.0 / (frequency * df);
+    double k= exp(-damping * M_PI / df);
+
+    if(type == "zv") {
+        impulses= {{1.0, 0.0}, {k, 0.5 * td}};
+    } else if(type == "mzv") {
+        double k2= exp(-0.75 * damping * M_PI / df);
+        double a1= 1.0 - 1.0 / sqrt(2.0);
+        impulses= {{a1, 0.0}, {(sqrt(2.0) - 1.0) * k2, 0.375 * td}, {a1 * k2 * k2, 0.75 * td}};
+    } else if(type == "ei") {
+        double v= 0.05;
+        double a1= 0.25 * (1.0 + v);
+        impulses= {{a1, 0.0}, {0.5 * (1.0 - v) * k, 0.5 * td}, {a1 * k * k, td}};
+    } else {
+        return false;
+    }
+
+    double sum= 0;
+    for(auto& i : impulses) sum += i.amplitude;
+    for(auto& i : impulses) i.amplitude /= sum;
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc != 4) {
+        fprintf(stderr, "usage: %s config unshaped.trace shaped.trace\n", argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, std::string> config;
+    if(!read_config(argv[1], config)) {
+        fprintf(stderr, "cannot open config file %s\n", argv[1]);
+        return 2;
+    }
+
+    trace_t unshaped, shaped;
+    if(!read_trace(argv[2], unshaped) || !read_trace(argv[3], shaped)) {
+        fprintf(stderr, "cannot open trace files\n");
+        return 2;
+    }
+
+    int ret= 0;
+    for (int m = 0; m < n_motor_names; ++m) {
+        if(unshaped.time[m].empty() && shaped.time[m].empty()) continue;
+
+        std::string name= motor_names[m];
+        std::vector<impulse_t> impulses;
+        if(config.count(name + "_input_shaper") != 0) {
+            double frequency= config.count(name + "_input_shaper_frequency") ? atof(config[name + "_input_shaper_frequency"].c_str()) : 40.0;
+            double damping= config.count(name + "_input_shaper_damping") ? atof(config[name + "_input_shaper_damping"].c_str()) : 0.1;
+            if(!make_impulses(config[name + "_input_shaper"], frequency, damping, impulses)) {
+                fprintf(stderr, "motor %d: unknown shaper %s\n", m, config[name + "_input_shaper"].c_str());
+                return 2;
+            }
+        } else {
+            impulses= {{1.0, 0.0}};
+        }
+
+        // check just before and at every step of both traces, the error can only change at those times
+        std::vector<double> times(shaped.time[m]);
+        for(auto& i : impulses) {
+            for(double t : unshaped.time[m]) times.push_back(t + i.delay);
+        }
+
+        double max_error= 0, max_error_time= 0;
+        for(double t : times) {
+            for(double dt : {-0.01, 0.0}) {
+                double expected= 0;
+                for(auto& i : impulses) expected += i.amplitude * position_at(unshaped, m, t + dt - i.delay);
+                double error= fabs(position_at(shaped, m, t + dt) - expected);
+                if(error > max_error) {
+                    max_error= error;
+                    max_error_time= t + dt;
+                }
+            }
+        }
+
+        // without a shaper the steps must be exactly the same
+        double limit= (impulses.size() > 1) ? MAX_ERROR : 0.0;
+        int end_unshaped= unshaped.position[m].empty() ? 0 : unshaped.position[m].back();
+        int end_shaped= shaped.position[m].empty() ? 0 : shaped.position[m].back();
+        bool ok= max_error <= limit && end_unshaped == end_shaped;
+        printf("motor %d: %lu impulses, max error %1.3f steps at %1.2f us, end position %d, expected %d%s\n", m, impulses.size(),
+               max_error, max_error_time, end_shaped, end_unshaped, ok ? "" : " MISMATCH");
+        if(!ok) ret= 1;
+    }
+
+    return ret;
+}
@@ -0,0 +1,8 @@
+; arcs and a full circle, split into segments by the Robot
+G21
+G90
+G1 X10 Y0 F6000
+G2 X0 Y10 I-10 J0 F3000
+G3 X-10 Y0 I0 J-10
+G2 X-10 Y0 I10 J0
+G1 X0 Y0
@@ -0,0 +1,530 @@
+; feed hold while the queue is full, it stops part way through the executing block, and in short segments where it takes several
+G21
+G90
+G1 X0 Y0 F6000
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X40 Y50
+G1 X30 Y50
+G1 X20 Y50
+G1 X10 Y50
+G1 X0 Y50
+G1 X0 Y40
+G1 X0 Y30
+G1 X0 Y20
+G1 X0 Y10
+G1 X0 Y0
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+!
+~
+G1 X10 Y0
+G1 X20 Y0
+G1 X30 Y0
+G1 X40 Y0
+G1 X50 Y0
+G1 X50 Y10
+G1 X50 Y20
+G1 X50 Y30
+G1 X50 Y40
+G1 X50 Y50
+G1 X70 Y25
+G1 X69.994 Y25.503
+G1 X69.975 Y26.005
+G1 X69.943 Y26.507
+G1 X69.899 Y27.007
+G1 X69.842 Y27.507
+G1 X69.773 Y28.005
+G1 X69.691 Y28.500
+G1 X69.597 Y28.994
+G1 X69.491 Y29.485
+G1 X69.372 Y29.974
+G1 X69.241 Y30.459
+G1 X69.097 Y30.941
+G1 X68.942 Y31.419
+G1 X68.775 Y31.893
+G1 X68.596 Y32.362
+G1 X68.405 Y32.827
+G1 X68.202 Y33.288
+G1 X67.988 Y33.742
+G1 X67.763 Y34.192
+G1 X67.526 Y34.635
+G1 X67.278 Y35.072
+G1 X67.020 Y35.503
+G1 X66.751 Y35.928
+G1 X66.471 Y36.345
+G1 X66.180 Y36.756
+G1 X65.880 Y37.159
+G1 X65.569 Y37.554
+G1 X65.249 Y37.941
+G1 X64.919 Y38.320
+G1 X64.579 Y38.691
+G1 X64.231 Y39.053
+G1 X63.873 Y39.406
+G1 X63.507 Y39.750
+G1 X63.132 Y40.085
+G1 X62.748 Y40.410
+G1 X62.357 Y40.726
+G1 X61.958 Y41.031
+G1 X61.551 Y41.327
+G1 X61.138 Y41.612
+G1 X60.717 Y41.887
+G1 X60.289 Y42.151
+G1 X59.855 Y42.404
+G1 X59.414 Y42.646
+G1 X58.968 Y42.877
+G1 X58.516 Y43.097
+G1 X58.058 Y43.305
+G1 X57.596 Y43.502
+G1 X57.128 Y43.687
+G1 X56.656 Y43.860
+G1 X56.180 Y44.021
+G1 X55.700 Y44.170
+G1 X55.217 Y44.308
+G1 X54.730 Y44.433
+G1 X54.240 Y44.545
+G1 X53.748 Y44.646
+G1 X53.253 Y44.734
+G1 X52.756 Y44.809
+G1 X52.257 Y44.872
+G1 X51.757 Y44.923
+G1 X51.256 Y44.961
+G1 X50.754 Y44.986
+G1 X50.251 Y44.998
+G1 X49.749 Y44.998
+G1 X49.246 Y44.986
+G1 X48.744 Y44.961
+G1 X48.243 Y44.923
+G1 X47.743 Y44.872
+G1 X47.244 Y44.809
+G1 X46.747 Y44.734
+G1 X46.252 Y44.646
+G1 X45.760 Y44.545
+G1 X45.270 Y44.433
+G1 X44.783 Y44.308
+G1 X44.300 Y44.170
+G1 X43.820 Y44.021
+G1 X43.344 Y43.860
+G1 X42.872 Y43.687
+G1 X42.404 Y43.502
+G1 X41.942 Y43.305
+G1 X41.484 Y43.097
+G1 X41.032 Y42.877
+G1 X40.586 Y42.646
+G1 X40.145 Y42.404
+G1 X39.711 Y42.151
+G1 X39.283 Y41.887
+G1 X38.862 Y41.612
+G1 X38.449 Y41.327
+G1 X38.042 Y41.031
+G1 X37.643 Y40.726
+G1 X37.252 Y40.410
+G1 X36.868 Y40.085
+G1 X36.493 Y39.750
+G1 X36.127 Y39.406
+G1 X35.769 Y39.053
+G1 X35.421 Y38.691
+G1 X35.081 Y38.320
+G1 X34.751 Y37.941
+G1 X34.431 Y37.554
+G1 X34.120 Y37.159
+G1 X33.820 Y36.756
+G1 X33.529 Y36.345
+G1 X33.249 Y35.928
+G1 X32.980 Y35.503
+G1 X32.722 Y35.072
+G1 X32.474 Y34.635
+G1 X32.237 Y34.192
+G1 X32.012 Y33.742
+G1 X31.798 Y33.288
+G1 X31.595 Y32.827
+G1 X31.404 Y32.362
+G1 X31.225 Y31.893
+G1 X31.058 Y31.419
+G1 X30.903 Y30.941
+G1 X30.759 Y30.459
+G1 X30.628 Y29.974
+G1 X30.509 Y29.485
+G1 X30.403 Y28.994
+G1 X30.309 Y28.500
+G1 X30.227 Y28.005
+G1 X30.158 Y27.507
+G1 X30.101 Y27.007
+G1 X30.057 Y26.507
+G1 X30.025 Y26.005
+G1 X30.006 Y25.503
+G1 X30.000 Y25.000
+G1 X30.006 Y24.497
+G1 X30.025 Y23.995
+G1 X30.057 Y23.493
+G1 X30.101 Y22.993
+G1 X30.158 Y22.493
+G1 X30.227 Y21.995
+G1 X30.309 Y21.500
+G1 X30.403 Y21.006
+G1 X30.509 Y20.515
+G1 X30.628 Y20.026
+G1 X30.759 Y19.541
+G1 X30.903 Y19.059
+G1 X31.058 Y18.581
+G1 X31.225 Y18.107
+G1 X31.404 Y17.638
+G1 X31.595 Y17.173
+G1 X31.798 Y16.712
+G1 X32.012 Y16.258
+G1 X32.237 Y15.808
+G1 X32.474 Y15.365
+G1 X32.722 Y14.928
+G1 X32.980 Y14.497
+G1 X33.249 Y14.072
+G1 X33.529 Y13.655
+G1 X33.820 Y13.244
+G1 X34.120 Y12.841
+G1 X34.431 Y12.446
+G1 X34.751 Y12.059
+G1 X35.081 Y11.680
+G1 X35.421 Y11.309
+G1 X35.769 Y10.947
+G1 X36.127 Y10.594
+G1 X36.493 Y10.250
+G1 X36.868 Y9.915
+G1 X37.252 Y9.590
+G1 X37.643 Y9.274
+G1 X38.042 Y8.969
+G1 X38.449 Y8.673
+G1 X38.862 Y8.388
+G1 X39.283 Y8.113
+G1 X39.711 Y7.849
+G1 X40.145 Y7.596
+G1 X40.586 Y7.354
+G1 X41.032 Y7.123
+G1 X41.484 Y6.903
+G1 X41.942 Y6.695
+G1 X42.404 Y6.498
+G1 X42.872 Y6.313
+G1 X43.344 Y6.140
+G1 X43.820 Y5.979
+G1 X44.300 Y5.830
+G1 X44.783 Y5.692
+G1 X45.270 Y5.567
+G1 X45.760 Y5.455
+G1 X46.252 Y5.354
+G1 X46.747 Y5.266
+G1 X47.244 Y5.191
+G1 X47.743 Y5.128
+G1 X48.243 Y5.077
+G1 X48.744 Y5.039
+G1 X49.246 Y5.014
+G1 X49.749 Y5.002
+G1 X50.251 Y5.002
+G1 X50.754 Y5.014
+G1 X51.256 Y5.039
+G1 X51.757 Y5.077
+G1 X52.257 Y5.128
+G1 X52.756 Y5.191
+G1 X53.253 Y5.266
+G1 X53.748 Y5.354
+G1 X54.240 Y5.455
+G1 X54.730 Y5.567
+G1 X55.217 Y5.692
+G1 X55.700 Y5.830
+G1 X56.180 Y5.979
+!
+~
+G1 X56.656 Y6.140
+G1 X57.128 Y6.313
+G1 X57.596 Y6.498
+G1 X58.058 Y6.695
+G1 X58.516 Y6.903
+G1 X58.968 Y7.123
+G1 X59.414 Y7.354
+G1 X59.855 Y7.596
+G1 X60.289 Y7.849
+G1 X60.717 Y8.113
+G1 X61.138 Y8.388
+G1 X61.551 Y8.673
+G1 X61.958 Y8.969
+G1 X62.357 Y9.274
+G1 X62.748 Y9.590
+G1 X63.132 Y9.915
+G1 X63.507 Y10.250
+G1 X63.873 Y10.594
+G1 X64.231 Y10.947
+G1 X64.579 Y11.309
+G1 X64.919 Y11.680
+G1 X65.249 Y12.059
+G1 X65.569 Y12.446
+G1 X65.880 Y12.841
+G1 X66.180 Y13.244
+G1 X66.471 Y13.655
+G1 X66.751 Y14.072
+G1 X67.020 Y14.497
+G1 X67.278 Y14.928
+G1 X67.526 Y15.365
+G1 X67.763 Y15.808
+G1 X67.988 Y16.258
+G1 X68.202 Y16.712
+G1 X68.405 Y17.173
+G1 X68.596 Y17.638
+G1 X68.775 Y18.107
+G1 X68.942 Y18.581
+G1 X69.097 Y19.059
+G1 X69.241 Y19.541
+G1 X69.372 Y20.026
+G1 X69.491 Y20.515
+G1 X69.597 Y21.006
+G1 X69.691 Y21.500
+G1 X69.773 Y21.995
+G1 X69.842 Y22.493
+G1 X69.899 Y22.993
+G1 X69.943 Y23.493
+G1 X69.975 Y23.995
+G1 X69.994 Y24.497
+G1 X70.000 Y25.000
+G1 X69.994 Y25.503
+G1 X69.975 Y26.005
+G1 X69.943 Y26.507
+G1 X69.899 Y27.007
+G1 X69.842 Y27.507
+G1 X69.773 Y28.005
+G1 X69.691 Y28.500
+G1 X69.597 Y28.994
+G1 X69.491 Y29.485
+G1 X69.372 Y29.974
+G1 X69.241 Y30.459
+G1 X69.097 Y30.941
+G1 X68.942 Y31.419
+G1 X68.775 Y31.893
+G1 X68.596 Y32.362
+G1 X68.405 Y32.827
+G1 X68.202 Y33.288
+G1 X67.988 Y33.742
+G1 X67.763 Y34.192
+G1 X67.526 Y34.635
+G1 X67.278 Y35.072
+G1 X67.020 Y35.503
+G1 X66.751 Y35.928
+G1 X66.471 Y36.345
+G1 X66.180 Y36.756
+G1 X65.880 Y37.159
+G1 X65.569 Y37.554
+G1 X65.249 Y37.941
+G1 X64.919 Y38.320
+G1 X64.579 Y38.691
+G1 X64.231 Y39.053
+G1 X63.873 Y39.406
+G1 X63.507 Y39.750
+G1 X63.132 Y40.085
+G1 X62.748 Y40.410
+G1 X62.357 Y40.726
+G1 X61.958 Y41.031
+G1 X61.551 Y41.327
+G1 X61.138 Y41.612
+G1 X60.717 Y41.887
+G1 X60.289 Y42.151
+G1 X59.855 Y42.404
+G1 X59.414 Y42.646
+G1 X58.968 Y42.877
+G1 X58.516 Y43.097
+G1 X58.058 Y43.305
+G1 X57.596 Y43.502
+G1 X57.128 Y43.687
+G1 X56.656 Y43.860
+G1 X56.180 Y44.021
+G1 X55.700 Y44.170
+G1 X55.217 Y44.308
+G1 X54.730 Y44.433
+G1 X54.240 Y44.545
+G1 X53.748 Y44.646
+G1 X53.253 Y44.734
+G1 X52.756 Y44.809
+G1 X52.257 Y44.872
+G1 X51.757 Y44.923
+G1 X51.256 Y44.961
+G1 X50.754 Y44.986
+G1 X50.251 Y44.998
+G1 X49.749 Y44.998
+G1 X49.246 Y44.986
+G1 X48.744 Y44.961
+G1 X48.243 Y44.923
+G1 X47.743 Y44.872
+G1 X47.244 Y44.809
+G1 X46.747 Y44.734
+G1 X46.252 Y44.646
+G1 X45.760 Y44.545
+G1 X45.270 Y44.433
+G1 X44.783 Y44.308
+G1 X44.300 Y44.170
+G1 X43.820 Y44.021
+G1 X43.344 Y43.860
+G1 X42.872 Y43.687
+G1 X42.404 Y43.502
+G1 X41.942 Y43.305
+G1 X41.484 Y43.097
+G1 X41.032 Y42.877
+G1 X40.586 Y42.646
+G1 X40.145 Y42.404
+G1 X39.711 Y42.151
+G1 X39.283 Y41.887
+G1 X38.862 Y41.612
+G1 X38.449 Y41.327
+G1 X38.042 Y41.031
+G1 X37.643 Y40.726
+G1 X37.252 Y40.410
+G1 X36.868 Y40.085
+G1 X36.493 Y39.750
+G1 X36.127 Y39.406
+G1 X35.769 Y39.053
+G1 X35.421 Y38.691
+G1 X35.081 Y38.320
+G1 X34.751 Y37.941
+G1 X34.431 Y37.554
+G1 X34.120 Y37.159
+G1 X33.820 Y36.756
+G1 X33.529 Y36.345
+G1 X33.249 Y35.928
+G1 X32.980 Y35.503
+G1 X32.722 Y35.072
+G1 X32.474 Y34.635
+G1 X32.237 Y34.192
+G1 X32.012 Y33.742
+G1 X31.798 Y33.288
+G1 X31.595 Y32.827
+G1 X31.404 Y32.362
+G1 X0 Y0
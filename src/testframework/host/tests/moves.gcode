@@ -0,0 +1,11 @@
+; straight lines, direction reversals and a short Z move
+G21
+G90
+G1 X10 Y0 F6000
+G1 X10 Y10
+G1 X0 Y10
+G1 X0 Y0
+G1 X20 Y5 F3000
+G1 X-5.5 Y-3.25 F12000
+G1 Z1.5 F300
+G1 X0 Y0 Z0 F6000
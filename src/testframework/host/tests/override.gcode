@@ -0,0 +1,60 @@
+; feed override while the queue is full, the queued blocks and the executing one are rescaled
+G21
+G90
+G1 X0 Y0 F3000
+G1 X5 Y0
+G1 X10 Y1
+G1 X15 Y0
+G1 X20 Y1
+G1 X25 Y0
+G1 X30 Y1
+G1 X35 Y0
+G1 X40 Y1
+G1 X45 Y0
+G1 X50 Y1
+G1 X55 Y0
+G1 X60 Y1
+G1 X65 Y0
+G1 X70 Y1
+G1 X75 Y0
+G1 X80 Y1
+G1 X85 Y0
+G1 X90 Y1
+G1 X95 Y0
+G1 X100 Y1
+G1 X105 Y0
+G1 X110 Y1
+G1 X115 Y0
+G1 X120 Y1
+G1 X125 Y0
+G1 X130 Y1
+G1 X135 Y0
+G1 X140 Y1
+G1 X145 Y0
+G1 X150 Y1
+G1 X155 Y0
+G1 X160 Y1
+G1 X165 Y0
+G1 X170 Y1
+G1 X175 Y0
+G1 X180 Y1
+M220 S50
+G1 X175 Y0
+G1 X170 Y0
+G1 X165 Y0
+G1 X160 Y0
+G1 X155 Y0
+G1 X150 Y0
+G1 X145 Y0
+G1 X140 Y0
+M220 S150
+G1 X135 Y1
+G1 X130 Y1
+G1 X125 Y1
+G1 X120 Y1
+G1 X115 Y1
+G1 X110 Y1
+G1 X105 Y1
+G1 X100 Y1
+M220 S100
+G1 X0 Y0
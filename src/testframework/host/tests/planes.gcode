@@ -0,0 +1,12 @@
+; a helix and arcs in the XZ and YZ planes, split into segments or followed by the step ticker with native_arcs
+G21
+G90
+G1 X5 Y0 F6000
+G17
+G3 X5 Y0 Z1 I-5 J0 F1200
+G18
+G2 X0 Z6 I-5 K0
+G19
+G3 Y5 Z1 J0 K-5
+G17
+G1 X0 Y0 Z0 F3000
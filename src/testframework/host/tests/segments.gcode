@@ -0,0 +1,426 @@
+; runs of short G1 as a slicer or CAM would send them, a straight line, a circle and a zigzag, merged with config-merge
+G21
+G90
+G1 X0 Y0 F6000
+G1 F3000
+G1 X0.100 Y0.050
+G1 X0.200 Y0.100
+G1 X0.300 Y0.150
+G1 X0.400 Y0.200
+G1 X0.500 Y0.250
+G1 X0.600 Y0.300
+G1 X0.700 Y0.350
+G1 X0.800 Y0.400
+G1 X0.900 Y0.450
+G1 X1.000 Y0.500
+G1 X1.100 Y0.550
+G1 X1.200 Y0.600
+G1 X1.300 Y0.650
+G1 X1.400 Y0.700
+G1 X1.500 Y0.750
+G1 X1.600 Y0.800
+G1 X1.700 Y0.850
+G1 X1.800 Y0.900
+G1 X1.900 Y0.950
+G1 X2.000 Y1.000
+G1 X2.100 Y1.050
+G1 X2.200 Y1.100
+G1 X2.300 Y1.150
+G1 X2.400 Y1.200
+G1 X2.500 Y1.250
+G1 X2.600 Y1.300
+G1 X2.700 Y1.350
+G1 X2.800 Y1.400
+G1 X2.900 Y1.450
+G1 X3.000 Y1.500
+G1 X3.100 Y1.550
+G1 X3.200 Y1.600
+G1 X3.300 Y1.650
+G1 X3.400 Y1.700
+G1 X3.500 Y1.750
+G1 X3.600 Y1.800
+G1 X3.700 Y1.850
+G1 X3.800 Y1.900
+G1 X3.900 Y1.950
+G1 X4.000 Y2.000
+G1 X4.100 Y2.050
+G1 X4.200 Y2.100
+G1 X4.300 Y2.150
+G1 X4.400 Y2.200
+G1 X4.500 Y2.250
+G1 X4.600 Y2.300
+G1 X4.700 Y2.350
+G1 X4.800 Y2.400
+G1 X4.900 Y2.450
+G1 X5.000 Y2.500
+G1 X5.100 Y2.550
+G1 X5.200 Y2.600
+G1 X5.300 Y2.650
+G1 X5.400 Y2.700
+G1 X5.500 Y2.750
+G1 X5.600 Y2.800
+G1 X5.700 Y2.850
+G1 X5.800 Y2.900
+G1 X5.900 Y2.950
+G1 X6.000 Y3.000
+G1 X6.100 Y3.050
+G1 X6.200 Y3.100
+G1 X6.300 Y3.150
+G1 X6.400 Y3.200
+G1 X6.500 Y3.250
+G1 X6.600 Y3.300
+G1 X6.700 Y3.350
+G1 X6.800 Y3.400
+G1 X6.900 Y3.450
+G1 X7.000 Y3.500
+G1 X7.100 Y3.550
+G1 X7.200 Y3.600
+G1 X7.300 Y3.650
+G1 X7.400 Y3.700
+G1 X7.500 Y3.750
+G1 X7.600 Y3.800
+G1 X7.700 Y3.850
+G1 X7.800 Y3.900
+G1 X7.900 Y3.950
+G1 X8.000 Y4.000
+G1 X8.100 Y4.050
+G1 X8.200 Y4.100
+G1 X8.300 Y4.150
+G1 X8.400 Y4.200
+G1 X8.500 Y4.250
+G1 X8.600 Y4.300
+G1 X8.700 Y4.350
+G1 X8.800 Y4.400
+G1 X8.900 Y4.450
+G1 X9.000 Y4.500
+G1 X9.100 Y4.550
+G1 X9.200 Y4.600
+G1 X9.300 Y4.650
+G1 X9.400 Y4.700
+G1 X9.500 Y4.750
+G1 X9.600 Y4.800
+G1 X9.700 Y4.850
+G1 X9.800 Y4.900
+G1 X9.900 Y4.950
+G1 X10.000 Y5.000
+G1 X10.100 Y5.050
+G1 X10.200 Y5.100
+G1 X10.300 Y5.150
+G1 X10.400 Y5.200
+G1 X10.500 Y5.250
+G1 X10.600 Y5.300
+G1 X10.700 Y5.350
+G1 X10.800 Y5.400
+G1 X10.900 Y5.450
+G1 X11.000 Y5.500
+G1 X11.100 Y5.550
+G1 X11.200 Y5.600
+G1 X11.300 Y5.650
+G1 X11.400 Y5.700
+G1 X11.500 Y5.750
+G1 X11.600 Y5.800
+G1 X11.700 Y5.850
+G1 X11.800 Y5.900
+G1 X11.900 Y5.950
+G1 X12.000 Y6.000
+G1 X12.100 Y6.050
+G1 X12.200 Y6.100
+G1 X12.300 Y6.150
+G1 X12.400 Y6.200
+G1 X12.500 Y6.250
+G1 X12.600 Y6.300
+G1 X12.700 Y6.350
+G1 X12.800 Y6.400
+G1 X12.900 Y6.450
+G1 X13.000 Y6.500
+G1 X13.100 Y6.550
+G1 X13.200 Y6.600
+G1 X13.300 Y6.650
+G1 X13.400 Y6.700
+G1 X13.500 Y6.750
+G1 X13.600 Y6.800
+G1 X13.700 Y6.850
+G1 X13.800 Y6.900
+G1 X13.900 Y6.950
+G1 X14.000 Y7.000
+G1 X14.100 Y7.050
+G1 X14.200 Y7.100
+G1 X14.300 Y7.150
+G1 X14.400 Y7.200
+G1 X14.500 Y7.250
+G1 X14.600 Y7.300
+G1 X14.700 Y7.350
+G1 X14.800 Y7.400
+G1 X14.900 Y7.450
+G1 X15.000 Y7.500
+G1 X15.100 Y7.550
+G1 X15.200 Y7.600
+G1 X15.300 Y7.650
+G1 X15.400 Y7.700
+G1 X15.500 Y7.750
+G1 X15.600 Y7.800
+G1 X15.700 Y7.850
+G1 X15.800 Y7.900
+G1 X15.900 Y7.950
+G1 X16.000 Y8.000
+G1 X16.100 Y8.050
+G1 X16.200 Y8.100
+G1 X16.300 Y8.150
+G1 X16.400 Y8.200
+G1 X16.500 Y8.250
+G1 X16.600 Y8.300
+G1 X16.700 Y8.350
+G1 X16.800 Y8.400
+G1 X16.900 Y8.450
+G1 X17.000 Y8.500
+G1 X17.100 Y8.550
+G1 X17.200 Y8.600
+G1 X17.300 Y8.650
+G1 X17.400 Y8.700
+G1 X17.500 Y8.750
+G1 X17.600 Y8.800
+G1 X17.700 Y8.850
+G1 X17.800 Y8.900
+G1 X17.900 Y8.950
+G1 X18.000 Y9.000
+G1 X18.100 Y9.050
+G1 X18.200 Y9.100
+G1 X18.300 Y9.150
+G1 X18.400 Y9.200
+G1 X18.500 Y9.250
+G1 X18.600 Y9.300
+G1 X18.700 Y9.350
+G1 X18.800 Y9.400
+G1 X18.900 Y9.450
+G1 X19.000 Y9.500
+G1 X19.100 Y9.550
+G1 X19.200 Y9.600
+G1 X19.300 Y9.650
+G1 X19.400 Y9.700
+G1 X19.500 Y9.750
+G1 X19.600 Y9.800
+G1 X19.700 Y9.850
+G1 X19.800 Y9.900
+G1 X19.900 Y9.950
+G1 X20.000 Y10.000
+G1 X19.988 Y10.698
+G1 X19.951 Y11.395
+G1 X19.890 Y12.091
+G1 X19.805 Y12.783
+G1 X19.696 Y13.473
+G1 X19.563 Y14.158
+G1 X19.406 Y14.838
+G1 X19.225 Y15.513
+G1 X19.021 Y16.180
+G1 X18.794 Y16.840
+G1 X18.544 Y17.492
+G1 X18.271 Y18.135
+G1 X17.976 Y18.767
+G1 X17.659 Y19.389
+G1 X17.321 Y20.000
+G1 X16.961 Y20.598
+G1 X16.581 Y21.184
+G1 X16.180 Y21.756
+G1 X15.760 Y22.313
+G1 X15.321 Y22.856
+G1 X14.863 Y23.383
+G1 X14.387 Y23.893
+G1 X13.893 Y24.387
+G1 X13.383 Y24.863
+G1 X12.856 Y25.321
+G1 X12.313 Y25.760
+G1 X11.756 Y26.180
+G1 X11.184 Y26.581
+G1 X10.598 Y26.961
+G1 X10.000 Y27.321
+G1 X9.389 Y27.659
+G1 X8.767 Y27.976
+G1 X8.135 Y28.271
+G1 X7.492 Y28.544
+G1 X6.840 Y28.794
+G1 X6.180 Y29.021
+G1 X5.513 Y29.225
+G1 X4.838 Y29.406
+G1 X4.158 Y29.563
+G1 X3.473 Y29.696
+G1 X2.783 Y29.805
+G1 X2.091 Y29.890
+G1 X1.395 Y29.951
+G1 X0.698 Y29.988
+G1 X0.000 Y30.000
+G1 X-0.698 Y29.988
+G1 X-1.395 Y29.951
+G1 X-2.091 Y29.890
+G1 X-2.783 Y29.805
+G1 X-3.473 Y29.696
+G1 X-4.158 Y29.563
+G1 X-4.838 Y29.406
+G1 X-5.513 Y29.225
+G1 X-6.180 Y29.021
+G1 X-6.840 Y28.794
+G1 X-7.492 Y28.544
+G1 X-8.135 Y28.271
+G1 X-8.767 Y27.976
+G1 X-9.389 Y27.659
+G1 X-10.000 Y27.321
+G1 X-10.598 Y26.961
+G1 X-11.184 Y26.581
+G1 X-11.756 Y26.180
+G1 X-12.313 Y25.760
+G1 X-12.856 Y25.321
+G1 X-13.383 Y24.863
+G1 X-13.893 Y24.387
+G1 X-14.387 Y23.893
+G1 X-14.863 Y23.383
+G1 X-15.321 Y22.856
+G1 X-15.760 Y22.313
+G1 X-16.180 Y21.756
+G1 X-16.581 Y21.184
+G1 X-16.961 Y20.598
+G1 X-17.321 Y20.000
+G1 X-17.659 Y19.389
+G1 X-17.976 Y18.767
+G1 X-18.271 Y18.135
+G1 X-18.544 Y17.492
+G1 X-18.794 Y16.840
+G1 X-19.021 Y16.180
+G1 X-19.225 Y15.513
+G1 X-19.406 Y14.838
+G1 X-19.563 Y14.158
+G1 X-19.696 Y13.473
+G1 X-19.805 Y12.783
+G1 X-19.890 Y12.091
+G1 X-19.951 Y11.395
+G1 X-19.988 Y10.698
+G1 X-20.000 Y10.000
+G1 X-19.988 Y9.302
+G1 X-19.951 Y8.605
+G1 X-19.890 Y7.909
+G1 X-19.805 Y7.217
+G1 X-19.696 Y6.527
+G1 X-19.563 Y5.842
+G1 X-19.406 Y5.162
+G1 X-19.225 Y4.487
+G1 X-19.021 Y3.820
+G1 X-18.794 Y3.160
+G1 X-18.544 Y2.508
+G1 X-18.271 Y1.865
+G1 X-17.976 Y1.233
+G1 X-17.659 Y0.611
+G1 X-17.321 Y-0.000
+G1 X-16.961 Y-0.598
+G1 X-16.581 Y-1.184
+G1 X-16.180 Y-1.756
+G1 X-15.760 Y-2.313
+G1 X-15.321 Y-2.856
+G1 X-14.863 Y-3.383
+G1 X-14.387 Y-3.893
+G1 X-13.893 Y-4.387
+G1 X-13.383 Y-4.863
+G1 X-12.856 Y-5.321
+G1 X-12.313 Y-5.760
+G1 X-11.756 Y-6.180
+G1 X-11.184 Y-6.581
+G1 X-10.598 Y-6.961
+G1 X-10.000 Y-7.321
+G1 X-9.389 Y-7.659
+G1 X-8.767 Y-7.976
+G1 X-8.135 Y-8.271
+G1 X-7.492 Y-8.544
+G1 X-6.840 Y-8.794
+G1 X-6.180 Y-9.021
+G1 X-5.513 Y-9.225
+G1 X-4.838 Y-9.406
+G1 X-4.158 Y-9.563
+G1 X-3.473 Y-9.696
+G1 X-2.783 Y-9.805
+G1 X-2.091 Y-9.890
+G1 X-1.395 Y-9.951
+G1 X-0.698 Y-9.988
+G1 X-0.000 Y-10.000
+G1 X0.698 Y-9.988
+G1 X1.395 Y-9.951
+G1 X2.091 Y-9.890
+G1 X2.783 Y-9.805
+G1 X3.473 Y-9.696
+G1 X4.158 Y-9.563
+G1 X4.838 Y-9.406
+G1 X5.513 Y-9.225
+G1 X6.180 Y-9.021
+G1 X6.840 Y-8.794
+G1 X7.492 Y-8.544
+G1 X8.135 Y-8.271
+G1 X8.767 Y-7.976
+G1 X9.389 Y-7.659
+G1 X10.000 Y-7.321
+G1 X10.598 Y-6.961
+G1 X11.184 Y-6.581
+G1 X11.756 Y-6.180
+G1 X12.313 Y-5.760
+G1 X12.856 Y-5.321
+G1 X13.383 Y-4.863
+G1 X13.893 Y-4.387
+G1 X14.387 Y-3.893
+G1 X14.863 Y-3.383
+G1 X15.321 Y-2.856
+G1 X15.760 Y-2.313
+G1 X16.180 Y-1.756
+G1 X16.581 Y-1.184
+G1 X16.961 Y-0.598
+G1 X17.321 Y-0.000
+G1 X17.659 Y0.611
+G1 X17.976 Y1.233
+G1 X18.271 Y1.865
+G1 X18.544 Y2.508
+G1 X18.794 Y3.160
+G1 X19.021 Y3.820
+G1 X19.225 Y4.487
+G1 X19.406 Y5.162
+G1 X19.563 Y5.842
+G1 X19.696 Y6.527
+G1 X19.805 Y7.217
+G1 X19.890 Y7.909
+G1 X19.951 Y8.605
+G1 X19.988 Y9.302
+G1 X20.000 Y10.000
+G1 X-19.500 Y10.500
+G1 X-19.000 Y10.000
+G1 X-18.500 Y10.500
+G1 X-18.000 Y10.000
+G1 X-17.500 Y10.500
+G1 X-17.000 Y10.000
+G1 X-16.500 Y10.500
+G1 X-16.000 Y10.000
+G1 X-15.500 Y10.500
+G1 X-15.000 Y10.000
+G1 X-14.500 Y10.500
+G1 X-14.000 Y10.000
+G1 X-13.500 Y10.500
+G1 X-13.000 Y10.000
+G1 X-12.500 Y10.500
+G1 X-12.000 Y10.000
+G1 X-11.500 Y10.500
+G1 X-11.000 Y10.000
+G1 X-10.500 Y10.500
+G1 X-10.000 Y10.000
+G1 X-9.500 Y10.500
+G1 X-9.000 Y10.000
+G1 X-8.500 Y10.500
+G1 X-8.000 Y10.000
+G1 X-7.500 Y10.500
+G1 X-7.000 Y10.000
+G1 X-6.500 Y10.500
+G1 X-6.000 Y10.000
+G1 X-5.500 Y10.500
+G1 X-5.000 Y10.000
+G1 X-4.500 Y10.500
+G1 X-4.000 Y10.000
+G1 X-3.500 Y10.500
+G1 X-3.000 Y10.000
+G1 X-2.500 Y10.500
+G1 X-2.000 Y10.000
+G1 X-1.500 Y10.500
+G1 X-1.000 Y10.000
+G1 X-0.500 Y10.500
+G1 X0.000 Y10.000
+G1 X0 Y0
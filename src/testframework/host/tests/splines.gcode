@@ -0,0 +1,9 @@
+; cubic and quadratic Bezier splines flattened by the Robot, with an S bend, a G5 that carries on from the one before, and a helical one
+G21
+G90
+G1 X0 Y0 F6000
+G5 X20 Y0 I5 J10 P-5 Q-10 F3000
+G5 X40 Y0 P-5 Q10
+G5.1 X20 Y-10 I0 J-10
+G5 X0 Y0 Z1 I-10 J0 P0 Q-10
+G1 Z0
@@ -0,0 +1,105 @@
+/*
+      This file is part of Smoothie (http://smoothieware.org/). The motion control part is heavily based on Grbl (https://github.com/simen/grbl).
+      Smoothie is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+      Smoothie is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+      You should have received a copy of the GNU General Public License along with Smoothie. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+    trace-check: checks two step traces of the same gcode make exactly the same steps, in nearly the same time
+
+    usage: trace-check reference.trace other.trace
+
+    Each motor must make the same steps in the same order of directions in both traces, and make its last step no more than
+    MAX_DRIFT of the time later or earlier than in the reference trace. How far apart the motor gets from where it is in
+    the reference trace along the way is printed, but not checked, a block that takes a tick longer shifts all the steps after
+    it, and where a motor turns round or stops for a feed hold a tiny shift is a long time.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+// of the time the reference trace takes, plus a tick at the default base_stepping_frequency
+#define MAX_DRIFT 0.001
+#define TICK_US 10.0
+
+static const int n_motors= 6;
+
+struct trace_t {
+    std::vector<double> time[n_motors]; // us
+    std::vector<int> dir[n_motors];
+    std::vector<int> position[n_motors]; // after the step at the same index
+};
+
+static bool read_trace(const char *file, trace_t& trace)
+{
+    FILE *fp= fopen(file, "r");
+    if(fp == NULL) return false;
+
+    double t;
+    int m, dir;
+    while(fscanf(fp, "%lf %d %d", &t, &m, &dir) == 3) {
+        if(m < 0 || m >= n_motors) continue;
+        int last= trace.position[m].empty() ? 0 : trace.position[m].back();
+        trace.time[m].push_back(t);
+        trace.dir[m].push_back(dir);
+        trace.position[m].push_back(last + dir);
+    }
+    fclose(fp);
+    return true;
+}
+
+// position of the motor at time t, including any step at exactly t
+static int position_at(const trace_t& trace, int m, double t)
+{
+    const std::vector<double>& times= trace.time[m];
+    size_t n= std::upper_bound(times.begin(), times.end(), t) - times.begin();
+    return (n == 0) ? 0 : trace.position[m][n - 1];
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc != 3) {
+        fprintf(stderr, "usage: %s reference.trace other.trace\n", argv[0]);
+        return 2;
+    }
+
+    trace_t reference, other;
+    if(!read_trace(argv[1], reference) || !read_trace(argv[2], other)) {
+        fprintf(stderr, "cannot open trace files\n");
+        return 2;
+    }
+
+    int ret= 0;
+    for (int m = 0; m < n_motors; ++m) {
+        if(reference.time[m].empty() && other.time[m].empty()) continue;
+
+        bool ok= reference.dir[m] == other.dir[m];
+
+        double drift= 0;
+        if(ok) {
+            double end= reference.time[m].back();
+            drift= other.time[m].back() - end;
+            if(fabs(drift) > end * MAX_DRIFT + TICK_US) ok= false;
+        }
+
+        // check just before and at every step of both traces, the difference can only change at those times
+        int max_diff= 0;
+        for (auto *times : {&reference.time[m], &other.time[m]}) {
+            for (double t : *times) {
+                for (double dt : {-0.01, 0.0}) {
+                    max_diff= std::max(max_diff, abs(position_at(reference, m, t + dt) - position_at(other, m, t + dt)));
+                }
+            }
+        }
+
+        printf("motor %d: %lu steps, expected %lu, last step %+1.2f us, at most %d steps apart%s\n", m, other.time[m].size(),
+               reference.time[m].size(), drift, max_diff, ok ? "" : " MISMATCH");
+        if(!ok) ret= 1;
+    }
+
+    return ret;
+}